@@ -21,6 +21,7 @@
 
 #include "gui/EventRecorder.h"
 
+#include "common/config-manager.h"
 #include "common/util.h"
 #include "common/textconsole.h"
 
@@ -51,10 +52,10 @@ public:
 	 * @param data buffer where to mix the data
 	 * @param len  number of sample *pairs*. So a value of
 	 *             10 means that the buffer contains twice 10 sample, each
-	 *             16 bits, for a total of 40 bytes.
+	 *             32 bits, for a total of 80 bytes.
 	 * @return number of sample pairs processed (which can still be silence!)
 	 */
-	int mix(int16 *data, uint len);
+	int mix(int32 *data, uint len);
 
 	/**
 	 * Queries whether the channel is still playing or not.
@@ -197,17 +198,25 @@ private:
 #pragma mark -
 
 MixerImpl::MixerImpl(uint sampleRate, bool stereo, uint outBufSize)
-	: _mutex(), _sampleRate(sampleRate), _stereo(stereo), _outBufSize(outBufSize), _mixerReady(false), _handleSeed(0), _soundTypeSettings() {
+	: _mutex(), _sampleRate(sampleRate), _stereo(stereo), _outBufSize(outBufSize), _mixerReady(false), _handleSeed(0), _soundTypeSettings(),
+	  _mixBuffer(nullptr), _mixBufferSize(0) {
 
 	assert(sampleRate > 0);
 
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		_channels[i] = nullptr;
+
+	// Allocate the intermediate buffer up front, so that the audio thread
+	// never has to. Callbacks asking for more samples are mixed in chunks.
+	_mixBufferSize = (outBufSize ? outBufSize : 2048) * (stereo ? 2 : 1);
+	_mixBuffer = new int32[_mixBufferSize];
 }
 
 MixerImpl::~MixerImpl() {
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		delete _channels[i];
+
+	delete[] _mixBuffer;
 }
 
 void MixerImpl::setReady(bool ready) {
@@ -298,6 +307,20 @@ void MixerImpl::playStream(
 	insertChannel(handle, chan);
 }
 
+// Initialize this to nullptr at the start
+MixerImpl::ClampBufferFunc MixerImpl::clampBufferFunc = nullptr;
+
+void MixerImpl::clampBufferGeneric(int16 *dst, const int32 *src, uint len) {
+	for (uint i = 0; i < len; i++) {
+		int32 val = CLIP<int32>(src[i], ST_SAMPLE_MIN, ST_SAMPLE_MAX);
+#ifdef OUTPUT_UNSIGNED_AUDIO
+		dst[i] = ((int16)val) ^ 0x8000;
+#else
+		dst[i] = val;
+#endif
+	}
+}
+
 int MixerImpl::mixCallback(byte *samples, uint len) {
 	assert(samples);
 
@@ -308,8 +331,19 @@ int MixerImpl::mixCallback(byte *samples, uint len) {
 	// Since the mixer callback has been called, the mixer must be ready...
 	_mixerReady = true;
 
-	//  zero the buf
-	memset(buf, 0, len);
+	// If no clamp function has been selected yet, detect and select
+	if (!clampBufferFunc) {
+		clampBufferFunc = clampBufferGeneric;
+#ifdef SCUMMVM_NEON
+		if (g_system->hasFeature(OSystem::kFeatureCpuNEON)) clampBufferFunc = clampBufferNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+		if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) clampBufferFunc = clampBufferSSE2;
+#endif
+#ifdef SCUMMVM_AVX2
+		if (g_system->hasFeature(OSystem::kFeatureCpuAVX2)) clampBufferFunc = clampBufferAVX2;
+#endif
+	}
 
 	// we store 16-bit samples
 	if (_stereo) {
@@ -320,6 +354,26 @@ int MixerImpl::mixCallback(byte *samples, uint len) {
 		len >>= 1;
 	}
 
+	// Mix as many samples at once as the intermediate buffer holds
+	const uint chunkLen = _stereo ? _mixBufferSize >> 1 : _mixBufferSize;
+	int res = 0;
+	while (len > 0) {
+		const uint mixLen = MIN(len, chunkLen);
+		res += mixChunk(buf, mixLen);
+		buf += _stereo ? mixLen << 1 : mixLen;
+		len -= mixLen;
+	}
+
+	return res;
+}
+
+int MixerImpl::mixChunk(int16 *buf, uint len) {
+	const uint numSamples = _stereo ? len << 1 : len;
+	assert(numSamples <= _mixBufferSize);
+
+	//  zero the intermediate buffer
+	memset(_mixBuffer, 0, numSamples * sizeof(int32));
+
 	// mix all channels
 	int res = 0, tmp;
 	for (int i = 0; i != NUM_CHANNELS; i++)
@@ -328,13 +382,16 @@ int MixerImpl::mixCallback(byte *samples, uint len) {
 				delete _channels[i];
 				_channels[i] = nullptr;
 			} else if (!_channels[i]->isPaused()) {
-				tmp = _channels[i]->mix(buf, len);
+				tmp = _channels[i]->mix(_mixBuffer, len);
 
 				if (tmp > res)
 					res = tmp;
 			}
 		}
 
+	// clamp the mixed samples into the output buffer
+	clampBufferFunc(buf, _mixBuffer, numSamples);
+
 	return res;
 }
 
@@ -582,7 +639,11 @@ Channel::Channel(Mixer *mixer, Mixer::SoundType type, AudioStream *stream,
 	assert(stream);
 
 	// Get a rate converter instance
-	_converter = makeRateConverter(_stream->getRate(), mixer->getOutputRate(), _stream->isStereo(), mixer->getOutputStereo(), reverseStereo);
+	RateConverterQuality quality = kRateConverterQualityDefault;
+	if (ConfMan.hasKey("sinc_resampler") && ConfMan.getBool("sinc_resampler"))
+		quality = kRateConverterQualityHigh;
+
+	_converter = makeRateConverter(_stream->getRate(), mixer->getOutputRate(), _stream->isStereo(), mixer->getOutputStereo(), reverseStereo, quality);
 }
 
 Channel::~Channel() {
@@ -707,7 +768,7 @@ void Channel::loop() {
 	}
 }
 
-int Channel::mix(int16 *data, uint len) {
+int Channel::mix(int32 *data, uint len) {
 	assert(_stream);
 	assert(_converter);
 
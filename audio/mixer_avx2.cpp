@@ -0,0 +1,65 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "audio/mixer_intern.h"
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace Audio {
+
+void MixerImpl::clampBufferAVX2(int16 *dst, const int32 *src, uint len) {
+#ifdef OUTPUT_UNSIGNED_AUDIO
+	const __m256i signFlip = _mm256_set1_epi16((int16)0x8000);
+#endif
+
+	for (; len >= 16; len -= 16) {
+		__m256i lo = _mm256_loadu_si256((const __m256i *)src);
+		__m256i hi = _mm256_loadu_si256((const __m256i *)(src + 8));
+		// _mm256_packs_epi32 saturates, but packs each 128-bit lane separately,
+		// so the 64-bit quarters have to be put back in order afterwards
+		__m256i out = _mm256_permute4x64_epi64(_mm256_packs_epi32(lo, hi), _MM_SHUFFLE(3, 1, 2, 0));
+#ifdef OUTPUT_UNSIGNED_AUDIO
+		out = _mm256_xor_si256(out, signFlip);
+#endif
+		_mm256_storeu_si256((__m256i *)dst, out);
+		src += 16;
+		dst += 16;
+	}
+
+	clampBufferGeneric(dst, src, len);
+}
+
+} // End of namespace Audio
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
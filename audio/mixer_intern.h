@@ -79,8 +79,40 @@ private:
 	SoundTypeSettings _soundTypeSettings[4];
 	Channel *_channels[NUM_CHANNELS];
 
+	/**
+	 * Intermediate buffer all channels are mixed into. Samples are summed up
+	 * at 32-bit precision and only clamped to 16-bit once all channels have
+	 * been mixed, which avoids clipping artifacts caused by the order in
+	 * which channels are mixed.
+	 */
+	int32 *_mixBuffer;
+	uint _mixBufferSize;
+
+	/**
+	 * Mix all channels into the intermediate buffer and clamp them into
+	 * @p buf. @p len must fit into the intermediate buffer.
+	 */
+	int mixChunk(int16 *buf, uint len);
 
 public:
+	/**
+	 * Clamp mixed samples to 16-bit output samples, saturating the ones
+	 * outside of the int16 range.
+	 */
+#ifdef SCUMMVM_NEON
+	static void clampBufferNEON(int16 *dst, const int32 *src, uint len);
+#endif
+#ifdef SCUMMVM_SSE2
+	static void clampBufferSSE2(int16 *dst, const int32 *src, uint len);
+#endif
+#ifdef SCUMMVM_AVX2
+	static void clampBufferAVX2(int16 *dst, const int32 *src, uint len);
+#endif
+	static void clampBufferGeneric(int16 *dst, const int32 *src, uint len);
+
+	typedef void(*ClampBufferFunc)(int16 *, const int32 *, uint);
+	static ClampBufferFunc clampBufferFunc;
+
 
 	MixerImpl(uint sampleRate, bool stereo = true, uint outBufSize = 0);
 	~MixerImpl();
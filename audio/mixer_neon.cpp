@@ -0,0 +1,74 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+
+#include "audio/mixer_intern.h"
+
+#include <arm_neon.h>
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("neon"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+namespace Audio {
+
+void MixerImpl::clampBufferNEON(int16 *dst, const int32 *src, uint len) {
+#ifdef OUTPUT_UNSIGNED_AUDIO
+	const uint16x8_t signFlip = vdupq_n_u16(0x8000);
+#endif
+
+	// vqmovn_s32 saturates to the int16 range for us
+	for (; len >= 8; len -= 8) {
+		int16x8_t out = vcombine_s16(vqmovn_s32(vld1q_s32(src)), vqmovn_s32(vld1q_s32(src + 4)));
+#ifdef OUTPUT_UNSIGNED_AUDIO
+		out = vreinterpretq_s16_u16(veorq_u16(vreinterpretq_u16_s16(out), signFlip));
+#endif
+		vst1q_s16(dst, out);
+		src += 8;
+		dst += 8;
+	}
+
+	clampBufferGeneric(dst, src, len);
+}
+
+} // End of namespace Audio
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#endif // SCUMMVM_NEON
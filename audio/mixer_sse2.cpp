@@ -0,0 +1,72 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "audio/mixer_intern.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace Audio {
+
+void MixerImpl::clampBufferSSE2(int16 *dst, const int32 *src, uint len) {
+#ifdef OUTPUT_UNSIGNED_AUDIO
+	const __m128i signFlip = _mm_set1_epi16((int16)0x8000);
+#endif
+
+	// _mm_packs_epi32 saturates to the int16 range for us
+	for (; len >= 8; len -= 8) {
+		__m128i lo = _mm_loadu_si128((const __m128i *)src);
+		__m128i hi = _mm_loadu_si128((const __m128i *)(src + 4));
+		__m128i out = _mm_packs_epi32(lo, hi);
+#ifdef OUTPUT_UNSIGNED_AUDIO
+		out = _mm_xor_si128(out, signFlip);
+#endif
+		_mm_storeu_si128((__m128i *)dst, out);
+		src += 8;
+		dst += 8;
+	}
+
+	clampBufferGeneric(dst, src, len);
+}
+
+} // End of namespace Audio
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
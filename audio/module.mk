@@ -68,6 +68,18 @@ MODULE_OBJS := \
 ifndef DISABLE_NUKED_OPL
 MODULE_OBJS += \
 	softsynth/opl/nuked.o
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	softsynth/opl/nuked_neon.o
+endif
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	softsynth/opl/nuked_sse2.o
+endif
+ifdef SCUMMVM_AVX2
+MODULE_OBJS += \
+	softsynth/opl/nuked_avx2.o
+endif
 endif
 
 ifdef USE_A52
@@ -132,5 +144,20 @@ MODULE_OBJS += \
 	soundfont/vab/vab.o
 endif
 
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	mixer_neon.o \
+	rate_neon.o
+endif
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	mixer_sse2.o \
+	rate_sse2.o
+endif
+ifdef SCUMMVM_AVX2
+MODULE_OBJS += \
+	mixer_avx2.o
+endif
+
 # Include common rules
 include $(srcdir)/rules.mk
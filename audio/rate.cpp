@@ -29,20 +29,142 @@
 
 #include "audio/audiostream.h"
 #include "audio/rate.h"
+#include "audio/rate_intern.h"
 #include "audio/mixer.h"
+#include "common/system.h"
 #include "common/util.h"
 
 namespace Audio {
 
+static inline void accumulate(st_sample_t &a, int b) {
+	clampedAdd(a, b);
+}
+
+static inline void accumulate(int32 &a, int b) {
+	a += b;
+}
+
+void sincFilterGeneric(int32 *out, uint count, const int16 *in, frac_t pos, frac_t inc, const int16 *coeffs) {
+	for (uint i = 0; i < count; i++) {
+		const int16 *src = in + (pos >> FRAC_BITS_LOW);
+		const int16 *coeff = coeffs + ((pos & (FRAC_ONE_LOW - 1)) >> (FRAC_BITS_LOW - kSincPhaseBits)) * kSincTaps;
+
+		int32 sum = 0;
+		for (int j = 0; j < kSincTaps; j++)
+			sum += src[j] * coeff[j];
+
+		out[i] = (sum + (1 << (kSincCoeffBits - 1))) >> kSincCoeffBits;
+		pos += inc;
+	}
+}
+
+SincFilterFunc sincFilterFunc = nullptr;
+
+static double besselI0(double x) {
+	double sum = 1.0, term = 1.0;
+	for (int k = 1; k < 32 && term > sum * 1e-12; k++) {
+		term *= (x / (2.0 * k)) * (x / (2.0 * k));
+		sum += term;
+	}
+	return sum;
+}
+
 /**
- * The default fractional type in frac.h (with 16 fractional bits) limits
- * the rate conversion code to 65536Hz audio: we need to able to handle
- * 96kHz audio, so we use fewer fractional bits in this code.
+ * Compute the coefficients of a Kaiser windowed-sinc low pass filter for
+ * every phase, with the given cutoff frequency relative to the input
+ * Nyquist frequency. Each phase is normalized to unity gain.
  */
-enum {
-	FRAC_BITS_LOW = 15,
-	FRAC_ONE_LOW = (1L << FRAC_BITS_LOW),
-	FRAC_HALF_LOW = (1L << (FRAC_BITS_LOW-1))
+static void buildSincCoefficients(int16 *coeffs, double cutoff) {
+	const double beta = 6.0;
+	const double windowScale = 1.0 / besselI0(beta);
+
+	for (int phase = 0; phase < kSincPhases; phase++) {
+		double taps[kSincTaps];
+		double sum = 0.0;
+
+		for (int i = 0; i < kSincTaps; i++) {
+			// Distance of this tap from the output position, which lies
+			// between taps kSincTaps / 2 - 1 and kSincTaps / 2
+			const double x = i - (kSincTaps / 2 - 1) - (double)phase / kSincPhases;
+			const double r = x / (kSincTaps / 2);
+			const double window = (r >= 1.0) ? 0.0 : besselI0(beta * sqrt(1.0 - r * r)) * windowScale;
+			const double sinc = (x == 0.0) ? 1.0 : sin(M_PI * cutoff * x) / (M_PI * cutoff * x);
+
+			taps[i] = sinc * window;
+			sum += taps[i];
+		}
+
+		int16 *dst = coeffs + phase * kSincTaps;
+		int total = 0;
+		for (int i = 0; i < kSincTaps; i++) {
+			dst[i] = (int16)floor(taps[i] / sum * (1 << kSincCoeffBits) + 0.5);
+			total += dst[i];
+		}
+
+		// Put any rounding error into the tap closest to the output position
+		dst[(phase < kSincPhases / 2) ? (kSincTaps / 2 - 1) : (kSincTaps / 2)] += (1 << kSincCoeffBits) - total;
+	}
+}
+
+/**
+ * State of the polyphase filter used for high quality conversion. Input
+ * samples are kept de-interleaved so that the filter can run over
+ * contiguous memory.
+ */
+struct SincState {
+	enum {
+		kHistorySize = kSincTaps + 512,
+		kBlockSize = 256
+	};
+
+	/** Filter coefficients and the rates they were computed for */
+	int16 coeffs[kSincPhases * kSincTaps];
+	st_rate_t coeffsInRate, coeffsOutRate;
+	double cutoff;
+
+	/** Input samples which are still needed by the filter (left/right channel) */
+	int16 historyL[kHistorySize], historyR[kHistorySize];
+	int historySize;
+
+	/** Position of the next output sample relative to the start of the history */
+	frac_t pos;
+
+	/** Whether the end of the stream has been padded with silence already */
+	bool flushed;
+
+	/** Filtered samples of the current block (left/right channel) */
+	int32 outL[kBlockSize], outR[kBlockSize];
+
+	SincState() : coeffsInRate(0), coeffsOutRate(0), cutoff(0.0), historySize(kSincTaps / 2 - 1), pos(0), flushed(false) {
+		// Pre-fill the history with silence, so that the first output sample
+		// lines up with the first input sample
+		memset(historyL, 0, sizeof(historyL));
+		memset(historyR, 0, sizeof(historyR));
+	}
+
+	void updateCoefficients(st_rate_t inRate, st_rate_t outRate) {
+		coeffsInRate = inRate;
+		coeffsOutRate = outRate;
+
+		// Leave some room for the transition band, and lower the cutoff
+		// below the output Nyquist frequency when downsampling
+		double newCutoff = 0.9;
+		if (outRate < inRate)
+			newCutoff *= (double)outRate / inRate;
+
+		if (newCutoff != cutoff) {
+			cutoff = newCutoff;
+			buildSincCoefficients(coeffs, cutoff);
+		}
+	}
+
+	/** Number of output samples which can be produced from the current history */
+	uint pendingOutput(frac_t inc) const {
+		const int lastPos = historySize - kSincTaps;
+		if (lastPos < 0 || (pos >> FRAC_BITS_LOW) > lastPos)
+			return 0;
+		return (((frac_t)lastPos << FRAC_BITS_LOW) - pos) / inc + 1;
+	}
 };
 
 template<bool inStereo, bool outStereo, bool reverseStereo>
@@ -76,15 +198,33 @@ private:
 	/** Current sample(s) in the input stream (left/right channel) */
 	st_sample_t _inCurL, _inCurR;
 
-	int copyConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
-	int simpleConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
-	int interpolateConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
+	/** Polyphase filter state, only allocated for high quality conversion */
+	SincState *_sinc;
+
+	bool sincRefill(AudioStream &input);
+
+	template<typename T>
+	int copyConvert(AudioStream &input, T *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
+	template<typename T>
+	int simpleConvert(AudioStream &input, T *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
+	template<typename T>
+	int interpolateConvert(AudioStream &input, T *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
+	template<typename T>
+	int sincConvert(AudioStream &input, T *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
 
 public:
-	RateConverter_Impl(st_rate_t inputRate, st_rate_t outputRate);
-	virtual ~RateConverter_Impl() {}
+	RateConverter_Impl(st_rate_t inputRate, st_rate_t outputRate, RateConverterQuality quality);
+	virtual ~RateConverter_Impl() { delete _sinc; }
 
-	int convert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r) override;
+	template<typename T>
+	int convertT(AudioStream &input, T *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r);
+
+	int convert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r) override {
+		return convertT(input, outBuffer, numSamples, vol_l, vol_r);
+	}
+	int convert(AudioStream &input, int32 *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r) override {
+		return convertT(input, outBuffer, numSamples, vol_l, vol_r);
+	}
 
 	void setInputRate(st_rate_t inputRate) override { _inRate = inputRate; }
 	void setOutputRate(st_rate_t outputRate) override { _outRate = outputRate; }
@@ -92,12 +232,20 @@ public:
 	st_rate_t getInputRate() const override { return _inRate; }
 	st_rate_t getOutputRate() const override { return _outRate; }
 
-	bool needsDraining() const override { return _bufferSize != 0; }
+	bool needsDraining() const override {
+		if (_bufferSize != 0)
+			return true;
+		if (!_sinc || _inRate == _outRate)
+			return false;
+		// Keep going until the padded end of the stream has left the filter
+		return !_sinc->flushed || _sinc->pendingOutput((_inRate << FRAC_BITS_LOW) / _outRate) != 0;
+	}
 };
 
 template<bool inStereo, bool outStereo, bool reverseStereo>
-int RateConverter_Impl<inStereo, outStereo, reverseStereo>::copyConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
-	st_sample_t *outStart, *outEnd;
+template<typename T>
+int RateConverter_Impl<inStereo, outStereo, reverseStereo>::copyConvert(AudioStream &input, T *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
+	T *outStart, *outEnd;
 
 	outStart = outBuffer;
 	outEnd = outBuffer + numSamples * (outStereo ? 2 : 1);
@@ -124,15 +272,15 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::copyConvert(AudioStr
 
 		if (outStereo) {
 			// Output left channel
-			clampedAdd(outBuffer[reverseStereo    ], outL);
+			accumulate(outBuffer[reverseStereo    ], outL);
 
 			// Output right channel
-			clampedAdd(outBuffer[reverseStereo ^ 1], outR);
+			accumulate(outBuffer[reverseStereo ^ 1], outR);
 
 			outBuffer += 2;
 		} else {
 			// Output mono channel
-			clampedAdd(outBuffer[0], (outL + outR) / 2);
+			accumulate(outBuffer[0], (outL + outR) / 2);
 
 			outBuffer += 1;
 		}
@@ -142,11 +290,12 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::copyConvert(AudioStr
 }
 
 template<bool inStereo, bool outStereo, bool reverseStereo>
-int RateConverter_Impl<inStereo, outStereo, reverseStereo>::simpleConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
+template<typename T>
+int RateConverter_Impl<inStereo, outStereo, reverseStereo>::simpleConvert(AudioStream &input, T *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
 	// How much to increment _outPos by
 	frac_t outPos_inc = _inRate / _outRate;
 
-	st_sample_t *outStart, *outEnd;
+	T *outStart, *outEnd;
 
 	outStart = outBuffer;
 	outEnd = outBuffer + numSamples * (outStereo ? 2 : 1);
@@ -184,15 +333,15 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::simpleConvert(AudioS
 
 		if (outStereo) {
 			// output left channel
-			clampedAdd(outBuffer[reverseStereo    ], outL);
+			accumulate(outBuffer[reverseStereo    ], outL);
 
 			// output right channel
-			clampedAdd(outBuffer[reverseStereo ^ 1], outR);
+			accumulate(outBuffer[reverseStereo ^ 1], outR);
 
 			outBuffer += 2;
 		} else {
 			// output mono channel
-			clampedAdd(outBuffer[0], (outL + outR) / 2);
+			accumulate(outBuffer[0], (outL + outR) / 2);
 
 			outBuffer += 1;
 		}
@@ -201,11 +350,12 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::simpleConvert(AudioS
 }
 
 template<bool inStereo, bool outStereo, bool reverseStereo>
-int RateConverter_Impl<inStereo, outStereo, reverseStereo>::interpolateConvert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
+template<typename T>
+int RateConverter_Impl<inStereo, outStereo, reverseStereo>::interpolateConvert(AudioStream &input, T *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
 	// How much to increment _outPosFrac by
 	frac_t outPos_inc = (_inRate << FRAC_BITS_LOW) / _outRate;
 
-	st_sample_t *outStart, *outEnd;
+	T *outStart, *outEnd;
 	outStart = outBuffer;
 	outEnd = outBuffer + numSamples * (outStereo ? 2 : 1);
 
@@ -249,15 +399,15 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::interpolateConvert(A
 
 			if (outStereo) {
 				// Output left channel
-				clampedAdd(outBuffer[reverseStereo    ], outL);
+				accumulate(outBuffer[reverseStereo    ], outL);
 
 				// Output right channel
-				clampedAdd(outBuffer[reverseStereo ^ 1], outR);
+				accumulate(outBuffer[reverseStereo ^ 1], outR);
 
 				outBuffer += 2;
 			} else {
 				// Output mono channel
-				clampedAdd(outBuffer[0], (outL + outR) / 2);
+				accumulate(outBuffer[0], (outL + outR) / 2);
 
 				outBuffer += 1;
 			}
@@ -270,7 +420,115 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::interpolateConvert(A
 }
 
 template<bool inStereo, bool outStereo, bool reverseStereo>
-RateConverter_Impl<inStereo, outStereo, reverseStereo>::RateConverter_Impl(st_rate_t inputRate, st_rate_t outputRate) :
+bool RateConverter_Impl<inStereo, outStereo, reverseStereo>::sincRefill(AudioStream &input) {
+	SincState &sinc = *_sinc;
+
+	// Drop the input frames which are no longer needed by the filter
+	const int drop = MIN<int>(sinc.pos >> FRAC_BITS_LOW, sinc.historySize);
+	if (drop > 0) {
+		sinc.historySize -= drop;
+		sinc.pos -= drop << FRAC_BITS_LOW;
+		memmove(sinc.historyL, sinc.historyL + drop, sinc.historySize * sizeof(int16));
+		if (inStereo)
+			memmove(sinc.historyR, sinc.historyR + drop, sinc.historySize * sizeof(int16));
+	}
+
+	const int frames = MIN<int>(SincState::kHistorySize - sinc.historySize, ARRAYSIZE(_buffer) / 2);
+	const int samples = input.readBuffer(_buffer, frames * (inStereo ? 2 : 1));
+
+	if (samples <= 0) {
+		// Pad the end of the stream with silence, so that the last samples
+		// make it through the filter. A stream which merely ran out of data
+		// for now (e.g. a starved QueuingAudioStream) must not be padded, as
+		// that would insert silence in the middle of it.
+		if (!input.endOfStream() || sinc.flushed)
+			return false;
+
+		memset(sinc.historyL + sinc.historySize, 0, kSincTaps / 2 * sizeof(int16));
+		memset(sinc.historyR + sinc.historySize, 0, kSincTaps / 2 * sizeof(int16));
+		sinc.historySize += kSincTaps / 2;
+		sinc.flushed = true;
+		return true;
+	}
+
+	int16 *dstL = sinc.historyL + sinc.historySize;
+	int16 *dstR = sinc.historyR + sinc.historySize;
+	const st_sample_t *src = _buffer;
+	const int count = samples / (inStereo ? 2 : 1);
+	for (int i = 0; i < count; i++) {
+		*dstL++ = *src++;
+		if (inStereo)
+			*dstR++ = *src++;
+	}
+
+	sinc.historySize += count;
+	sinc.flushed = false;
+	return true;
+}
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+template<typename T>
+int RateConverter_Impl<inStereo, outStereo, reverseStereo>::sincConvert(AudioStream &input, T *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
+	SincState &sinc = *_sinc;
+
+	if (sinc.coeffsInRate != _inRate || sinc.coeffsOutRate != _outRate)
+		sinc.updateCoefficients(_inRate, _outRate);
+
+	// How much to increment the filter position by
+	const frac_t outPos_inc = (_inRate << FRAC_BITS_LOW) / _outRate;
+
+	T *outStart, *outEnd;
+	outStart = outBuffer;
+	outEnd = outBuffer + numSamples * (outStereo ? 2 : 1);
+
+	while (outBuffer < outEnd) {
+		// Compute how many output samples can be produced from the input
+		// samples currently in the history
+		uint count = sinc.pendingOutput(outPos_inc);
+		count = MIN<uint>(count, SincState::kBlockSize);
+		count = MIN<uint>(count, (outEnd - outBuffer) / (outStereo ? 2 : 1));
+
+		if (count == 0) {
+			if (!sincRefill(input))
+				break;
+			continue;
+		}
+
+		sincFilterFunc(sinc.outL, count, sinc.historyL, sinc.pos, outPos_inc, sinc.coeffs);
+		if (inStereo)
+			sincFilterFunc(sinc.outR, count, sinc.historyR, sinc.pos, outPos_inc, sinc.coeffs);
+		sinc.pos += count * outPos_inc;
+
+		for (uint i = 0; i < count; i++) {
+			st_sample_t inL, inR;
+			inL = (st_sample_t)CLIP<int32>(sinc.outL[i], ST_SAMPLE_MIN, ST_SAMPLE_MAX);
+			inR = (inStereo ? (st_sample_t)CLIP<int32>(sinc.outR[i], ST_SAMPLE_MIN, ST_SAMPLE_MAX) : inL);
+
+			st_sample_t outL, outR;
+			outL = (inL * (int)volL) / Audio::Mixer::kMaxMixerVolume;
+			outR = (inR * (int)volR) / Audio::Mixer::kMaxMixerVolume;
+
+			if (outStereo) {
+				// Output left channel
+				accumulate(outBuffer[reverseStereo    ], outL);
+
+				// Output right channel
+				accumulate(outBuffer[reverseStereo ^ 1], outR);
+
+				outBuffer += 2;
+			} else {
+				// Output mono channel
+				accumulate(outBuffer[0], (outL + outR) / 2);
+
+				outBuffer += 1;
+			}
+		}
+	}
+	return (outBuffer - outStart) / (outStereo ? 2 : 1);
+}
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+RateConverter_Impl<inStereo, outStereo, reverseStereo>::RateConverter_Impl(st_rate_t inputRate, st_rate_t outputRate, RateConverterQuality quality) :
 	_inRate(inputRate),
 	_outRate(outputRate),
 	_outPos(1),
@@ -280,14 +538,34 @@ RateConverter_Impl<inStereo, outStereo, reverseStereo>::RateConverter_Impl(st_ra
 	_inCurL(0),
 	_inCurR(0),
 	_bufferSize(0),
-	_bufferPos(nullptr) {}
+	_bufferPos(nullptr),
+	_sinc(nullptr) {
+
+	if (quality == kRateConverterQualityHigh) {
+		_sinc = new SincState();
+
+		// If no filter function has been selected yet, detect and select
+		if (!sincFilterFunc) {
+			sincFilterFunc = sincFilterGeneric;
+#ifdef SCUMMVM_NEON
+			if (g_system->hasFeature(OSystem::kFeatureCpuNEON)) sincFilterFunc = sincFilterNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+			if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) sincFilterFunc = sincFilterSSE2;
+#endif
+		}
+	}
+}
 
 template<bool inStereo, bool outStereo, bool reverseStereo>
-int RateConverter_Impl<inStereo, outStereo, reverseStereo>::convert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
+template<typename T>
+int RateConverter_Impl<inStereo, outStereo, reverseStereo>::convertT(AudioStream &input, T *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
 	assert(input.isStereo() == inStereo);
 
 	if (_inRate == _outRate) {
 		return copyConvert(input, outBuffer, numSamples, volL, volR);
+	} else if (_sinc) {
+		return sincConvert(input, outBuffer, numSamples, volL, volR);
 	} else {
 		if ((_inRate % _outRate) == 0 && (_inRate < 65536)) {
 			return simpleConvert(input, outBuffer, numSamples, volL, volR);
@@ -297,20 +575,20 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::convert(AudioStream
 	}
 }
 
-RateConverter *makeRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo) {
+RateConverter *makeRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo, RateConverterQuality quality) {
 	if (inStereo) {
 		if (outStereo) {
 			if (reverseStereo)
-				return new RateConverter_Impl<true, true, true>(inRate, outRate);
+				return new RateConverter_Impl<true, true, true>(inRate, outRate, quality);
 			else
-				return new RateConverter_Impl<true, true, false>(inRate, outRate);
+				return new RateConverter_Impl<true, true, false>(inRate, outRate, quality);
 		} else
-			return new RateConverter_Impl<true, false, false>(inRate, outRate);
+			return new RateConverter_Impl<true, false, false>(inRate, outRate, quality);
 	} else {
 		if (outStereo) {
-			return new RateConverter_Impl<false, true, false>(inRate, outRate);
+			return new RateConverter_Impl<false, true, false>(inRate, outRate, quality);
 		} else
-			return new RateConverter_Impl<false, false, false>(inRate, outRate);
+			return new RateConverter_Impl<false, false, false>(inRate, outRate, quality);
 	}
 }
 
@@ -90,6 +90,17 @@ public:
 	 */
 	virtual int convert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r) = 0;
 
+	/**
+	 * Convert the provided AudioStream to the target sample rate, accumulating
+	 * into a 32-bit buffer.
+	 *
+	 * Unlike the 16-bit variant, no clamping is performed on the output. This
+	 * allows several streams to be summed up first and clamped only once.
+	 *
+	 * @see convert(AudioStream &, st_sample_t *, st_size_t, st_volume_t, st_volume_t)
+	 */
+	virtual int convert(AudioStream &input, int32 *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r) = 0;
+
 	virtual void setInputRate(st_rate_t inputRate) = 0;
 	virtual void setOutputRate(st_rate_t outputRate) = 0;
 
@@ -104,7 +115,17 @@ public:
 	virtual bool needsDraining() const = 0;
 };
 
-RateConverter *makeRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo);
+/**
+ * Quality of the rate conversion performed by a RateConverter.
+ */
+enum RateConverterQuality {
+	/** Nearest neighbour or linear interpolation, depending on the rates */
+	kRateConverterQualityDefault,
+	/** Polyphase windowed-sinc filter, which avoids most aliasing artifacts */
+	kRateConverterQualityHigh
+};
+
+RateConverter *makeRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo, RateConverterQuality quality = kRateConverterQualityDefault);
 
 /** @} */
 } // End of namespace Audio
@@ -0,0 +1,82 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AUDIO_RATE_INTERN_H
+#define AUDIO_RATE_INTERN_H
+
+#include "common/frac.h"
+
+namespace Audio {
+
+/**
+ * The default fractional type in frac.h (with 16 fractional bits) limits
+ * the rate conversion code to 65536Hz audio: we need to able to handle
+ * 96kHz audio, so we use fewer fractional bits in this code.
+ */
+enum {
+	FRAC_BITS_LOW = 15,
+	FRAC_ONE_LOW = (1L << FRAC_BITS_LOW),
+	FRAC_HALF_LOW = (1L << (FRAC_BITS_LOW-1))
+};
+
+/**
+ * Parameters of the polyphase windowed-sinc filter used for high quality
+ * rate conversion.
+ */
+enum {
+	/** Number of filter taps, i.e. input frames contributing to one output frame */
+	kSincTaps = 16,
+	/** Number of fractional bits of the input position used to select a phase */
+	kSincPhaseBits = 8,
+	kSincPhases = (1 << kSincPhaseBits),
+	/** Fixed point precision of the filter coefficients */
+	kSincCoeffBits = 14
+};
+
+/**
+ * Run the polyphase filter over a mono input buffer.
+ *
+ * @param out		Buffer receiving @p count filtered samples.
+ * @param count		Number of output samples to compute.
+ * @param in		Input samples. Output sample n uses the kSincTaps input
+ *					samples starting at (pos + n * inc) >> FRAC_BITS_LOW.
+ * @param pos		Position of the first output sample, in FRAC_BITS_LOW fixed point.
+ * @param inc		Position increment per output sample, in FRAC_BITS_LOW fixed point.
+ * @param coeffs	Coefficient table with kSincPhases rows of kSincTaps entries.
+ */
+void sincFilterGeneric(int32 *out, uint count, const int16 *in, frac_t pos, frac_t inc, const int16 *coeffs);
+#ifdef SCUMMVM_NEON
+void sincFilterNEON(int32 *out, uint count, const int16 *in, frac_t pos, frac_t inc, const int16 *coeffs);
+#endif
+#ifdef SCUMMVM_SSE2
+void sincFilterSSE2(int32 *out, uint count, const int16 *in, frac_t pos, frac_t inc, const int16 *coeffs);
+#endif
+
+/**
+ * The filter implementation in use, selected depending on the CPU features
+ * when the first high quality converter is created.
+ */
+typedef void (*SincFilterFunc)(int32 *, uint, const int16 *, frac_t, frac_t, const int16 *);
+extern SincFilterFunc sincFilterFunc;
+
+} // End of namespace Audio
+
+#endif
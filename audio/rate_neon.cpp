@@ -0,0 +1,74 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+
+#include "audio/rate_intern.h"
+
+#include <arm_neon.h>
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("neon"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+namespace Audio {
+
+void sincFilterNEON(int32 *out, uint count, const int16 *in, frac_t pos, frac_t inc, const int16 *coeffs) {
+	for (uint i = 0; i < count; i++) {
+		const int16 *src = in + (pos >> FRAC_BITS_LOW);
+		const int16 *coeff = coeffs + ((pos & (FRAC_ONE_LOW - 1)) >> (FRAC_BITS_LOW - kSincPhaseBits)) * kSincTaps;
+
+		int32x4_t sum = vmull_s16(vld1_s16(src), vld1_s16(coeff));
+		sum = vmlal_s16(sum, vld1_s16(src + 4), vld1_s16(coeff + 4));
+		sum = vmlal_s16(sum, vld1_s16(src + 8), vld1_s16(coeff + 8));
+		sum = vmlal_s16(sum, vld1_s16(src + 12), vld1_s16(coeff + 12));
+
+		// Horizontal sum of the four partial sums
+		int32x2_t pair = vadd_s32(vget_low_s32(sum), vget_high_s32(sum));
+		pair = vpadd_s32(pair, pair);
+
+		out[i] = (vget_lane_s32(pair, 0) + (1 << (kSincCoeffBits - 1))) >> kSincCoeffBits;
+		pos += inc;
+	}
+}
+
+} // End of namespace Audio
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#endif // SCUMMVM_NEON
@@ -0,0 +1,73 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "audio/rate_intern.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace Audio {
+
+void sincFilterSSE2(int32 *out, uint count, const int16 *in, frac_t pos, frac_t inc, const int16 *coeffs) {
+	const __m128i round = _mm_set1_epi32(1 << (kSincCoeffBits - 1));
+
+	for (uint i = 0; i < count; i++) {
+		const int16 *src = in + (pos >> FRAC_BITS_LOW);
+		const int16 *coeff = coeffs + ((pos & (FRAC_ONE_LOW - 1)) >> (FRAC_BITS_LOW - kSincPhaseBits)) * kSincTaps;
+
+		// Multiply the 16 taps pairwise and sum up adjacent products
+		__m128i lo = _mm_madd_epi16(_mm_loadu_si128((const __m128i *)src), _mm_loadu_si128((const __m128i *)coeff));
+		__m128i hi = _mm_madd_epi16(_mm_loadu_si128((const __m128i *)(src + 8)), _mm_loadu_si128((const __m128i *)(coeff + 8)));
+		__m128i sum = _mm_add_epi32(lo, hi);
+
+		// Horizontal sum of the four partial sums
+		sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+		sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+		sum = _mm_srai_epi32(_mm_add_epi32(sum, round), kSincCoeffBits);
+
+		out[i] = _mm_cvtsi128_si32(sum);
+		pos += inc;
+	}
+}
+
+} // End of namespace Audio
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
@@ -31,11 +31,8 @@ static const Bit32u MAX_CUTOFF_VALUE = 240 << 18;
 static const LogSample SILENCE = {65535, LogSample::POSITIVE};
 
 Bit16u LA32Utilites::interpolateExp(const Bit16u fract) {
-	Bit16u expTabIndex = fract >> 3;
-	Bit16u extraBits = ~fract & 7;
-	Bit16u expTabEntry2 = 8191 - Tables::getInstance().exp9[expTabIndex];
-	Bit16u expTabEntry1 = expTabIndex == 0 ? 8191 : (8191 - Tables::getInstance().exp9[expTabIndex - 1]);
-	return expTabEntry2 + (((expTabEntry1 - expTabEntry2) * extraBits) >> 3);
+	// The interpolation results are precomputed for all the possible arguments
+	return Tables::getInstance().interpolatedExp9[fract & 4095];
 }
 
 Bit16s LA32Utilites::unlog(const LogSample &logSample) {
@@ -119,14 +116,21 @@ void LA32WaveGenerator::computePositions(Bit32u highLinearLength, Bit32u lowLine
 }
 
 void LA32WaveGenerator::advancePosition() {
-	wavePosition += getSampleStep();
+	if (pitch != cachedPitch) {
+		cachedPitch = pitch;
+		cachedSampleStep = getSampleStep();
+	}
+	wavePosition += cachedSampleStep;
 	wavePosition %= 4 * SINE_SEGMENT_RELATIVE_LENGTH;
 
 	Bit32u effectiveCutoffValue = (cutoffVal > MIDDLE_CUTOFF_VALUE) ? (cutoffVal - MIDDLE_CUTOFF_VALUE) >> 10 : 0;
-	Bit32u resonanceWaveLengthFactor = getResonanceWaveLengthFactor(effectiveCutoffValue);
-	Bit32u highLinearLength = getHighLinearLength(effectiveCutoffValue);
-	Bit32u lowLinearLength = (resonanceWaveLengthFactor << 8) - 4 * SINE_SEGMENT_RELATIVE_LENGTH - highLinearLength;
-	computePositions(highLinearLength, lowLinearLength, resonanceWaveLengthFactor);
+	if (effectiveCutoffValue != cachedCutoffValue) {
+		cachedCutoffValue = effectiveCutoffValue;
+		cachedResonanceWaveLengthFactor = getResonanceWaveLengthFactor(effectiveCutoffValue);
+		cachedHighLinearLength = getHighLinearLength(effectiveCutoffValue);
+		cachedLowLinearLength = (cachedResonanceWaveLengthFactor << 8) - 4 * SINE_SEGMENT_RELATIVE_LENGTH - cachedHighLinearLength;
+	}
+	computePositions(cachedHighLinearLength, cachedLowLinearLength, cachedResonanceWaveLengthFactor);
 
 	resonancePhase = ResonancePhase(((resonanceSinePosition >> 18) + (phase > POSITIVE_FALLING_SINE_SEGMENT ? 2 : 0)) & 3);
 }
@@ -269,6 +273,11 @@ void LA32WaveGenerator::initSynth(const bool useSawtoothWaveform, const Bit8u us
 	resonanceAmpSubtraction = (32 - resonance) << 10;
 	resAmpDecayFactor = Tables::getInstance().resAmpDecayFactor[resonance >> 2] << 2;
 
+	// Neither the pitch (at most 59392) nor the effective cutoff value can be equal to these,
+	// so the cached values are computed for the first sample
+	cachedPitch = 0xFFFF;
+	cachedCutoffValue = 0xFFFFFFFF;
+
 	pcmWaveAddress = NULL;
 	active = true;
 }
@@ -132,6 +132,14 @@ class LA32WaveGenerator {
 	// Fractional part of the pcmPosition
 	Bit32u pcmInterpolationFactor;
 
+	// The pitch and the cutoff change slowly, so the values derived from them are only recomputed when needed
+	Bit16u cachedPitch;
+	Bit32u cachedSampleStep;
+	Bit32u cachedCutoffValue;
+	Bit32u cachedResonanceWaveLengthFactor;
+	Bit32u cachedHighLinearLength;
+	Bit32u cachedLowLinearLength;
+
 	// Current phase of the square wave
 	enum {
 		POSITIVE_RISING_SINE_SEGMENT,
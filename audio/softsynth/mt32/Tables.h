@@ -30,7 +30,11 @@ private:
 	~Tables() {}
 
 public:
-	static const Tables &getInstance();
+	static const Tables &getInstance() {
+		// Defined inline as the LA32 wave generator looks up the tables several times per sample
+		static const Tables instance;
+		return instance;
+	}
 
 	// Constant LUTs
 
@@ -54,6 +58,9 @@ public:
 	Bit16u exp9[512];
 	Bit16u logsin9[512];
 
+	// Values of exp9 interpolated the same way as in the LA32 chip for every 12-bit fractional argument, see LA32Utilites::interpolateExp()
+	Bit16u interpolatedExp9[4096];
+
 	const Bit8u *resAmpDecayFactor;
 }; // class Tables
 
@@ -387,64 +387,58 @@ static void OPL3_EnvelopeUpdateKSL(opl3_slot *slot)
     slot->eg_ksl = (uint8_t)ksl;
 }
 
-static void OPL3_EnvelopeCalc(opl3_slot *slot)
+static uint16_t OPL3_EnvelopeRate(uint8_t ks, uint8_t reg_rate)
 {
+    uint8_t rate;
+    uint8_t rate_hi;
+    if (!reg_rate)
+    {
+        return 0;
+    }
+    rate = ks + (reg_rate << 2);
+    rate_hi = rate >> 2;
+    if (rate_hi & 0x10)
+    {
+        rate_hi = 0x0f;
+    }
+    return (rate_hi << 2) | (rate & 0x03);
+}
+
+static void OPL3_EnvelopeCalc(opl3_chip *chip, uint8_t slot)
+{
+    opl3_slotgen *gen = &chip->slotgen;
     uint8_t nonzero;
     uint8_t rate;
     uint8_t rate_hi;
     uint8_t rate_lo;
-    uint8_t reg_rate = 0;
-    uint8_t ks;
     uint8_t eg_shift, shift;
     uint16_t eg_rout;
     int16_t eg_inc;
     uint8_t eg_off;
     uint8_t reset = 0;
-    slot->eg_out = slot->eg_rout + (slot->reg_tl << 2)
-                 + (slot->eg_ksl >> kslshift[slot->reg_ksl]) + *slot->trem;
-    if (slot->key && slot->eg_gen == envelope_gen_num_release)
+    uint8_t key = gen->eg_key[slot] != 0;
+    gen->eg_out[slot] = gen->eg_rout[slot] + gen->eg_base[slot]
+                      + (chip->tremolo & gen->eg_trem[slot]);
+    if (key && gen->eg_gen[slot] == envelope_gen_num_release)
     {
         reset = 1;
-        reg_rate = slot->reg_ar;
+        rate = gen->eg_rate[envelope_gen_num_attack][slot];
     }
     else
     {
-        switch (slot->eg_gen)
-        {
-        case envelope_gen_num_attack:
-            reg_rate = slot->reg_ar;
-            break;
-        case envelope_gen_num_decay:
-            reg_rate = slot->reg_dr;
-            break;
-        case envelope_gen_num_sustain:
-            if (!slot->reg_type)
-            {
-                reg_rate = slot->reg_rr;
-            }
-            break;
-        case envelope_gen_num_release:
-            reg_rate = slot->reg_rr;
-            break;
-        }
+        rate = gen->eg_rate[gen->eg_gen[slot]][slot];
     }
-    slot->pg_reset = reset;
-    ks = slot->channel->ksv >> ((slot->reg_ksr ^ 1) << 1);
-    nonzero = (reg_rate != 0);
-    rate = ks + (reg_rate << 2);
+    gen->pg_reset[slot] = reset ? 0xffff : 0;
+    nonzero = (rate != 0);
     rate_hi = rate >> 2;
     rate_lo = rate & 0x03;
-    if (rate_hi & 0x10)
-    {
-        rate_hi = 0x0f;
-    }
-    eg_shift = rate_hi + slot->chip->eg_add;
+    eg_shift = rate_hi + chip->eg_add;
     shift = 0;
     if (nonzero)
     {
         if (rate_hi < 12)
         {
-            if (slot->chip->eg_state)
+            if (chip->eg_state)
             {
                 switch (eg_shift)
                 {
@@ -464,18 +458,18 @@ static void OPL3_EnvelopeCalc(opl3_slot *slot)
         }
         else
         {
-            shift = (rate_hi & 0x03) + eg_incstep[rate_lo][slot->chip->eg_timer_lo];
+            shift = (rate_hi & 0x03) + eg_incstep[rate_lo][chip->eg_timer_lo];
             if (shift & 0x04)
             {
                 shift = 0x03;
             }
             if (!shift)
             {
-                shift = slot->chip->eg_state;
+                shift = chip->eg_state;
             }
         }
     }
-    eg_rout = slot->eg_rout;
+    eg_rout = gen->eg_rout[slot];
     eg_inc = 0;
     eg_off = 0;
     /* Instant attack */
@@ -484,30 +478,30 @@ static void OPL3_EnvelopeCalc(opl3_slot *slot)
         eg_rout = 0x00;
     }
     /* Envelope off */
-    if ((slot->eg_rout & 0x1f8) == 0x1f8)
+    if ((gen->eg_rout[slot] & 0x1f8) == 0x1f8)
     {
         eg_off = 1;
     }
-    if (slot->eg_gen != envelope_gen_num_attack && !reset && eg_off)
+    if (gen->eg_gen[slot] != envelope_gen_num_attack && !reset && eg_off)
     {
         eg_rout = 0x1ff;
     }
-    switch (slot->eg_gen)
+    switch (gen->eg_gen[slot])
     {
     case envelope_gen_num_attack:
-        if (!slot->eg_rout)
+        if (!gen->eg_rout[slot])
         {
-            slot->eg_gen = envelope_gen_num_decay;
+            gen->eg_gen[slot] = envelope_gen_num_decay;
         }
-        else if (slot->key && shift > 0 && rate_hi != 0x0f)
+        else if (key && shift > 0 && rate_hi != 0x0f)
         {
-            eg_inc = ~slot->eg_rout >> (4 - shift);
+            eg_inc = ~gen->eg_rout[slot] >> (4 - shift);
         }
         break;
     case envelope_gen_num_decay:
-        if ((slot->eg_rout >> 4) == slot->reg_sl)
+        if ((gen->eg_rout[slot] >> 4) == gen->eg_sl[slot])
         {
-            slot->eg_gen = envelope_gen_num_sustain;
+            gen->eg_gen[slot] = envelope_gen_num_sustain;
         }
         else if (!eg_off && !reset && shift > 0)
         {
@@ -522,15 +516,15 @@ static void OPL3_EnvelopeCalc(opl3_slot *slot)
         }
         break;
     }
-    slot->eg_rout = (eg_rout + eg_inc) & 0x1ff;
+    gen->eg_rout[slot] = (eg_rout + eg_inc) & 0x1ff;
     /* Key off */
     if (reset)
     {
-        slot->eg_gen = envelope_gen_num_attack;
+        gen->eg_gen[slot] = envelope_gen_num_attack;
     }
-    if (!slot->key)
+    if (!key)
     {
-        slot->eg_gen = envelope_gen_num_release;
+        gen->eg_gen[slot] = envelope_gen_num_release;
     }
 }
 
@@ -548,24 +542,20 @@ static void OPL3_EnvelopeKeyOff(opl3_slot *slot, uint8_t type)
     Phase Generator
 */
 
-static void OPL3_PhaseGenerate(opl3_slot *slot)
+static void OPL3_PhaseGenerate(opl3_chip *chip, uint8_t slot)
 {
-    opl3_chip *chip;
-    uint16_t f_num;
+    opl3_slotgen *gen = &chip->slotgen;
+    uint32_t f_num;
     uint32_t basefreq;
-    uint8_t rm_xor, n_bit;
-    uint32_t noise;
-    uint16_t phase;
 
-    chip = slot->chip;
-    f_num = slot->channel->f_num;
-    if (slot->reg_vib)
+    f_num = gen->pg_fnum[slot];
+    if (gen->pg_vib[slot])
     {
         int8_t range;
         uint8_t vibpos;
 
-        range = (f_num >> 7) & 7;
-        vibpos = slot->chip->vibpos;
+        range = (int8_t)gen->pg_vib[slot];
+        vibpos = chip->vibpos;
 
         if (!(vibpos & 3))
         {
@@ -575,7 +565,7 @@ static void OPL3_PhaseGenerate(opl3_slot *slot)
         {
             range >>= 1;
         }
-        range >>= slot->chip->vibshift;
+        range >>= chip->vibshift;
 
         if (vibpos & 4)
         {
@@ -583,61 +573,125 @@ static void OPL3_PhaseGenerate(opl3_slot *slot)
         }
         f_num += range;
     }
-    basefreq = (f_num << slot->channel->block) >> 1;
-    phase = (uint16_t)(slot->pg_phase >> 9);
-    if (slot->pg_reset)
+    basefreq = gen->pg_half[slot] ? f_num >> 1 : f_num;
+    gen->pg_phase_out[slot] = (uint16_t)(gen->pg_phase[slot] >> 9);
+    if (gen->pg_reset[slot])
     {
-        slot->pg_phase = 0;
+        gen->pg_phase[slot] = 0;
     }
-    slot->pg_phase += (basefreq * mt[slot->reg_mult]) >> 1;
-    /* Rhythm mode */
+    gen->pg_phase[slot] += (basefreq * gen->pg_mult[slot]) >> 1;
+}
+
+static void OPL3_PhaseGenerateRhythm(opl3_chip *chip)
+{
+    opl3_slotgen *gen = &chip->slotgen;
+    uint8_t rm_xor, n_bit;
+    uint8_t noise_hh = 0, noise_sd = 0;
+    uint32_t noise;
+    uint16_t phase;
+    uint8_t ii;
+
+    /* The noise generator is clocked once per slot */
     noise = chip->noise;
-    slot->pg_phase_out = phase;
-    if (slot->slot_num == 13) /* hh */
+    for (ii = 0; ii < 36; ii++)
     {
-        chip->rm_hh_bit2 = (phase >> 2) & 1;
-        chip->rm_hh_bit3 = (phase >> 3) & 1;
-        chip->rm_hh_bit7 = (phase >> 7) & 1;
-        chip->rm_hh_bit8 = (phase >> 8) & 1;
+        if (ii == 13)
+        {
+            noise_hh = noise & 1;
+        }
+        else if (ii == 16)
+        {
+            noise_sd = noise & 1;
+        }
+        n_bit = ((noise >> 14) ^ noise) & 0x01;
+        noise = (noise >> 1) | (n_bit << 22);
     }
-    if (slot->slot_num == 17 && (chip->rhy & 0x20)) /* tc */
+    chip->noise = noise;
+
+    phase = gen->pg_phase_out[13]; /* hh */
+    chip->rm_hh_bit2 = (phase >> 2) & 1;
+    chip->rm_hh_bit3 = (phase >> 3) & 1;
+    chip->rm_hh_bit7 = (phase >> 7) & 1;
+    chip->rm_hh_bit8 = (phase >> 8) & 1;
+    if (!(chip->rhy & 0x20))
     {
-        chip->rm_tc_bit3 = (phase >> 3) & 1;
-        chip->rm_tc_bit5 = (phase >> 5) & 1;
+        return;
     }
-    if (chip->rhy & 0x20)
+    rm_xor = (chip->rm_hh_bit2 ^ chip->rm_hh_bit7)
+           | (chip->rm_hh_bit3 ^ chip->rm_tc_bit5)
+           | (chip->rm_tc_bit3 ^ chip->rm_tc_bit5);
+    gen->pg_phase_out[13] = rm_xor << 9;
+    if (rm_xor ^ noise_hh)
+    {
+        gen->pg_phase_out[13] |= 0xd0;
+    }
+    else
+    {
+        gen->pg_phase_out[13] |= 0x34;
+    }
+    /* sd */
+    gen->pg_phase_out[16] = (chip->rm_hh_bit8 << 9)
+                          | ((chip->rm_hh_bit8 ^ noise_sd) << 8);
+    phase = gen->pg_phase_out[17]; /* tc */
+    chip->rm_tc_bit3 = (phase >> 3) & 1;
+    chip->rm_tc_bit5 = (phase >> 5) & 1;
+    rm_xor = (chip->rm_hh_bit2 ^ chip->rm_hh_bit7)
+           | (chip->rm_hh_bit3 ^ chip->rm_tc_bit5)
+           | (chip->rm_tc_bit3 ^ chip->rm_tc_bit5);
+    gen->pg_phase_out[17] = (rm_xor << 9) | 0x80;
+}
+
+void OPL3_SlotGenUpdate(opl3_chip *chip)
+{
+    opl3_slotgen *gen = &chip->slotgen;
+    opl3_slot *slot;
+    opl3_channel *channel;
+    uint8_t ks;
+    uint8_t ii;
+
+    for (ii = 0; ii < 36; ii++)
     {
-        rm_xor = (chip->rm_hh_bit2 ^ chip->rm_hh_bit7)
-               | (chip->rm_hh_bit3 ^ chip->rm_tc_bit5)
-               | (chip->rm_tc_bit3 ^ chip->rm_tc_bit5);
-        switch (slot->slot_num)
+        slot = &chip->slot[ii];
+        channel = slot->channel;
+        gen->eg_base[ii] = (slot->reg_tl << 2) + (slot->eg_ksl >> kslshift[slot->reg_ksl]);
+        gen->eg_trem[ii] = (slot->trem == &chip->tremolo) ? 0xffff : 0;
+        gen->eg_key[ii] = slot->key ? 0xffff : 0;
+        gen->eg_sl[ii] = slot->reg_sl;
+        ks = channel->ksv >> ((slot->reg_ksr ^ 1) << 1);
+        gen->eg_rate[envelope_gen_num_attack][ii] = OPL3_EnvelopeRate(ks, slot->reg_ar);
+        gen->eg_rate[envelope_gen_num_decay][ii] = OPL3_EnvelopeRate(ks, slot->reg_dr);
+        gen->eg_rate[envelope_gen_num_sustain][ii] = OPL3_EnvelopeRate(ks, slot->reg_type ? 0 : slot->reg_rr);
+        gen->eg_rate[envelope_gen_num_release][ii] = OPL3_EnvelopeRate(ks, slot->reg_rr);
+        gen->pg_fnum[ii] = channel->f_num;
+        gen->pg_vib[ii] = slot->reg_vib ? (channel->f_num >> 7) & 7 : 0;
+        if (channel->block)
         {
-        case 13: /* hh */
-            slot->pg_phase_out = rm_xor << 9;
-            if (rm_xor ^ (noise & 1))
-            {
-                slot->pg_phase_out |= 0xd0;
-            }
-            else
-            {
-                slot->pg_phase_out |= 0x34;
-            }
-            break;
-        case 16: /* sd */
-            slot->pg_phase_out = (chip->rm_hh_bit8 << 9)
-                               | ((chip->rm_hh_bit8 ^ (noise & 1)) << 8);
-            break;
-        case 17: /* tc */
-            slot->pg_phase_out = (rm_xor << 9) | 0x80;
-            break;
-        default:
-            break;
+            gen->pg_half[ii] = 0;
+            gen->pg_mult[ii] = mt[slot->reg_mult] << (channel->block - 1);
+        }
+        else
+        {
+            gen->pg_half[ii] = 0xffffffff;
+            gen->pg_mult[ii] = mt[slot->reg_mult];
         }
     }
-    n_bit = ((noise >> 14) ^ noise) & 0x01;
-    chip->noise = (noise >> 1) | (n_bit << 22);
+    chip->slotgen_dirty = 0;
 }
 
+void OPL3_SlotGenCalcGeneric(opl3_chip *chip)
+{
+    uint8_t ii;
+    for (ii = 0; ii < 36; ii++)
+    {
+        OPL3_EnvelopeCalc(chip, ii);
+        OPL3_PhaseGenerate(chip, ii);
+    }
+}
+
+typedef void(*slotgen_calcfunc)(opl3_chip *chip);
+
+static slotgen_calcfunc OPL3_SlotGenCalc = OPL3_SlotGenCalcGeneric;
+
 /*
     Slot
 */
@@ -692,7 +746,9 @@ static void OPL3_SlotWriteE0(opl3_slot *slot, uint8_t data)
 
 static void OPL3_SlotGenerate(opl3_slot *slot)
 {
-    slot->out = envelope_sin[slot->reg_wf](slot->pg_phase_out + *slot->mod, slot->eg_out);
+    opl3_slotgen *gen = &slot->chip->slotgen;
+    slot->out = envelope_sin[slot->reg_wf](gen->pg_phase_out[slot->slot_num] + *slot->mod,
+                                           gen->eg_out[slot->slot_num]);
 }
 
 static void OPL3_SlotCalcFB(opl3_slot *slot)
@@ -1106,8 +1162,6 @@ static int16_t OPL3_ClipSample(int32_t sample)
 static void OPL3_ProcessSlot(opl3_slot *slot)
 {
     OPL3_SlotCalcFB(slot);
-    OPL3_EnvelopeCalc(slot);
-    OPL3_PhaseGenerate(slot);
     OPL3_SlotGenerate(slot);
 }
 
@@ -1124,6 +1178,13 @@ inline void OPL3_Generate4Ch(opl3_chip *chip, int16_t *buf4)
     buf4[1] = OPL3_ClipSample(chip->mixbuff[1]);
     buf4[3] = OPL3_ClipSample(chip->mixbuff[3]);
 
+    if (chip->slotgen_dirty)
+    {
+        OPL3_SlotGenUpdate(chip);
+    }
+    OPL3_SlotGenCalc(chip);
+    OPL3_PhaseGenerateRhythm(chip);
+
 #if OPL_QUIRK_CHANNELSAMPLEDELAY
     for (ii = 0; ii < 15; ii++)
 #else
@@ -1307,9 +1368,9 @@ void OPL3_Reset(opl3_chip *chip, uint32_t samplerate)
         slot = &chip->slot[slotnum];
         slot->chip = chip;
         slot->mod = &chip->zeromod;
-        slot->eg_rout = 0x1ff;
-        slot->eg_out = 0x1ff;
-        slot->eg_gen = envelope_gen_num_release;
+        chip->slotgen.eg_rout[slotnum] = 0x1ff;
+        chip->slotgen.eg_out[slotnum] = 0x1ff;
+        chip->slotgen.eg_gen[slotnum] = envelope_gen_num_release;
         slot->trem = (uint8_t*)&chip->zeromod;
         slot->slot_num = slotnum;
     }
@@ -1345,6 +1406,7 @@ void OPL3_Reset(opl3_chip *chip, uint32_t samplerate)
         OPL3_ChannelSetupAlg(channel);
     }
     chip->noise = 1;
+    chip->slotgen_dirty = 1;
     chip->rateratio = (samplerate << RSM_FRAC) / 49716;
     chip->tremoloshift = 4;
     chip->vibshift = 1;
@@ -1366,6 +1428,7 @@ void OPL3_WriteReg(opl3_chip *chip, uint16_t reg, uint8_t v)
 {
     uint8_t high = (reg >> 8) & 0x01;
     uint8_t regm = reg & 0xff;
+    chip->slotgen_dirty = 1;
     switch (regm & 0xf0)
     {
     case 0x00:
@@ -1543,6 +1606,16 @@ bool OPL::init() {
 	_rate = g_system->getMixer()->getOutputRate();
 	OPL3_Reset(&chip, _rate);
 
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON)) OPL3_SlotGenCalc = OPL3_SlotGenCalcNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) OPL3_SlotGenCalc = OPL3_SlotGenCalcSSE2;
+#endif
+#ifdef SCUMMVM_AVX2
+	if (g_system->hasFeature(OSystem::kFeatureCpuAVX2)) OPL3_SlotGenCalc = OPL3_SlotGenCalcAVX2;
+#endif
+
 	if (_type == Config::kDualOpl2) {
 		OPL3_WriteReg(&chip, 0x105, 0x01);
 	}
@@ -55,11 +55,6 @@ struct _opl3_slot {
     int16_t fbmod;
     int16_t *mod;
     int16_t prout;
-    uint16_t eg_rout;
-    uint16_t eg_out;
-    uint8_t eg_inc;
-    uint8_t eg_gen;
-    uint8_t eg_rate;
     uint8_t eg_ksl;
     uint8_t *trem;
     uint8_t reg_vib;
@@ -74,9 +69,6 @@ struct _opl3_slot {
     uint8_t reg_rr;
     uint8_t reg_wf;
     uint8_t key;
-    uint32_t pg_reset;
-    uint32_t pg_phase;
-    uint16_t pg_phase_out;
     uint8_t slot_num;
 };
 
@@ -103,6 +95,34 @@ struct _opl3_channel {
     uint8_t ch_num;
 };
 
+/*
+    Envelope and phase generators of all the slots, as structure of arrays
+    so that the slots can be updated together. The arrays are padded for
+    the vectorized versions, which process up to 16 slots at once.
+*/
+#define OPL_SLOTGEN_SIZE 48
+
+typedef struct _opl3_slotgen {
+    /* Parameters, derived from the registers by OPL3_SlotGenUpdate */
+    uint16_t eg_base[OPL_SLOTGEN_SIZE];     /* total level and key scale level */
+    uint16_t eg_trem[OPL_SLOTGEN_SIZE];     /* 0xffff if tremolo is enabled */
+    uint16_t eg_key[OPL_SLOTGEN_SIZE];      /* 0xffff if the slot is keyed on */
+    uint16_t eg_sl[OPL_SLOTGEN_SIZE];
+    uint16_t eg_rate[4][OPL_SLOTGEN_SIZE];  /* per stage, 0 or (rate_hi << 2) | rate_lo */
+    uint32_t pg_fnum[OPL_SLOTGEN_SIZE];
+    uint32_t pg_vib[OPL_SLOTGEN_SIZE];      /* vibrato range, 0 if vibrato is disabled */
+    uint32_t pg_half[OPL_SLOTGEN_SIZE];     /* 0xffffffff if the block is 0 */
+    uint32_t pg_mult[OPL_SLOTGEN_SIZE];     /* multiplier, including the block */
+
+    /* Generator state */
+    uint16_t eg_rout[OPL_SLOTGEN_SIZE];
+    uint16_t eg_out[OPL_SLOTGEN_SIZE];
+    uint16_t eg_gen[OPL_SLOTGEN_SIZE];
+    uint16_t pg_reset[OPL_SLOTGEN_SIZE];    /* 0xffff if the phase is reset */
+    uint16_t pg_phase_out[OPL_SLOTGEN_SIZE];
+    uint32_t pg_phase[OPL_SLOTGEN_SIZE];
+} opl3_slotgen;
+
 typedef struct _opl3_writebuf {
     uint64_t time;
     uint16_t reg;
@@ -136,6 +156,9 @@ struct _opl3_chip {
     uint8_t rm_tc_bit3;
     uint8_t rm_tc_bit5;
 
+    opl3_slotgen slotgen;
+    uint8_t slotgen_dirty;
+
 #if OPL_ENABLE_STEREOEXT
     uint8_t stereoext;
 #endif
@@ -164,6 +187,21 @@ void OPL3_Generate4Ch(opl3_chip *chip, int16_t *buf4);
 void OPL3_Generate4ChResampled(opl3_chip *chip, int16_t *buf4);
 void OPL3_Generate4ChStream(opl3_chip *chip, int16_t *sndptr1, int16_t *sndptr2, uint32_t numsamples);
 
+/* Derive the slot generator parameters from the registers */
+void OPL3_SlotGenUpdate(opl3_chip *chip);
+
+/* Run the envelope and phase generators of all the slots for one sample */
+void OPL3_SlotGenCalcGeneric(opl3_chip *chip);
+#ifdef SCUMMVM_NEON
+void OPL3_SlotGenCalcNEON(opl3_chip *chip);
+#endif
+#ifdef SCUMMVM_SSE2
+void OPL3_SlotGenCalcSSE2(opl3_chip *chip);
+#endif
+#ifdef SCUMMVM_AVX2
+void OPL3_SlotGenCalcAVX2(opl3_chip *chip);
+#endif
+
 class OPL : public ::OPL::OPL, public Audio::EmulatedChip {
 private:
 	Config::OplType _type;
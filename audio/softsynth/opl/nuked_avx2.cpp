@@ -0,0 +1,181 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "common/scummsys.h"
+
+#include "audio/softsynth/opl/nuked.h"
+
+#ifndef DISABLE_NUKED_OPL
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace OPL {
+namespace NUKED {
+
+/**
+ * Run the envelope generators of sixteen slots, see OPL3_EnvelopeCalc for
+ * the scalar version.
+ */
+static FORCEINLINE void envelopeCalc(opl3_chip *chip, opl3_slotgen *gen, int i, __m256i incThreshold) {
+	const __m256i one = _mm256_set1_epi16(1);
+	const __m256i three = _mm256_set1_epi16(3);
+	const __m256i ones = _mm256_set1_epi16(-1);
+
+	const __m256i rout = _mm256_loadu_si256((const __m256i *)(gen->eg_rout + i));
+	const __m256i stage = _mm256_loadu_si256((const __m256i *)(gen->eg_gen + i));
+	const __m256i key = _mm256_loadu_si256((const __m256i *)(gen->eg_key + i));
+
+	const __m256i trem = _mm256_and_si256(_mm256_loadu_si256((const __m256i *)(gen->eg_trem + i)), _mm256_set1_epi16(chip->tremolo));
+	const __m256i out = _mm256_add_epi16(_mm256_add_epi16(rout, _mm256_loadu_si256((const __m256i *)(gen->eg_base + i))), trem);
+	_mm256_storeu_si256((__m256i *)(gen->eg_out + i), out);
+
+	const __m256i attack = _mm256_cmpeq_epi16(stage, _mm256_setzero_si256());
+	const __m256i decay = _mm256_cmpeq_epi16(stage, one);
+	const __m256i sustain = _mm256_cmpeq_epi16(stage, _mm256_set1_epi16(2));
+	const __m256i release = _mm256_cmpeq_epi16(stage, three);
+	const __m256i reset = _mm256_and_si256(key, release);
+
+	const __m256i attackRate = _mm256_loadu_si256((const __m256i *)(gen->eg_rate[0] + i));
+	__m256i rate = _mm256_and_si256(attack, attackRate);
+	rate = _mm256_or_si256(rate, _mm256_and_si256(decay, _mm256_loadu_si256((const __m256i *)(gen->eg_rate[1] + i))));
+	rate = _mm256_or_si256(rate, _mm256_and_si256(sustain, _mm256_loadu_si256((const __m256i *)(gen->eg_rate[2] + i))));
+	rate = _mm256_or_si256(rate, _mm256_and_si256(release, _mm256_loadu_si256((const __m256i *)(gen->eg_rate[3] + i))));
+	rate = _mm256_or_si256(_mm256_and_si256(reset, attackRate), _mm256_andnot_si256(reset, rate));
+
+	const __m256i rateHi = _mm256_srli_epi16(rate, 2);
+	const __m256i rateLo = _mm256_and_si256(rate, three);
+	const __m256i nonzero = _mm256_xor_si256(_mm256_cmpeq_epi16(rate, _mm256_setzero_si256()), ones);
+	const __m256i rateMax = _mm256_cmpeq_epi16(rateHi, _mm256_set1_epi16(0x0f));
+
+	// Shift for the rates below 12, which only step on every other sample
+	__m256i shiftLow = _mm256_setzero_si256();
+	if (chip->eg_state) {
+		const __m256i egShift = _mm256_add_epi16(rateHi, _mm256_set1_epi16(chip->eg_add));
+		shiftLow = _mm256_and_si256(_mm256_cmpeq_epi16(egShift, _mm256_set1_epi16(12)), one);
+		shiftLow = _mm256_or_si256(shiftLow, _mm256_and_si256(_mm256_cmpeq_epi16(egShift, _mm256_set1_epi16(13)), _mm256_srli_epi16(rateLo, 1)));
+		shiftLow = _mm256_or_si256(shiftLow, _mm256_and_si256(_mm256_cmpeq_epi16(egShift, _mm256_set1_epi16(14)), _mm256_and_si256(rateLo, one)));
+	}
+
+	// Shift for the higher rates
+	__m256i shiftHigh = _mm256_add_epi16(_mm256_and_si256(rateHi, three), _mm256_and_si256(_mm256_cmpgt_epi16(rateLo, incThreshold), one));
+	shiftHigh = _mm256_min_epi16(shiftHigh, three);
+	shiftHigh = _mm256_or_si256(shiftHigh, _mm256_and_si256(_mm256_cmpeq_epi16(shiftHigh, _mm256_setzero_si256()), _mm256_set1_epi16(chip->eg_state)));
+
+	const __m256i isLow = _mm256_cmpgt_epi16(_mm256_set1_epi16(12), rateHi);
+	__m256i shift = _mm256_or_si256(_mm256_and_si256(isLow, shiftLow), _mm256_andnot_si256(isLow, shiftHigh));
+	shift = _mm256_and_si256(shift, nonzero);
+
+	// Instant attack, and envelope off
+	const __m256i egOff = _mm256_cmpeq_epi16(_mm256_and_si256(rout, _mm256_set1_epi16(0x1f8)), _mm256_set1_epi16(0x1f8));
+	__m256i base = _mm256_andnot_si256(_mm256_and_si256(reset, rateMax), rout);
+	base = _mm256_or_si256(base, _mm256_and_si256(_mm256_andnot_si256(_mm256_or_si256(attack, reset), egOff), _mm256_set1_epi16(0x1ff)));
+
+	// Attack increment, ~rout >> (4 - shift)
+	const __m256i notRout = _mm256_xor_si256(rout, ones);
+	__m256i attackInc = _mm256_and_si256(_mm256_cmpeq_epi16(shift, one), _mm256_srai_epi16(notRout, 3));
+	attackInc = _mm256_or_si256(attackInc, _mm256_and_si256(_mm256_cmpeq_epi16(shift, _mm256_set1_epi16(2)), _mm256_srai_epi16(notRout, 2)));
+	attackInc = _mm256_or_si256(attackInc, _mm256_and_si256(_mm256_cmpeq_epi16(shift, three), _mm256_srai_epi16(notRout, 1)));
+	const __m256i routZero = _mm256_cmpeq_epi16(rout, _mm256_setzero_si256());
+	const __m256i attackCond = _mm256_andnot_si256(_mm256_or_si256(routZero, rateMax), _mm256_and_si256(attack, key));
+
+	// Decay, sustain and release increment, 1 << (shift - 1)
+	const __m256i linearInc = _mm256_add_epi16(shift, _mm256_and_si256(_mm256_cmpeq_epi16(shift, three), one));
+	const __m256i sustainLevel = _mm256_cmpeq_epi16(_mm256_srli_epi16(rout, 4), _mm256_loadu_si256((const __m256i *)(gen->eg_sl + i)));
+	const __m256i decayDone = _mm256_and_si256(decay, sustainLevel);
+	const __m256i linearCond = _mm256_xor_si256(_mm256_or_si256(_mm256_or_si256(attack, egOff), _mm256_or_si256(reset, decayDone)), ones);
+
+	const __m256i inc = _mm256_or_si256(_mm256_and_si256(attackCond, attackInc), _mm256_and_si256(linearCond, linearInc));
+	_mm256_storeu_si256((__m256i *)(gen->eg_rout + i), _mm256_and_si256(_mm256_add_epi16(base, inc), _mm256_set1_epi16(0x1ff)));
+
+	// Next stage
+	__m256i nextStage = _mm256_add_epi16(stage, _mm256_and_si256(_mm256_and_si256(attack, routZero), one));
+	nextStage = _mm256_add_epi16(nextStage, _mm256_and_si256(decayDone, one));
+	nextStage = _mm256_andnot_si256(reset, nextStage);
+	nextStage = _mm256_or_si256(nextStage, _mm256_andnot_si256(key, three));
+	_mm256_storeu_si256((__m256i *)(gen->eg_gen + i), nextStage);
+	_mm256_storeu_si256((__m256i *)(gen->pg_reset + i), reset);
+}
+
+/**
+ * Run the phase generators of eight slots, see OPL3_PhaseGenerate for the
+ * scalar version. Returns the phase outputs, as 32-bit values.
+ */
+static FORCEINLINE __m256i phaseGenerate(opl3_slotgen *gen, int i, __m256i reset, int vibShift, bool vibNegate) {
+	__m256i fnum = _mm256_loadu_si256((const __m256i *)(gen->pg_fnum + i));
+	if (vibShift >= 0) {
+		const __m256i range = _mm256_srl_epi32(_mm256_loadu_si256((const __m256i *)(gen->pg_vib + i)), _mm_cvtsi32_si128(vibShift));
+		fnum = vibNegate ? _mm256_sub_epi32(fnum, range) : _mm256_add_epi32(fnum, range);
+	}
+
+	const __m256i half = _mm256_loadu_si256((const __m256i *)(gen->pg_half + i));
+	const __m256i basefreq = _mm256_or_si256(_mm256_and_si256(half, _mm256_srli_epi32(fnum, 1)), _mm256_andnot_si256(half, fnum));
+	// Both factors fit in 15 bits, so a multiply-add of the low halves
+	// gives the 32-bit product
+	const __m256i inc = _mm256_srli_epi32(_mm256_madd_epi16(basefreq, _mm256_loadu_si256((const __m256i *)(gen->pg_mult + i))), 1);
+
+	const __m256i phase = _mm256_loadu_si256((const __m256i *)(gen->pg_phase + i));
+	_mm256_storeu_si256((__m256i *)(gen->pg_phase + i), _mm256_add_epi32(_mm256_andnot_si256(reset, phase), inc));
+
+	// Sign extend the low 16 bits, so that they survive the signed packing
+	return _mm256_srai_epi32(_mm256_slli_epi32(_mm256_srli_epi32(phase, 9), 16), 16);
+}
+
+void OPL3_SlotGenCalcAVX2(opl3_chip *chip) {
+	opl3_slotgen *gen = &chip->slotgen;
+
+	// Rates with a low part above the threshold step one more time,
+	// see eg_incstep
+	static const int16 incThresholds[4] = { 0, 2, 1, 3 };
+	const __m256i incThreshold = _mm256_set1_epi16(incThresholds[chip->eg_timer_lo]);
+
+	int vibShift = -1;
+	if (chip->vibpos & 3)
+		vibShift = (chip->vibpos & 1) + chip->vibshift;
+	const bool vibNegate = (chip->vibpos & 4) != 0;
+
+	for (int i = 0; i < 36; i += 16) {
+		envelopeCalc(chip, gen, i, incThreshold);
+
+		const __m256i reset = _mm256_loadu_si256((const __m256i *)(gen->pg_reset + i));
+		const __m256i out0 = phaseGenerate(gen, i,     _mm256_cvtepi16_epi32(_mm256_castsi256_si128(reset)), vibShift, vibNegate);
+		const __m256i out1 = phaseGenerate(gen, i + 8, _mm256_cvtepi16_epi32(_mm256_extracti128_si256(reset, 1)), vibShift, vibNegate);
+		// Packing works within the 128-bit lanes, so put the slots back in order
+		const __m256i out = _mm256_permute4x64_epi64(_mm256_packs_epi32(out0, out1), _MM_SHUFFLE(3, 1, 2, 0));
+		_mm256_storeu_si256((__m256i *)(gen->pg_phase_out + i), out);
+	}
+}
+
+} // End of namespace NUKED
+} // End of namespace OPL
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !DISABLE_NUKED_OPL
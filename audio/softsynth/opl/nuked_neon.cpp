@@ -0,0 +1,184 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+
+#include "audio/softsynth/opl/nuked.h"
+
+#ifndef DISABLE_NUKED_OPL
+
+#include <arm_neon.h>
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("neon"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+namespace OPL {
+namespace NUKED {
+
+/**
+ * Run the envelope generators of eight slots, see OPL3_EnvelopeCalc for
+ * the scalar version.
+ */
+static FORCEINLINE void envelopeCalc(opl3_chip *chip, opl3_slotgen *gen, int i, uint16x8_t incThreshold) {
+	const uint16x8_t one = vdupq_n_u16(1);
+	const uint16x8_t three = vdupq_n_u16(3);
+
+	const uint16x8_t rout = vld1q_u16(gen->eg_rout + i);
+	const uint16x8_t stage = vld1q_u16(gen->eg_gen + i);
+	const uint16x8_t key = vld1q_u16(gen->eg_key + i);
+
+	const uint16x8_t trem = vandq_u16(vld1q_u16(gen->eg_trem + i), vdupq_n_u16(chip->tremolo));
+	vst1q_u16(gen->eg_out + i, vaddq_u16(vaddq_u16(rout, vld1q_u16(gen->eg_base + i)), trem));
+
+	const uint16x8_t attack = vceqq_u16(stage, vdupq_n_u16(0));
+	const uint16x8_t decay = vceqq_u16(stage, one);
+	const uint16x8_t sustain = vceqq_u16(stage, vdupq_n_u16(2));
+	const uint16x8_t release = vceqq_u16(stage, three);
+	const uint16x8_t reset = vandq_u16(key, release);
+
+	const uint16x8_t attackRate = vld1q_u16(gen->eg_rate[0] + i);
+	uint16x8_t rate = vandq_u16(attack, attackRate);
+	rate = vorrq_u16(rate, vandq_u16(decay, vld1q_u16(gen->eg_rate[1] + i)));
+	rate = vorrq_u16(rate, vandq_u16(sustain, vld1q_u16(gen->eg_rate[2] + i)));
+	rate = vorrq_u16(rate, vandq_u16(release, vld1q_u16(gen->eg_rate[3] + i)));
+	rate = vbslq_u16(reset, attackRate, rate);
+
+	const uint16x8_t rateHi = vshrq_n_u16(rate, 2);
+	const uint16x8_t rateLo = vandq_u16(rate, three);
+	const uint16x8_t nonzero = vtstq_u16(rate, rate);
+	const uint16x8_t rateMax = vceqq_u16(rateHi, vdupq_n_u16(0x0f));
+
+	// Shift for the rates below 12, which only step on every other sample
+	uint16x8_t shiftLow = vdupq_n_u16(0);
+	if (chip->eg_state) {
+		const uint16x8_t egShift = vaddq_u16(rateHi, vdupq_n_u16(chip->eg_add));
+		shiftLow = vandq_u16(vceqq_u16(egShift, vdupq_n_u16(12)), one);
+		shiftLow = vorrq_u16(shiftLow, vandq_u16(vceqq_u16(egShift, vdupq_n_u16(13)), vshrq_n_u16(rateLo, 1)));
+		shiftLow = vorrq_u16(shiftLow, vandq_u16(vceqq_u16(egShift, vdupq_n_u16(14)), vandq_u16(rateLo, one)));
+	}
+
+	// Shift for the higher rates
+	uint16x8_t shiftHigh = vaddq_u16(vandq_u16(rateHi, three), vandq_u16(vcgtq_u16(rateLo, incThreshold), one));
+	shiftHigh = vminq_u16(shiftHigh, three);
+	shiftHigh = vorrq_u16(shiftHigh, vandq_u16(vceqq_u16(shiftHigh, vdupq_n_u16(0)), vdupq_n_u16(chip->eg_state)));
+
+	const uint16x8_t isLow = vcltq_u16(rateHi, vdupq_n_u16(12));
+	const uint16x8_t shift = vandq_u16(vbslq_u16(isLow, shiftLow, shiftHigh), nonzero);
+
+	// Instant attack, and envelope off
+	const uint16x8_t egOff = vceqq_u16(vandq_u16(rout, vdupq_n_u16(0x1f8)), vdupq_n_u16(0x1f8));
+	uint16x8_t base = vbicq_u16(rout, vandq_u16(reset, rateMax));
+	base = vorrq_u16(base, vandq_u16(vbicq_u16(egOff, vorrq_u16(attack, reset)), vdupq_n_u16(0x1ff)));
+
+	// Attack increment, ~rout >> (4 - shift)
+	const int16x8_t notRout = vreinterpretq_s16_u16(vmvnq_u16(rout));
+	uint16x8_t attackInc = vandq_u16(vceqq_u16(shift, one), vreinterpretq_u16_s16(vshrq_n_s16(notRout, 3)));
+	attackInc = vorrq_u16(attackInc, vandq_u16(vceqq_u16(shift, vdupq_n_u16(2)), vreinterpretq_u16_s16(vshrq_n_s16(notRout, 2))));
+	attackInc = vorrq_u16(attackInc, vandq_u16(vceqq_u16(shift, three), vreinterpretq_u16_s16(vshrq_n_s16(notRout, 1))));
+	const uint16x8_t routZero = vceqq_u16(rout, vdupq_n_u16(0));
+	const uint16x8_t attackCond = vbicq_u16(vandq_u16(attack, key), vorrq_u16(routZero, rateMax));
+
+	// Decay, sustain and release increment, 1 << (shift - 1)
+	const uint16x8_t linearInc = vaddq_u16(shift, vandq_u16(vceqq_u16(shift, three), one));
+	const uint16x8_t sustainLevel = vceqq_u16(vshrq_n_u16(rout, 4), vld1q_u16(gen->eg_sl + i));
+	const uint16x8_t decayDone = vandq_u16(decay, sustainLevel);
+	const uint16x8_t linearCond = vmvnq_u16(vorrq_u16(vorrq_u16(attack, egOff), vorrq_u16(reset, decayDone)));
+
+	const uint16x8_t inc = vorrq_u16(vandq_u16(attackCond, attackInc), vandq_u16(linearCond, linearInc));
+	vst1q_u16(gen->eg_rout + i, vandq_u16(vaddq_u16(base, inc), vdupq_n_u16(0x1ff)));
+
+	// Next stage
+	uint16x8_t nextStage = vaddq_u16(stage, vandq_u16(vandq_u16(attack, routZero), one));
+	nextStage = vaddq_u16(nextStage, vandq_u16(decayDone, one));
+	nextStage = vbicq_u16(nextStage, reset);
+	nextStage = vorrq_u16(nextStage, vbicq_u16(three, key));
+	vst1q_u16(gen->eg_gen + i, nextStage);
+	vst1q_u16(gen->pg_reset + i, reset);
+}
+
+/**
+ * Run the phase generators of four slots, see OPL3_PhaseGenerate for the
+ * scalar version. Returns the phase outputs.
+ */
+static FORCEINLINE uint16x4_t phaseGenerate(opl3_slotgen *gen, int i, uint32x4_t reset, int vibShift, bool vibNegate) {
+	uint32x4_t fnum = vld1q_u32(gen->pg_fnum + i);
+	if (vibShift >= 0) {
+		const uint32x4_t range = vshlq_u32(vld1q_u32(gen->pg_vib + i), vdupq_n_s32(-vibShift));
+		fnum = vibNegate ? vsubq_u32(fnum, range) : vaddq_u32(fnum, range);
+	}
+
+	const uint32x4_t basefreq = vbslq_u32(vld1q_u32(gen->pg_half + i), vshrq_n_u32(fnum, 1), fnum);
+	const uint32x4_t inc = vshrq_n_u32(vmulq_u32(basefreq, vld1q_u32(gen->pg_mult + i)), 1);
+
+	const uint32x4_t phase = vld1q_u32(gen->pg_phase + i);
+	vst1q_u32(gen->pg_phase + i, vaddq_u32(vbicq_u32(phase, reset), inc));
+
+	return vmovn_u32(vshrq_n_u32(phase, 9));
+}
+
+void OPL3_SlotGenCalcNEON(opl3_chip *chip) {
+	opl3_slotgen *gen = &chip->slotgen;
+
+	// Rates with a low part above the threshold step one more time,
+	// see eg_incstep
+	static const uint16 incThresholds[4] = { 0, 2, 1, 3 };
+	const uint16x8_t incThreshold = vdupq_n_u16(incThresholds[chip->eg_timer_lo]);
+
+	int vibShift = -1;
+	if (chip->vibpos & 3)
+		vibShift = (chip->vibpos & 1) + chip->vibshift;
+	const bool vibNegate = (chip->vibpos & 4) != 0;
+
+	for (int i = 0; i < 36; i += 8) {
+		envelopeCalc(chip, gen, i, incThreshold);
+
+		const int16x8_t reset = vreinterpretq_s16_u16(vld1q_u16(gen->pg_reset + i));
+		const uint16x4_t out0 = phaseGenerate(gen, i,     vreinterpretq_u32_s32(vmovl_s16(vget_low_s16(reset))), vibShift, vibNegate);
+		const uint16x4_t out1 = phaseGenerate(gen, i + 4, vreinterpretq_u32_s32(vmovl_s16(vget_high_s16(reset))), vibShift, vibNegate);
+		vst1q_u16(gen->pg_phase_out + i, vcombine_u16(out0, out1));
+	}
+}
+
+} // End of namespace NUKED
+} // End of namespace OPL
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#endif // !DISABLE_NUKED_OPL
+
+#endif // SCUMMVM_NEON
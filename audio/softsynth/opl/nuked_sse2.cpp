@@ -0,0 +1,187 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "common/scummsys.h"
+
+#include "audio/softsynth/opl/nuked.h"
+
+#ifndef DISABLE_NUKED_OPL
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace OPL {
+namespace NUKED {
+
+/**
+ * Run the envelope generators of eight slots, see OPL3_EnvelopeCalc for
+ * the scalar version.
+ */
+static FORCEINLINE void envelopeCalc(opl3_chip *chip, opl3_slotgen *gen, int i, __m128i incThreshold) {
+	const __m128i one = _mm_set1_epi16(1);
+	const __m128i three = _mm_set1_epi16(3);
+	const __m128i ones = _mm_set1_epi16(-1);
+
+	const __m128i rout = _mm_loadu_si128((const __m128i *)(gen->eg_rout + i));
+	const __m128i stage = _mm_loadu_si128((const __m128i *)(gen->eg_gen + i));
+	const __m128i key = _mm_loadu_si128((const __m128i *)(gen->eg_key + i));
+
+	const __m128i trem = _mm_and_si128(_mm_loadu_si128((const __m128i *)(gen->eg_trem + i)), _mm_set1_epi16(chip->tremolo));
+	const __m128i out = _mm_add_epi16(_mm_add_epi16(rout, _mm_loadu_si128((const __m128i *)(gen->eg_base + i))), trem);
+	_mm_storeu_si128((__m128i *)(gen->eg_out + i), out);
+
+	const __m128i attack = _mm_cmpeq_epi16(stage, _mm_setzero_si128());
+	const __m128i decay = _mm_cmpeq_epi16(stage, one);
+	const __m128i sustain = _mm_cmpeq_epi16(stage, _mm_set1_epi16(2));
+	const __m128i release = _mm_cmpeq_epi16(stage, three);
+	const __m128i reset = _mm_and_si128(key, release);
+
+	const __m128i attackRate = _mm_loadu_si128((const __m128i *)(gen->eg_rate[0] + i));
+	__m128i rate = _mm_and_si128(attack, attackRate);
+	rate = _mm_or_si128(rate, _mm_and_si128(decay, _mm_loadu_si128((const __m128i *)(gen->eg_rate[1] + i))));
+	rate = _mm_or_si128(rate, _mm_and_si128(sustain, _mm_loadu_si128((const __m128i *)(gen->eg_rate[2] + i))));
+	rate = _mm_or_si128(rate, _mm_and_si128(release, _mm_loadu_si128((const __m128i *)(gen->eg_rate[3] + i))));
+	rate = _mm_or_si128(_mm_and_si128(reset, attackRate), _mm_andnot_si128(reset, rate));
+
+	const __m128i rateHi = _mm_srli_epi16(rate, 2);
+	const __m128i rateLo = _mm_and_si128(rate, three);
+	const __m128i nonzero = _mm_xor_si128(_mm_cmpeq_epi16(rate, _mm_setzero_si128()), ones);
+	const __m128i rateMax = _mm_cmpeq_epi16(rateHi, _mm_set1_epi16(0x0f));
+
+	// Shift for the rates below 12, which only step on every other sample
+	__m128i shiftLow = _mm_setzero_si128();
+	if (chip->eg_state) {
+		const __m128i egShift = _mm_add_epi16(rateHi, _mm_set1_epi16(chip->eg_add));
+		shiftLow = _mm_and_si128(_mm_cmpeq_epi16(egShift, _mm_set1_epi16(12)), one);
+		shiftLow = _mm_or_si128(shiftLow, _mm_and_si128(_mm_cmpeq_epi16(egShift, _mm_set1_epi16(13)), _mm_srli_epi16(rateLo, 1)));
+		shiftLow = _mm_or_si128(shiftLow, _mm_and_si128(_mm_cmpeq_epi16(egShift, _mm_set1_epi16(14)), _mm_and_si128(rateLo, one)));
+	}
+
+	// Shift for the higher rates
+	__m128i shiftHigh = _mm_add_epi16(_mm_and_si128(rateHi, three), _mm_and_si128(_mm_cmpgt_epi16(rateLo, incThreshold), one));
+	shiftHigh = _mm_min_epi16(shiftHigh, three);
+	shiftHigh = _mm_or_si128(shiftHigh, _mm_and_si128(_mm_cmpeq_epi16(shiftHigh, _mm_setzero_si128()), _mm_set1_epi16(chip->eg_state)));
+
+	const __m128i isLow = _mm_cmplt_epi16(rateHi, _mm_set1_epi16(12));
+	__m128i shift = _mm_or_si128(_mm_and_si128(isLow, shiftLow), _mm_andnot_si128(isLow, shiftHigh));
+	shift = _mm_and_si128(shift, nonzero);
+
+	// Instant attack, and envelope off
+	const __m128i egOff = _mm_cmpeq_epi16(_mm_and_si128(rout, _mm_set1_epi16(0x1f8)), _mm_set1_epi16(0x1f8));
+	__m128i base = _mm_andnot_si128(_mm_and_si128(reset, rateMax), rout);
+	base = _mm_or_si128(base, _mm_and_si128(_mm_andnot_si128(_mm_or_si128(attack, reset), egOff), _mm_set1_epi16(0x1ff)));
+
+	// Attack increment, ~rout >> (4 - shift)
+	const __m128i notRout = _mm_xor_si128(rout, ones);
+	__m128i attackInc = _mm_and_si128(_mm_cmpeq_epi16(shift, one), _mm_srai_epi16(notRout, 3));
+	attackInc = _mm_or_si128(attackInc, _mm_and_si128(_mm_cmpeq_epi16(shift, _mm_set1_epi16(2)), _mm_srai_epi16(notRout, 2)));
+	attackInc = _mm_or_si128(attackInc, _mm_and_si128(_mm_cmpeq_epi16(shift, three), _mm_srai_epi16(notRout, 1)));
+	const __m128i routZero = _mm_cmpeq_epi16(rout, _mm_setzero_si128());
+	const __m128i attackCond = _mm_andnot_si128(_mm_or_si128(routZero, rateMax), _mm_and_si128(attack, key));
+
+	// Decay, sustain and release increment, 1 << (shift - 1)
+	const __m128i linearInc = _mm_add_epi16(shift, _mm_and_si128(_mm_cmpeq_epi16(shift, three), one));
+	const __m128i sustainLevel = _mm_cmpeq_epi16(_mm_srli_epi16(rout, 4), _mm_loadu_si128((const __m128i *)(gen->eg_sl + i)));
+	const __m128i decayDone = _mm_and_si128(decay, sustainLevel);
+	const __m128i linearCond = _mm_xor_si128(_mm_or_si128(_mm_or_si128(attack, egOff), _mm_or_si128(reset, decayDone)), ones);
+
+	const __m128i inc = _mm_or_si128(_mm_and_si128(attackCond, attackInc), _mm_and_si128(linearCond, linearInc));
+	_mm_storeu_si128((__m128i *)(gen->eg_rout + i), _mm_and_si128(_mm_add_epi16(base, inc), _mm_set1_epi16(0x1ff)));
+
+	// Next stage
+	__m128i nextStage = _mm_add_epi16(stage, _mm_and_si128(_mm_and_si128(attack, routZero), one));
+	nextStage = _mm_add_epi16(nextStage, _mm_and_si128(decayDone, one));
+	nextStage = _mm_andnot_si128(reset, nextStage);
+	nextStage = _mm_or_si128(nextStage, _mm_andnot_si128(key, three));
+	_mm_storeu_si128((__m128i *)(gen->eg_gen + i), nextStage);
+	_mm_storeu_si128((__m128i *)(gen->pg_reset + i), reset);
+}
+
+/**
+ * Run the phase generators of four slots, see OPL3_PhaseGenerate for the
+ * scalar version. Returns the phase outputs, as 32-bit values.
+ */
+static FORCEINLINE __m128i phaseGenerate(opl3_slotgen *gen, int i, __m128i reset, int vibShift, bool vibNegate) {
+	__m128i fnum = _mm_loadu_si128((const __m128i *)(gen->pg_fnum + i));
+	if (vibShift >= 0) {
+		const __m128i range = _mm_srl_epi32(_mm_loadu_si128((const __m128i *)(gen->pg_vib + i)), _mm_cvtsi32_si128(vibShift));
+		fnum = vibNegate ? _mm_sub_epi32(fnum, range) : _mm_add_epi32(fnum, range);
+	}
+
+	const __m128i half = _mm_loadu_si128((const __m128i *)(gen->pg_half + i));
+	const __m128i basefreq = _mm_or_si128(_mm_and_si128(half, _mm_srli_epi32(fnum, 1)), _mm_andnot_si128(half, fnum));
+	// Both factors fit in 15 bits, so a multiply-add of the low halves
+	// gives the 32-bit product
+	const __m128i inc = _mm_srli_epi32(_mm_madd_epi16(basefreq, _mm_loadu_si128((const __m128i *)(gen->pg_mult + i))), 1);
+
+	const __m128i phase = _mm_loadu_si128((const __m128i *)(gen->pg_phase + i));
+	_mm_storeu_si128((__m128i *)(gen->pg_phase + i), _mm_add_epi32(_mm_andnot_si128(reset, phase), inc));
+
+	// Sign extend the low 16 bits, so that they survive the signed packing
+	return _mm_srai_epi32(_mm_slli_epi32(_mm_srli_epi32(phase, 9), 16), 16);
+}
+
+void OPL3_SlotGenCalcSSE2(opl3_chip *chip) {
+	opl3_slotgen *gen = &chip->slotgen;
+
+	// Rates with a low part above the threshold step one more time,
+	// see eg_incstep
+	static const int16 incThresholds[4] = { 0, 2, 1, 3 };
+	const __m128i incThreshold = _mm_set1_epi16(incThresholds[chip->eg_timer_lo]);
+
+	int vibShift = -1;
+	if (chip->vibpos & 3)
+		vibShift = (chip->vibpos & 1) + chip->vibshift;
+	const bool vibNegate = (chip->vibpos & 4) != 0;
+
+	for (int i = 0; i < 36; i += 8) {
+		envelopeCalc(chip, gen, i, incThreshold);
+
+		const __m128i reset = _mm_loadu_si128((const __m128i *)(gen->pg_reset + i));
+		const __m128i out0 = phaseGenerate(gen, i,     _mm_unpacklo_epi16(reset, reset), vibShift, vibNegate);
+		const __m128i out1 = phaseGenerate(gen, i + 4, _mm_unpackhi_epi16(reset, reset), vibShift, vibNegate);
+		_mm_storeu_si128((__m128i *)(gen->pg_phase_out + i), _mm_packs_epi32(out0, out1));
+	}
+}
+
+} // End of namespace NUKED
+} // End of namespace OPL
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
+
+#endif // !DISABLE_NUKED_OPL
@@ -192,6 +192,26 @@ public:
 	 */
 	virtual Common::SeekableReadStream *createReadStreamForAltStream(Common::AltStreamType altStreamType);
 
+	/**
+	 * Creates a MemoryReadStream instance whose data is the file referred by
+	 * this node mapped into memory, without copying it. This assumes that
+	 * the node actually refers to a readable file. If this is not the case,
+	 * if the backend cannot map files, or if the file is too large to be
+	 * mapped, 0 is returned.
+	 *
+	 * @return pointer to the stream object, 0 in case of a failure
+	 */
+	virtual Common::MemoryReadStream *createMappedReadStream();
+
+	/**
+	 * Retrieves the size and the time of the last modification of the file
+	 * referred by this node, without opening it. The modification time is
+	 * only meant to be compared with another one of the same file.
+	 *
+	 * @return true if the backend could retrieve both, false otherwise
+	 */
+	virtual bool getSizeAndModificationTime(int64 &size, int64 &modificationTime) const;
+
 	/**
 	 * Creates a WriteStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
@@ -34,6 +34,7 @@
 #include "backends/fs/posix/posix-fs.h"
 #include "backends/fs/posix/posix-iostream.h"
 #include "common/algorithm.h"
+#include "common/memstream.h"
 
 #include <sys/param.h>
 #include <sys/stat.h>
@@ -49,6 +50,10 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <unistd.h>
+#if defined(_POSIX_MAPPED_FILES) && _POSIX_MAPPED_FILES > 0
+#include <sys/mman.h>
+#define POSIX_FS_USE_MMAP
+#endif
 
 #ifdef __OS2__
 #define INCL_DOS
@@ -290,6 +295,60 @@ Common::SeekableReadStream *POSIXFilesystemNode::createReadStreamForAltStream(Co
 	return nullptr;
 }
 
+#ifdef POSIX_FS_USE_MMAP
+/**
+ * A memory stream over a read-only file mapping, which is unmapped when
+ * the stream is deleted.
+ */
+class PosixMappedReadStream final : public Common::MemoryReadStream {
+public:
+	PosixMappedReadStream(void *mapping, uint32 size) :
+		Common::MemoryReadStream((const byte *)mapping, size, DisposeAfterUse::NO), _mapping(mapping), _mappingSize(size) {}
+	~PosixMappedReadStream() override { munmap(_mapping, _mappingSize); }
+
+private:
+	void *_mapping;
+	size_t _mappingSize;
+};
+#endif
+
+Common::MemoryReadStream *POSIXFilesystemNode::createMappedReadStream() {
+#ifdef POSIX_FS_USE_MMAP
+	int fd = open(_path.c_str(), O_RDONLY);
+	if (fd == -1)
+		return nullptr;
+
+	// Empty files cannot be mapped, and memory streams are limited to 4GB.
+	// With a 32 bit address space, mapping a large file may take most of
+	// the room left for allocations, so such files are read as usual.
+	const uint64 maxSize = sizeof(void *) == 4 ? 256 * 1024 * 1024 : 0xFFFFFFFF;
+	struct stat st;
+	void *mapping = MAP_FAILED;
+	if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 && (uint64)st.st_size <= maxSize)
+		mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+	// The mapping stays valid after the file is closed
+	close(fd);
+
+	if (mapping == MAP_FAILED)
+		return nullptr;
+
+	return new PosixMappedReadStream(mapping, st.st_size);
+#else
+	return nullptr;
+#endif
+}
+
+bool POSIXFilesystemNode::getSizeAndModificationTime(int64 &size, int64 &modificationTime) const {
+	struct stat st;
+	if (stat(_path.c_str(), &st) != 0 || !S_ISREG(st.st_mode))
+		return false;
+
+	size = st.st_size;
+	modificationTime = st.st_mtime;
+	return true;
+}
+
 Common::SeekableWriteStream *POSIXFilesystemNode::createWriteStream(bool atomic) {
 	return PosixIoStream::makeFromPath(getPath(), atomic ?
 			StdioStream::WriteMode_WriteAtomic : StdioStream::WriteMode_Write);
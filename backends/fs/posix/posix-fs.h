@@ -67,6 +67,8 @@ public:
 
 	Common::SeekableReadStream *createReadStream() override;
 	Common::SeekableReadStream *createReadStreamForAltStream(Common::AltStreamType altStreamType) override;
+	Common::MemoryReadStream *createMappedReadStream() override;
+	bool getSizeAndModificationTime(int64 &size, int64 &modificationTime) const override;
 	Common::SeekableWriteStream *createWriteStream(bool atomic) override;
 	bool createDirectory() override;
 
@@ -24,6 +24,7 @@
 
 #include "backends/graphics/graphics.h"
 #include "backends/graphics/sdl/sdl-graphics.h"
+#include "backends/graphics/surfacesdl/surfacesdl-scalerpool.h"
 #include "graphics/pixelformat.h"
 #include "graphics/scaler.h"
 #include "graphics/scalerplugin.h"
@@ -343,6 +344,7 @@ protected:
 	const PluginList &_scalerPlugins;
 	ScalerPluginObject *_scalerPlugin;
 	Scaler *_scaler, *_mouseScaler;
+	SdlScalerPool *_scalerPool;
 	uint _maxExtraPixels;
 	uint _extraPixels;
 
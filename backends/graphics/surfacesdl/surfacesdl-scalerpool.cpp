@@ -0,0 +1,159 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#if defined(SDL_BACKEND)
+
+#include "backends/graphics/surfacesdl/surfacesdl-scalerpool.h"
+
+#if SDL_VERSION_ATLEAST(3, 0, 0)
+#define SDL_SemWait SDL_WaitSemaphore
+#define SDL_SemPost SDL_SignalSemaphore
+#endif
+
+SdlScalerPool::SdlScalerPool(uint numWorkers) : _numWorkers(0), _quit(false), _done(nullptr), _plugin(nullptr) {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	numWorkers = MIN<uint>(numWorkers, kMaxWorkers);
+	if (!numWorkers)
+		return;
+
+	_done = SDL_CreateSemaphore(0);
+	if (!_done)
+		return;
+
+	for (uint i = 0; i < numWorkers; ++i) {
+		Worker &worker = _workers[_numWorkers];
+		worker.pool = this;
+		worker.scaler = nullptr;
+		worker.start = SDL_CreateSemaphore(0);
+		if (!worker.start)
+			break;
+
+		worker.thread = SDL_CreateThread(workerMain, "ScummVM scaler", &worker);
+		if (!worker.thread) {
+			SDL_DestroySemaphore(worker.start);
+			break;
+		}
+
+		++_numWorkers;
+	}
+#endif
+}
+
+SdlScalerPool::~SdlScalerPool() {
+	_quit = true;
+	for (uint i = 0; i < _numWorkers; ++i) {
+		SDL_SemPost(_workers[i].start);
+		SDL_WaitThread(_workers[i].thread, nullptr);
+		SDL_DestroySemaphore(_workers[i].start);
+	}
+
+	destroyScalers();
+
+	if (_done)
+		SDL_DestroySemaphore(_done);
+}
+
+uint SdlScalerPool::getDefaultWorkerCount() {
+#if SDL_VERSION_ATLEAST(3, 0, 0)
+	const int numCPUs = SDL_GetNumLogicalCPUCores();
+#elif SDL_VERSION_ATLEAST(2, 0, 0)
+	const int numCPUs = SDL_GetCPUCount();
+#else
+	const int numCPUs = 1;
+#endif
+	return numCPUs > 1 ? numCPUs - 1 : 0;
+}
+
+void SdlScalerPool::setScaler(const ScalerPluginObject *plugin, const Graphics::PixelFormat &format) {
+	if (plugin == _plugin && format == _format)
+		return;
+
+	destroyScalers();
+	_plugin = plugin;
+	_format = format;
+}
+
+void SdlScalerPool::destroyScalers() {
+	for (uint i = 0; i < _numWorkers; ++i) {
+		delete _workers[i].scaler;
+		_workers[i].scaler = nullptr;
+	}
+}
+
+void SdlScalerPool::scale(Scaler *scaler, const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr,
+                          uint32 dstPitch, int width, int height, int x, int y) {
+	const uint factor = scaler->getFactor();
+	const uint numBands = MIN<uint>(_numWorkers + 1, height / kMinBandHeight);
+
+	if (numBands < 2 || factor == 1 || !_plugin || _plugin->useOldSource()) {
+		scaler->scale(srcPtr, srcPitch, dstPtr, dstPitch, width, height, x, y);
+		return;
+	}
+
+	// Hand out the bands at the bottom to the workers, and keep the top one
+	const int bandHeight = height / numBands;
+	int bandY = height;
+	for (uint i = 0; i < numBands - 1; ++i) {
+		Worker &worker = _workers[i];
+		const int rows = (i == 0) ? height - bandHeight * (numBands - 1) : bandHeight;
+		bandY -= rows;
+
+		if (!worker.scaler)
+			worker.scaler = _plugin->createInstance(_format);
+		worker.scaler->setFactor(factor);
+
+		worker.srcPtr = srcPtr + bandY * srcPitch;
+		worker.srcPitch = srcPitch;
+		worker.dstPtr = dstPtr + bandY * factor * dstPitch;
+		worker.dstPitch = dstPitch;
+		worker.width = width;
+		worker.height = rows;
+		worker.x = x;
+		worker.y = y + bandY;
+		SDL_SemPost(worker.start);
+	}
+
+	scaler->scale(srcPtr, srcPitch, dstPtr, dstPitch, width, bandY, x, y);
+
+	for (uint i = 0; i < numBands - 1; ++i)
+		SDL_SemWait(_done);
+}
+
+int SDLCALL SdlScalerPool::workerMain(void *data) {
+	Worker &worker = *(Worker *)data;
+	SdlScalerPool &pool = *worker.pool;
+
+	for (;;) {
+		SDL_SemWait(worker.start);
+		if (pool._quit)
+			break;
+
+		worker.scaler->scale(worker.srcPtr, worker.srcPitch, worker.dstPtr, worker.dstPitch,
+		                     worker.width, worker.height, worker.x, worker.y);
+		SDL_SemPost(pool._done);
+	}
+
+	return 0;
+}
+
+#endif
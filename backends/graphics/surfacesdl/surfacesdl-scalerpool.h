@@ -0,0 +1,114 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef BACKENDS_GRAPHICS_SURFACESDL_SCALERPOOL_H
+#define BACKENDS_GRAPHICS_SURFACESDL_SCALERPOOL_H
+
+#include "backends/platform/sdl/sdl-sys.h"
+#include "graphics/pixelformat.h"
+#include "graphics/scalerplugin.h"
+
+/**
+ * Scales large rects by splitting them into horizontal bands which are
+ * processed in parallel by a set of persistent worker threads.
+ *
+ * Every worker owns its own instance of the current scaler, since scalers
+ * may keep scratch buffers. The bands read the rows around them straight
+ * from the source surface, so they need no copying, and write to disjoint
+ * rows of the destination surface.
+ *
+ * Scalers relying on the old source (see ScalerPluginObject::useOldSource)
+ * keep state about the whole screen and are always run on the calling
+ * thread.
+ */
+class SdlScalerPool {
+public:
+	/**
+	 * @param numWorkers The number of worker threads to start. Pass 0 to
+	 *                   disable the pool.
+	 */
+	SdlScalerPool(uint numWorkers);
+	~SdlScalerPool();
+
+	/**
+	 * Returns the number of worker threads to use by default, one less than
+	 * the number of CPUs since the calling thread scales a band itself.
+	 */
+	static uint getDefaultWorkerCount();
+
+	/**
+	 * Set the scaler plugin and pixel format to create the worker scalers
+	 * with. This must be called whenever the main scaler is recreated.
+	 */
+	void setScaler(const ScalerPluginObject *plugin, const Graphics::PixelFormat &format);
+
+	/**
+	 * Scale a rect with the given main scaler, splitting it between the
+	 * calling thread and the workers if it is large enough.
+	 *
+	 * @see Scaler::scale
+	 */
+	void scale(Scaler *scaler, const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr,
+	           uint32 dstPitch, int width, int height, int x, int y);
+
+private:
+	enum {
+		/** The minimum number of source rows in a band. */
+		kMinBandHeight = 16,
+		/** The maximum number of threads. */
+		kMaxWorkers = 15
+	};
+
+	struct Worker {
+		SdlScalerPool *pool;
+		SDL_Thread *thread;
+#if SDL_VERSION_ATLEAST(3, 0, 0)
+		SDL_Semaphore *start;
+#else
+		SDL_sem *start;
+#endif
+		Scaler *scaler;
+
+		const uint8 *srcPtr;
+		uint32 srcPitch;
+		uint8 *dstPtr;
+		uint32 dstPitch;
+		int width, height, x, y;
+	};
+
+	static int SDLCALL workerMain(void *data);
+
+	void destroyScalers();
+
+	Worker _workers[kMaxWorkers];
+	uint _numWorkers;
+	bool _quit;
+#if SDL_VERSION_ATLEAST(3, 0, 0)
+	SDL_Semaphore *_done;
+#else
+	SDL_sem *_done;
+#endif
+
+	const ScalerPluginObject *_plugin;
+	Graphics::PixelFormat _format;
+};
+
+#endif
@@ -316,6 +316,7 @@ void registerDefaults() {
 	ConfMan.registerDefault("sfx_mute", false);
 	ConfMan.registerDefault("speech_mute", false);
 	ConfMan.registerDefault("mute", false);
+	ConfMan.registerDefault("sinc_resampler", false);
 
 	ConfMan.registerDefault("multi_midi", false);
 	ConfMan.registerDefault("native_mt32", false);
@@ -1548,6 +1549,7 @@ static Common::String detectGames(const Common::Path &path, const Common::String
 	//Current directory
 	Common::FSNode dir(path);
 	DetectedGames candidates = recListGames(dir, engineId, gameId, recursive);
+	ADCacheMan.savePersistentCache(true);
 
 	if (candidates.empty()) {
 		printf("WARNING: ScummVM could not find any game in %s\n", dir.getPath().toString(Common::Path::kNativeSeparator).c_str());
@@ -1691,6 +1693,7 @@ static bool addGames(const Common::Path &path, const Common::String &engineId, c
 	//Current directory
 	Common::FSNode dir(path);
 	int added = recAddGames(dir, engineId, gameId, recursive);
+	ADCacheMan.savePersistentCache(true);
 	printf("Added %d games\n", added);
 	if (added == 0 && !recursive) {
 		printf("Consider using --recursive to search inside subdirectories\n");
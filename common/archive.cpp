@@ -244,6 +244,25 @@ SeekableReadStream *MemcachingCaseInsensitiveArchive::createReadStreamForMemberA
 	return createReadStreamForMemberImpl(path, true, altStreamType);
 }
 
+MemoryReadStream *MemcachingCaseInsensitiveArchive::createMappedReadStreamForMember(const Path &path) const {
+	CacheKey cacheKey;
+	cacheKey.path = translatePath(path);
+
+	// Only contents which are still cached are returned, so that asking
+	// does not read in the member, nor change what the cache holds.
+	auto entry = _cache.find(cacheKey);
+	if (entry == _cache.end() || entry->_value.isFileMissing())
+		return nullptr;
+
+	SharedPtr<byte> contents = entry->_value._strongRef;
+	if (!contents)
+		contents = SharedPtr<byte>(entry->_value._weakRef);
+	if (!contents)
+		return nullptr;
+
+	return new Common::MemoryReadStream(contents, entry->_value.getSize());
+}
+
 SeekableReadStream *MemcachingCaseInsensitiveArchive::createReadStreamForMemberImpl(const Path &path, bool isAltStream, Common::AltStreamType altStreamType) const {
 	CacheKey cacheKey;
 	cacheKey.path = translatePath(path);
@@ -582,6 +601,18 @@ SeekableReadStream *SearchSet::createReadStreamForMember(const Path &path) const
 	return nullptr;
 }
 
+MemoryReadStream *SearchSet::createMappedReadStreamForMember(const Path &path) const {
+	if (path.empty())
+		return nullptr;
+
+	for (const auto &archive : _list) {
+		if (archive._arc->hasFile(path))
+			return archive._arc->createMappedReadStreamForMember(path);
+	}
+
+	return nullptr;
+}
+
 SeekableReadStream *SearchSet::createReadStreamForMemberAltStream(const Path &path, AltStreamType altStreamType) const {
 	if (path.empty())
 		return nullptr;
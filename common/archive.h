@@ -45,6 +45,7 @@ namespace Common {
 
 class ArchiveMember;
 class FSNode;
+class MemoryReadStream;
 class SeekableReadStream;
 
 enum class AltStreamType {
@@ -204,6 +205,21 @@ public:
 		return createReadStreamForMember(path);
 	}
 
+	/**
+	 * Create a memory stream giving direct access to the data of a member
+	 * with the specified name, without copying it if possible, e.g. by
+	 * mapping the file into memory.
+	 *
+	 * This also serves as a capability query: if the archive cannot provide
+	 * the member data in memory, or if no member with this name exists,
+	 * 0 is returned, and createReadStreamForMember should be used instead.
+	 *
+	 * @return The newly created memory stream.
+	 */
+	virtual MemoryReadStream *createMappedReadStreamForMember(const Path &path) const {
+		return nullptr;
+	}
+
 	/**
 	 * Dump all files from the archive to the given directory
 	 */
@@ -290,6 +306,12 @@ public:
 	SeekableReadStream *createReadStreamForMember(const Path &path) const;
 	SeekableReadStream *createReadStreamForMemberAltStream(const Path &path, Common::AltStreamType altStreamType) const;
 
+	/**
+	 * Return the member contents if they are still cached in memory. The
+	 * member is never read by this, so it does not fill the cache either.
+	 */
+	MemoryReadStream *createMappedReadStreamForMember(const Path &path) const override;
+
 	virtual Path translatePath(const Path &path) const {
 		return path.normalize();
 	}
@@ -471,6 +493,13 @@ public:
 	 */
 	SeekableReadStream *createReadStreamForMemberNext(const Path &path, const Archive *starting) const override;
 
+	/**
+	 * Implement createMappedReadStreamForMember from the Archive base class. Only the first
+	 * archive containing a file that matches the name is asked to map it, so that the same
+	 * file as with createReadStreamForMember is returned.
+	 */
+	MemoryReadStream *createMappedReadStreamForMember(const Path &path) const override;
+
 	/**
 	 * Ignore clashes when adding directories. For more details, see the corresponding parameter
 	 * in @ref FSDirectory documentation.
@@ -1126,7 +1126,12 @@ Archive *makeZipArchive(const Path &name, bool flattenTree) {
 }
 
 Archive *makeZipArchive(const FSNode &node, bool flattenTree) {
-	return makeZipArchive(node.createReadStream(), flattenTree);
+	// Map the file if possible, so that reading the members does not need
+	// to go through buffered file reads
+	SeekableReadStream *stream = node.createMappedReadStream();
+	if (!stream)
+		stream = node.createReadStream();
+	return makeZipArchive(stream, flattenTree);
 }
 
 Archive *makeZipArchive(SeekableReadStream *stream, bool flattenTree) {
@@ -0,0 +1,683 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_FLAT_HASHMAP_H
+#define COMMON_FLAT_HASHMAP_H
+
+#include "common/endian.h"
+#include "common/hashmap.h"
+#include "common/intrinsics.h"
+#include "common/util.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_flat_hashmap Flat hash table (FlatHashMap)
+ * @ingroup common
+ *
+ * @brief API for operations on a hash table with inline storage.
+ *
+ * @{
+ */
+
+/**
+ * FlatHashMap<Key,Val> has the same interface as HashMap<Key,Val>, but
+ * stores its nodes inline in a single array instead of allocating them one
+ * by one, so a lookup does not need to follow a pointer to each candidate.
+ *
+ * The slots are grouped by eight. Every slot has a control byte which holds
+ * seven bits of the hash of its key, or marks it as empty or erased, and all
+ * the control bytes of a group are checked at once with bit operations on a
+ * 64 bit word. The full hash of every key is kept as well: keys which are
+ * expensive to hash or to compare, such as strings, are only compared when
+ * their hashes match, and are never hashed again when the map grows.
+ *
+ * Unlike with HashMap, inserting a new key may move the nodes, which
+ * invalidates all references to values and all iterators.
+ */
+template<class Key, class Val, class HashFunc = Hash<Key>, class EqualFunc = EqualTo<Key> >
+class FlatHashMap {
+public:
+	typedef uint size_type;
+
+	typedef typename HashMap<Key, Val, HashFunc, EqualFunc>::Node Node;
+
+private:
+
+	typedef FlatHashMap<Key, Val, HashFunc, EqualFunc> FHM_t;
+
+	enum {
+		FLATHASHMAP_GROUP_SIZE = 8,
+		FLATHASHMAP_MIN_CAPACITY = 16,
+
+		// The quotient of the next two constants controls how much the
+		// internal storage of the hashmap may fill up, erased slots
+		// included, before being rehashed.
+		FLATHASHMAP_LOADFACTOR_NUMERATOR = 7,
+		FLATHASHMAP_LOADFACTOR_DENOMINATOR = 8,
+
+		FLATHASHMAP_CTRL_EMPTY = 0x80,
+		FLATHASHMAP_CTRL_ERASED = 0xFE
+	};
+
+	/** Default value, returned by the const getVal. */
+	Val _defaultVal;
+
+	byte *_ctrl;		///< Control byte of each slot.
+	uint32 *_hashes;	///< Hash of the key in each used slot.
+	Node *_slots;		///< The nodes; only the used slots are constructed.
+	size_type _mask;	///< Capacity of the FlatHashMap minus one; the capacity is a power of two
+	size_type _size;
+	size_type _erased;	///< Number of erased slots
+
+	HashFunc _hash;
+	EqualFunc _equal;
+
+	static uint64 loadGroup(const byte *ctrl) {
+		return READ_LE_UINT64(ctrl);
+	}
+
+	/** Return the top bit of every byte of a group that may equal @p value. */
+	static uint64 matchByte(uint64 group, byte value) {
+		const uint64 x = group ^ (value * 0x0101010101010101ULL);
+		return (x - 0x0101010101010101ULL) & ~x & 0x8080808080808080ULL;
+	}
+
+	/** Return the top bit of every empty slot of a group. */
+	static uint64 matchEmpty(uint64 group) {
+		return group & ~(group << 6) & 0x8080808080808080ULL;
+	}
+
+	/** Return the top bit of every empty or erased slot of a group. */
+	static uint64 matchUnused(uint64 group) {
+		return group & 0x8080808080808080ULL;
+	}
+
+	/** Return the index of the lowest byte with a bit set. */
+	static size_type lowestByte(uint64 bits) {
+#if defined(__GNUC__)
+		return __builtin_ctzll(bits) >> 3;
+#else
+		const uint32 low = (uint32)bits;
+		const uint32 high = (uint32)(bits >> 32);
+		if (low)
+			return intLog2(low & (0 - low)) >> 3;
+		return (32 + intLog2(high & (0 - high))) >> 3;
+#endif
+	}
+
+	/**
+	 * Hash a key. The group comes from the low bits of the hash and the
+	 * control byte from the high bits, so every input bit has to reach both
+	 * ends: hash functions of integer types return consecutive values, and
+	 * keys like (type << 16) | number only differ in their high bits. This
+	 * uses the final mix of MurmurHash3, which is a bijection, so distinct
+	 * hashes stay distinct.
+	 */
+	uint32 hashKey(const Key &key) const {
+		uint32 hash = _hash(key);
+		hash ^= hash >> 16;
+		hash *= 0x85EBCA6BU;
+		hash ^= hash >> 13;
+		hash *= 0xC2B2AE35U;
+		hash ^= hash >> 16;
+		return hash;
+	}
+
+	static byte ctrlForHash(uint32 hash) {
+		return hash >> 25;
+	}
+
+	static bool isUsed(byte ctrl) {
+		return !(ctrl & 0x80);
+	}
+
+	void allocStorage(size_type capacity);
+	void freeStorage();
+	void assign(const FHM_t &map);
+	size_type lookup(const Key &key) const;
+	size_type findUnusedSlot(uint32 hash) const;
+	size_type lookupAndCreateIfMissing(const Key &key);
+	void rehash(size_type newCapacity);
+	void eraseSlot(size_type ctr);
+
+	template<class T> friend class IteratorImpl;
+
+	/**
+	 * Simple FlatHashMap iterator implementation.
+	 */
+	template<class NodeType>
+	class IteratorImpl {
+		friend class FlatHashMap;
+		template<class T> friend class IteratorImpl;
+	protected:
+		typedef const FlatHashMap hashmap_t;
+
+		size_type _idx;
+		hashmap_t *_hashmap;
+
+	protected:
+		IteratorImpl(size_type idx, hashmap_t *hashmap) : _idx(idx), _hashmap(hashmap) {}
+
+		NodeType *deref() const {
+			assert(_hashmap != nullptr);
+			assert(_idx <= _hashmap->_mask);
+			assert(isUsed(_hashmap->_ctrl[_idx]));
+			return &_hashmap->_slots[_idx];
+		}
+
+	public:
+		IteratorImpl() : _idx(0), _hashmap(nullptr) {}
+		template<class T>
+		IteratorImpl(const IteratorImpl<T> &c) : _idx(c._idx), _hashmap(c._hashmap) {}
+
+		NodeType &operator*() const { return *deref(); }
+		NodeType *operator->() const { return deref(); }
+
+		bool operator==(const IteratorImpl &iter) const { return _idx == iter._idx && _hashmap == iter._hashmap; }
+		bool operator!=(const IteratorImpl &iter) const { return !(*this == iter); }
+
+		IteratorImpl &operator++() {
+			assert(_hashmap);
+			_idx = _hashmap->nextUsedSlot(_idx + 1);
+			return *this;
+		}
+
+		IteratorImpl operator++(int) {
+			IteratorImpl old = *this;
+			operator ++();
+			return old;
+		}
+	};
+
+	/** Return the first used slot starting at @p ctr, or -1 if there is none. */
+	size_type nextUsedSlot(size_type ctr) const {
+		for (; ctr <= _mask; ++ctr) {
+			if (isUsed(_ctrl[ctr]))
+				return ctr;
+		}
+		return (size_type)-1;
+	}
+
+public:
+	typedef IteratorImpl<Node> iterator;
+	typedef IteratorImpl<const Node> const_iterator;
+
+	FlatHashMap();
+	FlatHashMap(const FHM_t &map);
+	~FlatHashMap();
+
+	FHM_t &operator=(const FHM_t &map) {
+		if (this == &map)
+			return *this;
+
+		// Remove the previous content and ...
+		clear();
+		freeStorage();
+		// ... copy the new stuff.
+		assign(map);
+		return *this;
+	}
+
+	bool contains(const Key &key) const;
+
+	Val &operator[](const Key &key);
+	const Val &operator[](const Key &key) const;
+
+	Val &getOrCreateVal(const Key &key);
+	Val &getVal(const Key &key);
+	const Val &getVal(const Key &key) const;
+	const Val &getValOrDefault(const Key &key) const;
+	const Val &getValOrDefault(const Key &key, const Val &defaultVal) const;
+	bool tryGetVal(const Key &key, Val &out) const;
+	void setVal(const Key &key, const Val &val);
+
+	void clear(bool shrinkArray = 0);
+
+	void erase(iterator entry);
+	void erase(const Key &key);
+
+	size_type size() const { return _size; }
+
+	size_type probeLength(const Key &key) const;
+
+	iterator	begin() {
+		return iterator(nextUsedSlot(0), this);
+	}
+	iterator	end() {
+		return iterator((size_type)-1, this);
+	}
+
+	const_iterator	begin() const {
+		return const_iterator(nextUsedSlot(0), this);
+	}
+	const_iterator	end() const {
+		return const_iterator((size_type)-1, this);
+	}
+
+	iterator	find(const Key &key) {
+		return iterator(lookup(key), this);
+	}
+
+	const_iterator	find(const Key &key) const {
+		return const_iterator(lookup(key), this);
+	}
+
+	/** Return true if hashmap is empty. */
+	bool empty() const {
+		return (_size == 0);
+	}
+};
+
+//-------------------------------------------------------
+// FlatHashMap functions
+
+/**
+ * Base constructor, creates an empty hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::FlatHashMap() : _defaultVal() {
+	allocStorage(FLATHASHMAP_MIN_CAPACITY);
+	_size = 0;
+	_erased = 0;
+}
+
+/**
+ * Copy constructor, creates a full copy of the given hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::FlatHashMap(const FHM_t &map) :
+	_defaultVal() {
+	assign(map);
+}
+
+/**
+ * Destructor, frees all used memory.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::~FlatHashMap() {
+	clear();
+	freeStorage();
+}
+
+/**
+ * Internal method for allocating empty storage for @p capacity slots.
+ *
+ * @note The previous storage is *not* deallocated here -- the caller is
+ *       responsible for doing that!
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::allocStorage(size_type capacity) {
+	_mask = capacity - 1;
+	_ctrl = new byte[capacity];
+	memset(_ctrl, FLATHASHMAP_CTRL_EMPTY, capacity);
+	_hashes = new uint32[capacity];
+	_slots = (Node *)malloc(capacity * sizeof(Node));
+	assert(_slots != nullptr);
+}
+
+/**
+ * Internal method for freeing the storage, whose nodes must already have
+ * been destroyed.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::freeStorage() {
+	delete[] _ctrl;
+	delete[] _hashes;
+	free(_slots);
+}
+
+/**
+ * Internal method for assigning the content of another FlatHashMap
+ * to this one.
+ *
+ * @note The previous storage here is *not* deallocated here -- the caller is
+ *       responsible for doing that!
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::assign(const FHM_t &map) {
+	allocStorage(map._mask + 1);
+
+	// Keep the same layout, so no hashing is needed.
+	memcpy(_ctrl, map._ctrl, _mask + 1);
+	memcpy(_hashes, map._hashes, (_mask + 1) * sizeof(uint32));
+	for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+		if (isUsed(_ctrl[ctr])) {
+			new ((void *)&_slots[ctr]) Node(map._slots[ctr]._key);
+			_slots[ctr]._value = map._slots[ctr]._value;
+		}
+	}
+
+	_size = map._size;
+	_erased = map._erased;
+}
+
+/**
+ * Clear all values in the hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::clear(bool shrinkArray) {
+	for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+		if (isUsed(_ctrl[ctr]))
+			_slots[ctr].~Node();
+	}
+
+	if (shrinkArray && _mask >= FLATHASHMAP_MIN_CAPACITY) {
+		freeStorage();
+		allocStorage(FLATHASHMAP_MIN_CAPACITY);
+	} else {
+		memset(_ctrl, FLATHASHMAP_CTRL_EMPTY, _mask + 1);
+	}
+
+	_size = 0;
+	_erased = 0;
+}
+
+/**
+ * Internal method for moving all nodes to new storage, which also gets rid
+ * of the erased slots.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::rehash(size_type newCapacity) {
+	assert(newCapacity > _size);
+
+	const size_type oldMask = _mask;
+	byte *oldCtrl = _ctrl;
+	uint32 *oldHashes = _hashes;
+	Node *oldSlots = _slots;
+
+	allocStorage(newCapacity);
+	_erased = 0;
+
+	for (size_type ctr = 0; ctr <= oldMask; ++ctr) {
+		if (!isUsed(oldCtrl[ctr]))
+			continue;
+
+		// The keys are known to be unique, so they can be put into the
+		// first unused slot without comparing them.
+		const uint32 hash = oldHashes[ctr];
+		const size_type idx = findUnusedSlot(hash);
+		_ctrl[idx] = oldCtrl[ctr];
+		_hashes[idx] = hash;
+		new ((void *)&_slots[idx]) Node(oldSlots[ctr]._key);
+		_slots[idx]._value = Common::move(oldSlots[ctr]._value);
+		oldSlots[ctr].~Node();
+	}
+
+	delete[] oldCtrl;
+	delete[] oldHashes;
+	free(oldSlots);
+}
+
+/**
+ * Internal method for finding the slot holding @p key.
+ *
+ * @return The index of the slot, or -1 if the key is not in the map.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::lookup(const Key &key) const {
+	const uint32 hash = hashKey(key);
+	const byte ctrl = ctrlForHash(hash);
+	const size_type groupMask = _mask / FLATHASHMAP_GROUP_SIZE;
+	size_type group = hash & groupMask;
+
+	for (size_type step = 1; ; ++step) {
+		const size_type base = group * FLATHASHMAP_GROUP_SIZE;
+		const uint64 ctrlGroup = loadGroup(_ctrl + base);
+
+		for (uint64 bits = matchByte(ctrlGroup, ctrl); bits; bits &= bits - 1) {
+			const size_type idx = base + lowestByte(bits);
+			if (isUsed(_ctrl[idx]) && _hashes[idx] == hash && _equal(_slots[idx]._key, key))
+				return idx;
+		}
+
+		// Keys are only ever put into the next groups when this one is
+		// full, so an empty slot ends the search.
+		if (matchEmpty(ctrlGroup))
+			return (size_type)-1;
+
+		group = (group + step) & groupMask;
+	}
+}
+
+/**
+ * Return the number of groups searched to look up @p key, which stays small
+ * as long as the keys are spread well over the groups.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::probeLength(const Key &key) const {
+	const uint32 hash = hashKey(key);
+	const byte ctrl = ctrlForHash(hash);
+	const size_type groupMask = _mask / FLATHASHMAP_GROUP_SIZE;
+	size_type group = hash & groupMask;
+
+	for (size_type step = 1; ; ++step) {
+		const size_type base = group * FLATHASHMAP_GROUP_SIZE;
+		const uint64 ctrlGroup = loadGroup(_ctrl + base);
+
+		for (uint64 bits = matchByte(ctrlGroup, ctrl); bits; bits &= bits - 1) {
+			const size_type idx = base + lowestByte(bits);
+			if (isUsed(_ctrl[idx]) && _hashes[idx] == hash && _equal(_slots[idx]._key, key))
+				return step;
+		}
+
+		if (matchEmpty(ctrlGroup))
+			return step;
+
+		group = (group + step) & groupMask;
+	}
+}
+
+/**
+ * Internal method for finding the slot where a new key with the given hash
+ * is to be inserted.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::findUnusedSlot(uint32 hash) const {
+	const size_type groupMask = _mask / FLATHASHMAP_GROUP_SIZE;
+	size_type group = hash & groupMask;
+
+	for (size_type step = 1; ; ++step) {
+		const size_type base = group * FLATHASHMAP_GROUP_SIZE;
+		const uint64 bits = matchUnused(loadGroup(_ctrl + base));
+		if (bits)
+			return base + lowestByte(bits);
+
+		group = (group + step) & groupMask;
+	}
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::lookupAndCreateIfMissing(const Key &key) {
+	size_type ctr = lookup(key);
+	if (ctr != (size_type)-1)
+		return ctr;
+
+	// Keep the load factor below a certain threshold.
+	// Erased slots are also counted, but only force a growth if there
+	// are enough used slots.
+	size_type capacity = _mask + 1;
+	if ((_size + _erased + 1) * FLATHASHMAP_LOADFACTOR_DENOMINATOR > capacity * FLATHASHMAP_LOADFACTOR_NUMERATOR) {
+		if ((_size + 1) * 2 * FLATHASHMAP_LOADFACTOR_DENOMINATOR > capacity * FLATHASHMAP_LOADFACTOR_NUMERATOR)
+			capacity *= 2;
+		rehash(capacity);
+	}
+
+	const uint32 hash = hashKey(key);
+	ctr = findUnusedSlot(hash);
+	if (_ctrl[ctr] == FLATHASHMAP_CTRL_ERASED)
+		_erased--;
+	_ctrl[ctr] = ctrlForHash(hash);
+	_hashes[ctr] = hash;
+	new ((void *)&_slots[ctr]) Node(key);
+	_size++;
+
+	return ctr;
+}
+
+/**
+ * Internal method for destroying the node in a slot.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::eraseSlot(size_type ctr) {
+	_slots[ctr].~Node();
+	_size--;
+
+	// If the group still has an empty slot, no search ever went past it,
+	// and the slot can be marked as empty again.
+	if (matchEmpty(loadGroup(_ctrl + (ctr & ~(size_type)(FLATHASHMAP_GROUP_SIZE - 1))))) {
+		_ctrl[ctr] = FLATHASHMAP_CTRL_EMPTY;
+	} else {
+		_ctrl[ctr] = FLATHASHMAP_CTRL_ERASED;
+		_erased++;
+	}
+}
+
+/**
+ * Check whether the hashmap contains the given key.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+bool FlatHashMap<Key, Val, HashFunc, EqualFunc>::contains(const Key &key) const {
+	return lookup(key) != (size_type)-1;
+}
+
+/**
+ * Get a value from the hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::operator[](const Key &key) {
+	return getOrCreateVal(key);
+}
+
+/**
+ * @overload
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::operator[](const Key &key) const {
+	return getVal(key);
+}
+
+/**
+ * Get a value from the hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getOrCreateVal(const Key &key) {
+	// The lookup may move the nodes, so it needs to be done first.
+	const size_type ctr = lookupAndCreateIfMissing(key);
+	return _slots[ctr]._value;
+}
+
+/**
+ * @overload
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key) {
+	size_type ctr = lookup(key);
+	if (ctr != (size_type)-1)
+		return _slots[ctr]._value;
+	else
+		// See comment in HashMap::getVal().
+#ifdef RELEASE_BUILD
+		return _defaultVal;
+#else
+		unknownKeyError(key);
+#endif
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key) const {
+	size_type ctr = lookup(key);
+	if (ctr != (size_type)-1)
+		return _slots[ctr]._value;
+	else
+		// See comment in HashMap::getVal().
+#ifdef RELEASE_BUILD
+		return _defaultVal;
+#else
+		unknownKeyError(key);
+#endif
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getValOrDefault(const Key &key) const {
+	return getValOrDefault(key, _defaultVal);
+}
+
+/**
+ * Get a value from the hashmap. If the key is not present, then return @p defaultVal.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getValOrDefault(const Key &key, const Val &defaultVal) const {
+	size_type ctr = lookup(key);
+	if (ctr != (size_type)-1)
+		return _slots[ctr]._value;
+	else
+		return defaultVal;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+bool FlatHashMap<Key, Val, HashFunc, EqualFunc>::tryGetVal(const Key &key, Val &out) const {
+	size_type ctr = lookup(key);
+	if (ctr != (size_type)-1) {
+		out = _slots[ctr]._value;
+		return true;
+	} else {
+		return false;
+	}
+}
+
+/**
+ * Assign an element specified by @p key to a value @p val.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::setVal(const Key &key, const Val &val) {
+	const size_type ctr = lookupAndCreateIfMissing(key);
+	_slots[ctr]._value = val;
+}
+
+/**
+ * Erase an element referred to by an iterator.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::erase(iterator entry) {
+	// Check whether we have a valid iterator
+	assert(entry._hashmap == this);
+	assert(entry._idx <= _mask);
+	assert(isUsed(_ctrl[entry._idx]));
+
+	eraseSlot(entry._idx);
+}
+
+/**
+ * Erase an element specified by a key.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::erase(const Key &key) {
+	size_type ctr = lookup(key);
+	if (ctr != (size_type)-1)
+		eraseSlot(ctr);
+}
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
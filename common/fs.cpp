@@ -263,6 +263,20 @@ SeekableReadStream *FSNode::createReadStreamForAltStream(AltStreamType altStream
 	return _realNode->createReadStreamForAltStream(altStreamType);
 }
 
+MemoryReadStream *FSNode::createMappedReadStream() const {
+	if (_realNode == nullptr || !_realNode->exists() || _realNode->isDirectory())
+		return nullptr;
+
+	return _realNode->createMappedReadStream();
+}
+
+bool FSNode::getSizeAndModificationTime(int64 &size, int64 &modificationTime) const {
+	if (_realNode == nullptr)
+		return false;
+
+	return _realNode->getSizeAndModificationTime(size, modificationTime);
+}
+
 SeekableWriteStream *FSNode::createWriteStream(bool atomic) const {
 	if (_realNode == nullptr)
 		return nullptr;
@@ -407,6 +421,19 @@ SeekableReadStream *FSDirectory::createReadStreamForMemberAltStream(const Path &
 	return stream;
 }
 
+MemoryReadStream *FSDirectory::createMappedReadStreamForMember(const Path &path) const {
+	if (path.empty() || !_node.isDirectory())
+		return nullptr;
+
+	FSNode *node = lookupCache(_fileCache, path);
+	if (!node)
+		return nullptr;
+
+	debug(5, "FSDirectory::createMappedReadStreamForMember('%s') -> '%s'", path.toString(Common::Path::kNativeSeparator).c_str(), node->getPath().toString(Common::Path::kNativeSeparator).c_str());
+
+	return node->createMappedReadStream();
+}
+
 FSDirectory *FSDirectory::getSubDirectory(const Path &name, int depth, bool flat, bool ignoreClashes) {
 	return getSubDirectory(Path(), name, depth, flat, ignoreClashes);
 }
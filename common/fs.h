@@ -45,6 +45,7 @@ namespace Common {
 
 class FSNode;
 class FSDirectory;
+class MemoryReadStream;
 class SeekableReadStream;
 class WriteStream;
 class SeekableWriteStream;
@@ -271,6 +272,32 @@ public:
 	 */
 	SeekableReadStream *createReadStreamForAltStream(AltStreamType altStreamType) const override;
 
+	/**
+	 * Create a MemoryReadStream instance whose data is the file referred by
+	 * this node mapped into memory, so that it can be parsed in place without
+	 * being read into a buffer first. This assumes that the node actually
+	 * refers to a readable file. If this is not the case, if the backend
+	 * cannot map files, or if the file is too large to be mapped, nullptr is
+	 * returned, and createReadStream() should be used instead.
+	 *
+	 * @return Pointer to the stream object, nullptr in case of a failure.
+	 */
+	MemoryReadStream *createMappedReadStream() const;
+
+	/**
+	 * Retrieve the size and the time of the last modification of the file
+	 * referred by this node, without opening it. The modification time is
+	 * in a backend specific unit, and is only meant to find out whether a
+	 * file has changed.
+	 *
+	 * @param size              Receives the size of the file.
+	 * @param modificationTime  Receives the time of the last modification.
+	 *
+	 * @return true on success, false if the node is not a file or the
+	 *         backend cannot tell.
+	 */
+	bool getSizeAndModificationTime(int64 &size, int64 &modificationTime) const;
+
 	/**
 	 * Create a WriteStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
@@ -452,6 +479,12 @@ public:
 	 * for success.
 	 */
 	SeekableReadStream *createReadStreamForMemberAltStream(const Path &path, AltStreamType altStreamType) const override;
+
+	/**
+	 * Map the specified file into memory. A full match of relative path and file name is needed
+	 * for success.
+	 */
+	MemoryReadStream *createMappedReadStreamForMember(const Path &path) const override;
 };
 
 /** @} */
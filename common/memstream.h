@@ -93,6 +93,12 @@ public:
 	int64 size() const { return _size; }
 
 	bool seek(int64 offs, int whence = SEEK_SET);
+
+	/**
+	 * Return a pointer to the start of the data, so that it can be parsed
+	 * in place. The data is valid for the lifetime of the stream.
+	 */
+	const byte *getData() const { return _ptrOrig.get(); }
 };
 
 
@@ -405,8 +405,9 @@ Common::Error AdvancedMetaEngineDetectionBase::identifyGame(DetectedGame &game,
 		}
 	}
 
-	// Detection is done, no need to keep archives in memory anymore
+	// Detection is done, no need to keep archives or listings in memory anymore
 	ADCacheMan.clearArchives();
+	ADCacheMan.clearDirectories();
 
 	if (!agdDesc.desc)
 		return Common::kNoGameDataFoundError;
@@ -441,11 +442,11 @@ void AdvancedMetaEngineDetectionBase::composeFileHashMap(FileMap &allFiles, cons
 			if (!_globsMap.contains(efname))
 				continue;
 
-			Common::FSList files;
-			if (!file.getChildren(files, Common::FSNode::kListAll))
+			const Common::FSList *files = ADCacheMan.getChildren(file);
+			if (!files)
 				continue;
 
-			composeFileHashMap(allFiles, files, depth - 1, tstr);
+			composeFileHashMap(allFiles, *files, depth - 1, tstr);
 			continue;
 		}
 
@@ -468,6 +469,75 @@ namespace Common {
 	DECLARE_SINGLETON(AdvancedDetectorCacheManager);
 }
 
+enum {
+	// Minimum time between two non-forced writes of the persistent cache
+	kPersistentCacheSaveInterval = 10000
+};
+
+Common::Path AdvancedDetectorCacheManager::getPersistentCachePath() const {
+	Common::Path configFile = ConfMan.getCustomConfigFileName();
+	if (configFile.empty())
+		configFile = g_system->getDefaultConfigFileName();
+
+	return configFile.getParent().appendComponent("detection_cache.dat");
+}
+
+void AdvancedDetectorCacheManager::loadPersistentCache() {
+	persistentLoaded = true;
+
+	Common::FSNode node(getPersistentCachePath());
+	if (!node.exists())
+		return;
+
+	Common::ScopedPtr<Common::SeekableReadStream> stream(node.createReadStream());
+	if (stream && persistentCache.load(*stream))
+		debugC(2, kDebugGlobalDetection, "Loaded %u entries from the persistent MD5 cache", persistentCache.size());
+}
+
+bool AdvancedDetectorCacheManager::getPersistentMD5(const Common::String &key, const Common::String &stamp, int64 &size, Common::String &md5) {
+	if (!persistentLoaded)
+		loadPersistentCache();
+
+	return persistentCache.lookup(key, stamp, size, md5);
+}
+
+void AdvancedDetectorCacheManager::setPersistentMD5(const Common::String &key, const Common::Path &path, const Common::String &stamp, int64 size, const Common::String &md5) {
+	if (!persistentLoaded)
+		loadPersistentCache();
+
+	persistentCache.store(key, path, stamp, size, md5);
+}
+
+void AdvancedDetectorCacheManager::savePersistentCache(bool force) {
+	if (!persistentLoaded)
+		return;
+
+	if (force)
+		persistentCache.prune();
+
+	const PersistentMD5Cache::Stats &stats = persistentCache.getStats();
+	debugC(2, kDebugGlobalDetection, "Persistent MD5 cache: %u hits, %u misses, %u invalidated, %u pruned",
+		stats.hits, stats.misses, stats.invalidated, stats.pruned);
+
+	if (!persistentCache.isDirty())
+		return;
+
+	const uint32 now = g_system->getMillis();
+	if (!force && persistentLastSave != 0 && now - persistentLastSave < kPersistentCacheSaveInterval)
+		return;
+
+	Common::FSNode node(getPersistentCachePath());
+	Common::ScopedPtr<Common::WriteStream> stream(node.createWriteStream());
+	if (!stream) {
+		warning("Could not write the detection cache to '%s'", node.getPath().toString(Common::Path::kNativeSeparator).c_str());
+		persistentLastSave = now;
+		return;
+	}
+
+	persistentCache.save(*stream);
+	stream->finalize();
+	persistentLastSave = now;
+}
 
 static MD5Properties gameFileToMD5Props(const ADGameFileDescription *fileEntry, uint32 gameFlags) {
 	MD5Properties ret = kMD5Head;
@@ -559,11 +629,62 @@ bool AdvancedMetaEngineBase::getFilePropertiesExtern(uint md5Bytes, const FileMa
 	return getFilePropertiesIntern(md5Bytes, allFiles, md5prop, fname, fileProps);
 }
 
+/**
+ * Build the persistent cache stamp of a resource fork. MacResManager may
+ * read it from any of several files, so the stamp covers all of them, and
+ * the entry is attached to the first one which exists.
+ */
+static bool getResForkStamp(const AdvancedMetaEngineBase::FileMap &allFiles, const Common::Path &fname, Common::Path &path, Common::String &stamp) {
+	const Common::Path candidates[] = {
+		fname,
+		fname.append(".rsrc"),
+		fname.append(".bin"),
+		fname.getParent().appendComponent("._" + fname.baseName())
+	};
+
+	path.clear();
+	stamp.clear();
+	for (int i = 0; i < ARRAYSIZE(candidates); i++) {
+		if (i > 0)
+			stamp += ',';
+
+		AdvancedMetaEngineBase::FileMap::const_iterator it = allFiles.find(candidates[i]);
+		if (it == allFiles.end()) {
+			stamp += '-';
+			continue;
+		}
+
+		Common::String fileStamp;
+		if (!PersistentMD5Cache::makeStamp(it->_value, fileStamp))
+			return false;
+
+		stamp += fileStamp;
+		if (path.empty())
+			path = it->_value.getPath();
+	}
+
+	return !path.empty();
+}
+
 static bool getFilePropertiesIntern(uint md5Bytes, const AdvancedMetaEngineBase::FileMap &allFiles, MD5Properties md5prop, const Common::Path &fname, FileProperties &fileProps) {
 	if (md5prop & (kMD5MacResFork | kMD5MacDataFork)) {
 		FileMapArchive fileMapArchive(allFiles);
 		bool is_legacy = ((md5prop & kMD5MacMask) == kMD5MacResOrDataFork);
 		if (md5prop & kMD5MacResFork) {
+			const MD5Properties resForkProp = (MD5Properties)((md5prop & kMD5Tail) | kMD5MacResFork);
+
+			Common::Path stampPath;
+			Common::String stamp, persistentKey;
+			if (getResForkStamp(allFiles, fname, stampPath, stamp)) {
+				persistentKey = Common::String::format("%s:%u:%s", md5PropToCachePrefix(resForkProp).c_str(), md5Bytes,
+					stampPath.toString('/').c_str());
+
+				if (ADCacheMan.getPersistentMD5(persistentKey, stamp, fileProps.size, fileProps.md5)) {
+					fileProps.md5prop = resForkProp;
+					return true;
+				}
+			}
+
 			Common::MacResManager macResMan;
 
 			if (!macResMan.open(fname, fileMapArchive))
@@ -573,7 +694,10 @@ static bool getFilePropertiesIntern(uint md5Bytes, const AdvancedMetaEngineBase:
 			fileProps.size = macResMan.getResForkDataSize();
 
 			if (fileProps.size != 0) {
-				fileProps.md5prop = (MD5Properties)((md5prop & kMD5Tail) | kMD5MacResFork);
+				fileProps.md5prop = resForkProp;
+
+				if (!persistentKey.empty())
+					ADCacheMan.setPersistentMD5(persistentKey, stampPath, stamp, fileProps.size, fileProps.md5);
 				return true;
 			}
 		}
@@ -597,6 +721,9 @@ static bool getFilePropertiesIntern(uint md5Bytes, const AdvancedMetaEngineBase:
 	}
 
 	Common::ScopedPtr<Common::SeekableReadStream> testFile;
+	Common::String stamp, persistentKey;
+
+	fileProps.md5prop = (MD5Properties) (md5prop & kMD5Tail);
 
 	if (md5prop & kMD5Archive) {
 		// The desired file is inside an archive
@@ -652,19 +779,34 @@ static bool getFilePropertiesIntern(uint md5Bytes, const AdvancedMetaEngineBase:
 		if (!allFiles.contains(fname))
 			return false;
 
+		// Plain files are looked up in the persistent cache by their full
+		// path, size and modification time, without opening them
+		const Common::FSNode &node = allFiles[fname];
+		if (PersistentMD5Cache::makeStamp(node, stamp)) {
+			persistentKey = Common::String::format("%s:%u:%s", md5PropToCachePrefix(fileProps.md5prop).c_str(), md5Bytes,
+				node.getPath().toString('/').c_str());
+
+			if (ADCacheMan.getPersistentMD5(persistentKey, stamp, fileProps.size, fileProps.md5))
+				return true;
+		}
+
 		testFile.reset(new Common::File());
-		if (!((Common::File *)testFile.get())->open(allFiles[fname]))
+		if (!((Common::File *)testFile.get())->open(node))
 			return false;
 	}
 
+	fileProps.size = testFile->size();
+
 	if (md5prop & kMD5Tail) {
 		if (testFile->size() > md5Bytes)
 			testFile->seek(-(int64)md5Bytes, SEEK_END);
 	}
 
-	fileProps.size = testFile->size();
 	fileProps.md5 = Common::computeStreamMD5AsString(*testFile.get(), md5Bytes);
-	fileProps.md5prop = (MD5Properties) (md5prop & kMD5Tail);
+
+	if (!persistentKey.empty())
+		ADCacheMan.setPersistentMD5(persistentKey, allFiles[fname].getPath(), stamp, fileProps.size, fileProps.md5);
+
 	return true;
 }
 
@@ -24,6 +24,7 @@
 
 #include "engines/metaengine.h"
 #include "engines/engine.h"
+#include "engines/md5cache.h"
 
 #include "common/hash-str.h"
 
@@ -772,7 +773,56 @@ public:
 		return archiveHashMap.getValOrDefault(node.getPath(), nullptr);
 	}
 
-	AdvancedDetectorCacheManager() {
+	/**
+	 * Look up the MD5 of a file in the persistent cache, which is kept across
+	 * runs in the configuration directory.
+	 *
+	 * @param key    Full path of the file, prefixed with its MD5 properties and
+	 *               the number of bytes the MD5 is computed for.
+	 * @param stamp  Current size and modification time of the file, see
+	 *               PersistentMD5Cache::makeStamp(). Entries recorded with a
+	 *               different stamp are considered stale and are dropped.
+	 * @param size   Receives the cached size on success.
+	 * @param md5    Receives the cached MD5 on success.
+	 */
+	bool getPersistentMD5(const Common::String &key, const Common::String &stamp, int64 &size, Common::String &md5);
+
+	/** Record the MD5 of a file in the persistent cache. */
+	void setPersistentMD5(const Common::String &key, const Common::Path &path, const Common::String &stamp, int64 size, const Common::String &md5);
+
+	/**
+	 * Write the persistent cache back to disk if it has been modified.
+	 *
+	 * Unless @p force is set, writes are rate-limited so that scanning many
+	 * directories in a row does not rewrite the whole cache file every time.
+	 * Forced writes also drop the entries of files which no longer exist.
+	 */
+	void savePersistentCache(bool force = false);
+
+	/** Statistics of the persistent cache, accumulated over the session. */
+	const PersistentMD5Cache::Stats &getPersistentCacheStats() const {
+		return persistentCache.getStats();
+	}
+
+	/**
+	 * Return the contents of a directory, listing it only once per detection
+	 * run. All detection plugins scan the same game directory, so this saves
+	 * re-reading any subdirectory matched by several engines.
+	 *
+	 * @return The list of children, or nullptr if the directory could not be listed.
+	 */
+	const Common::FSList *getChildren(const Common::FSNode &node) {
+		DirectoryHashMap::iterator it = directoryHashMap.find(node.getPath());
+		if (it == directoryHashMap.end()) {
+			DirectoryListing &listing = directoryHashMap.getOrCreateVal(node.getPath());
+			listing.valid = node.getChildren(listing.files, Common::FSNode::kListAll);
+			return listing.valid ? &listing.files : nullptr;
+		}
+
+		return it->_value.valid ? &it->_value.files : nullptr;
+	}
+
+	AdvancedDetectorCacheManager() : persistentLoaded(false), persistentLastSave(0) {
 		clear();
 	}
 
@@ -783,9 +833,18 @@ public:
 		archiveHashMap.clear(true);
 	}
 
+	/**
+	 * Forget the directory listings of the last detection run. They would
+	 * otherwise keep whole directory trees in memory.
+	 */
+	void clearDirectories() {
+		directoryHashMap.clear(true);
+	}
+
 	void clear() {
 		md5HashMap.clear(true);
 		sizeHashMap.clear(true);
+		clearDirectories();
 		clearArchives();
 	}
 
@@ -798,6 +857,25 @@ private:
 	FileHashMap md5HashMap;
 	SizeHashMap sizeHashMap;
 	ArchiveHashMap archiveHashMap;
+
+	struct DirectoryListing {
+		DirectoryListing() : valid(false) {}
+
+		bool valid;
+		Common::FSList files;
+	};
+
+	// HashMap nodes are never moved, so pointers to the listings stay
+	// valid while more directories are added
+	typedef Common::HashMap<Common::Path, DirectoryListing, Common::Path::Hash, Common::Path::EqualTo> DirectoryHashMap;
+	DirectoryHashMap directoryHashMap;
+
+	void loadPersistentCache();
+	Common::Path getPersistentCachePath() const;
+
+	PersistentMD5Cache persistentCache;
+	bool persistentLoaded;
+	uint32 persistentLastSave;
 };
 
 /** Convenience shortcut for accessing the MD5CacheManager. */
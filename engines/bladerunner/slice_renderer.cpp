@@ -537,6 +537,24 @@ void SliceRenderer::drawOnScreen(int animationId, int animationFrame, int screen
 	}
 }
 
+template<typename T>
+static inline void fillSliceSpan(T *dstLine, uint16 *zbufferLine, int x, int xEnd, int maxX, uint16 z, T color) {
+	// Pixels past the right edge of the surface are clamped to its last column
+	const int xInside = MIN(xEnd, maxX + 1);
+	for (; x < xInside; ++x) {
+		if (z < zbufferLine[x]) {
+			zbufferLine[x] = z;
+			dstLine[x] = color;
+		}
+	}
+	for (; x < xEnd; ++x) {
+		if (z < zbufferLine[x]) {
+			zbufferLine[x] = z;
+			dstLine[maxX] = color;
+		}
+	}
+}
+
 void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface &surface, uint16 *zbufferLine) {
 	if (slice < 0 || (uint32)slice >= _frameSliceCount) {
 		return;
@@ -544,6 +562,10 @@ void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface
 
 	SliceAnimations::Palette &palette = _vm->_sliceAnimations->getPalette(_framePaletteIndex);
 
+	// The whole slice lands on a single screen row
+	void *dstLine = surface.getBasePtr(0, CLIP(y, 0, surface.h - 1));
+	const int maxX = surface.w - 1;
+
 	byte *p = (byte *)_sliceFramePtr + 0x20 + 4 * slice;
 
 	uint32 polyOffset = READ_LE_UINT32(p);
@@ -572,6 +594,17 @@ void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface
 				int vertexZ = (_m21lookup[p[0]] + _m22lookup[p[1]] + _m23) / 64;
 
 				if (vertexZ >= 0 && vertexZ < 65536) {
+					// Skip the lighting calculation for spans that are completely hidden
+					int x = previousVertexX;
+					while (x != vertexX && vertexZ >= zbufferLine[x]) {
+						++x;
+					}
+					if (x == vertexX) {
+						p += 3;
+						previousVertexX = vertexX;
+						continue;
+					}
+
 					uint32 outColor = palette.value[p[2]];
 					if (advanced) {
 						Color256 aescColor = { 0, 0, 0 };
@@ -585,13 +618,23 @@ void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface
 						outColor = _pixelFormat.RGBToColor(Color::get8BitColorFrom5Bit(color.r), Color::get8BitColorFrom5Bit(color.g), Color::get8BitColorFrom5Bit(color.b));
 					}
 
-					for (int x = previousVertexX; x != vertexX; ++x) {
-						if (vertexZ < zbufferLine[x]) {
-							zbufferLine[x] = (uint16)vertexZ;
-
-							void *dstPtr = surface.getBasePtr(CLIP(x, 0, surface.w - 1), CLIP(y, 0, surface.h - 1));
-							drawPixel(surface, dstPtr, outColor);
+					switch (surface.format.bytesPerPixel) {
+					case 1:
+						fillSliceSpan<uint8>((uint8 *)dstLine, zbufferLine, x, vertexX, maxX, (uint16)vertexZ, (uint8)outColor);
+						break;
+					case 2:
+						fillSliceSpan<uint16>((uint16 *)dstLine, zbufferLine, x, vertexX, maxX, (uint16)vertexZ, (uint16)outColor);
+						break;
+					case 4:
+						fillSliceSpan<uint32>((uint32 *)dstLine, zbufferLine, x, vertexX, maxX, (uint16)vertexZ, outColor);
+						break;
+					default:
+						for (; x != vertexX; ++x) {
+							if (vertexZ < zbufferLine[x]) {
+								zbufferLine[x] = (uint16)vertexZ;
+							}
 						}
+						break;
 					}
 				}
 			}
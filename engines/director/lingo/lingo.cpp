@@ -868,29 +868,54 @@ int Lingo::getAlignedType(const Datum &d1, const Datum &d2, bool equality) {
 	return opType;
 }
 
+bool Datum::isRefCounted() const {
+	switch (type) {
+	case VOID:
+	case INT:
+	case FLOAT:
+	case ARGC:
+	case ARGCNORET:
+	case CASTLIBREF:
+	case SPRITEREF:
+		return false;
+	default:
+		return true;
+	}
+}
+
+void Datum::share(const Datum &d) {
+	type = d.type;
+	u = d.u;
+	if (d.isRefCounted()) {
+		// Values which own no memory are simply copied, a shared reference
+		// count is only needed for the others
+		if (!d.refCount) {
+			d.refCount = new int;
+			*d.refCount = 1;
+		}
+		refCount = d.refCount;
+		*refCount += 1;
+	} else {
+		refCount = nullptr;
+	}
+}
+
 Datum::Datum() {
 	u.s = nullptr;
 	type = VOID;
-	refCount = new int;
-	*refCount = 1;
+	refCount = nullptr;
 	ignoreGlobal = false;
 }
 
 Datum::Datum(const Datum &d) {
-	type = d.type;
-	u = d.u;
-	refCount = d.refCount;
-	*refCount += 1;
+	share(d);
 	ignoreGlobal = false;
 }
 
 Datum& Datum::operator=(const Datum &d) {
-	if (this != &d && refCount != d.refCount) {
+	if (this != &d && (!refCount || refCount != d.refCount)) {
 		reset();
-		type = d.type;
-		u = d.u;
-		refCount = d.refCount;
-		*refCount += 1;
+		share(d);
 	}
 	ignoreGlobal = false;
 	return *this;
@@ -899,24 +924,21 @@ Datum& Datum::operator=(const Datum &d) {
 Datum::Datum(int val) {
 	u.i = val;
 	type = INT;
-	refCount = new int;
-	*refCount = 1;
+	refCount = nullptr;
 	ignoreGlobal = false;
 }
 
 Datum::Datum(double val) {
 	u.f = val;
 	type = FLOAT;
-	refCount = new int;
-	*refCount = 1;
+	refCount = nullptr;
 	ignoreGlobal = false;
 }
 
 Datum::Datum(const Common::String &val) {
 	u.s = new Common::String(val);
 	type = STRING;
-	refCount = new int;
-	*refCount = 1;
+	refCount = nullptr;
 	ignoreGlobal = false;
 }
 
@@ -928,8 +950,7 @@ Datum::Datum(AbstractObject *val) {
 		*refCount += 1;
 	} else {
 		type = VOID;
-		refCount = new int;
-		*refCount = 1;
+		refCount = nullptr;
 	}
 	ignoreGlobal = false;
 }
@@ -942,8 +963,7 @@ Datum::Datum(CastMember *val) {
 		*refCount += 1;
 	} else {
 		type = VOID;
-		refCount = new int;
-		*refCount = 1;
+		refCount = nullptr;
 	}
 	ignoreGlobal = false;
 }
@@ -951,8 +971,7 @@ Datum::Datum(CastMember *val) {
 Datum::Datum(const CastMemberID &val) {
 	u.cast = new CastMemberID(val);
 	type = CASTREF;
-	refCount = new int;
-	*refCount = 1;
+	refCount = nullptr;
 	ignoreGlobal = false;
 }
 
@@ -961,8 +980,7 @@ Datum::Datum(const Common::Point &point) {
 	u.farr = new FArray;
 	u.farr->arr.push_back(Datum(point.x));
 	u.farr->arr.push_back(Datum(point.y));
-	refCount = new int;
-	*refCount = 1;
+	refCount = nullptr;
 	ignoreGlobal = false;
 }
 
@@ -973,21 +991,19 @@ Datum::Datum(const Common::Rect &rect) {
 	u.farr->arr.push_back(Datum(rect.top));
 	u.farr->arr.push_back(Datum(rect.right));
 	u.farr->arr.push_back(Datum(rect.bottom));
-	refCount = new int;
-	*refCount = 1;
+	refCount = nullptr;
 	ignoreGlobal = false;
 }
 
 void Datum::reset() {
-	if (!refCount)
-		return;
-
-	*refCount -= 1;
+	// A Datum without a reference count is the only owner of its value
+	if (refCount)
+		*refCount -= 1;
 	// Coverity thinks that we always free memory, as it assumes
 	// (correctly) that there are cases when refCount == 0
 	// Thus, DO NOT COMPILE, trick it and shut tons of false positives
 #ifndef __COVERITY__
-	if (*refCount <= 0) {
+	if (!refCount || *refCount <= 0) {
 		switch (type) {
 		case VOID:
 		case INT:
@@ -1019,7 +1035,8 @@ void Datum::reset() {
 		case OBJECT:
 			if (u.obj->getObjType() == kWindowObj) {
 				// Window has an override for decRefCount, use it directly
-				*refCount += 1;
+				if (refCount)
+					*refCount += 1;
 				static_cast<Window *>(u.obj)->decRefCount();
 			} else {
 				// *refCount is copied between the Datum and the Object,
@@ -143,7 +143,10 @@ struct Datum {	/* interpreter stack type */
 		PictureReference *picture; /* PICTUREREF */
 	} u;
 
-	int *refCount;
+	// Shared reference count of the value. Values which own no memory (ints,
+	// floats...) have none, and neither have values with a single owner,
+	// until they get copied.
+	mutable int *refCount;
 
 	bool ignoreGlobal; // True if this Datum should be ignored by showGlobals and clearGlobals
 
@@ -188,6 +191,10 @@ struct Datum {	/* interpreter stack type */
 	bool operator<(const Datum &d) const;
 	bool operator>=(const Datum &d) const;
 	bool operator<=(const Datum &d) const;
+
+private:
+	bool isRefCounted() const;
+	void share(const Datum &d);
 };
 
 struct ChunkReference {
@@ -0,0 +1,144 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "engines/md5cache.h"
+
+#include "common/fs.h"
+#include "common/stream.h"
+
+// Version of the cache file format, bump when it changes
+#define MD5CACHE_HEADER "ScummVM detection cache 2"
+
+bool PersistentMD5Cache::makeStamp(const Common::FSNode &node, Common::String &stamp) {
+	int64 size, modificationTime;
+	if (!node.getSizeAndModificationTime(size, modificationTime))
+		return false;
+
+	stamp = Common::String::format("%lld:%lld", (long long)size, (long long)modificationTime);
+	return true;
+}
+
+bool PersistentMD5Cache::lookup(const Common::String &key, const Common::String &stamp, int64 &size, Common::String &md5) {
+	EntryMap::iterator it = _entries.find(key);
+	if (it == _entries.end()) {
+		_stats.misses++;
+		return false;
+	}
+
+	if (it->_value.stamp != stamp) {
+		_entries.erase(it);
+		_dirty = true;
+		_stats.invalidated++;
+		_stats.misses++;
+		return false;
+	}
+
+	size = it->_value.size;
+	md5 = it->_value.md5;
+	_stats.hits++;
+	return true;
+}
+
+void PersistentMD5Cache::store(const Common::String &key, const Common::Path &path, const Common::String &stamp, int64 size, const Common::String &md5) {
+	// The cache file is line and tab separated
+	const Common::String pathString = path.toConfig();
+	if (key.contains('\t') || key.contains('\n') || pathString.contains('\t') || pathString.contains('\n'))
+		return;
+
+	Entry &entry = _entries.getOrCreateVal(key);
+	entry.stamp = stamp;
+	entry.path = path;
+	entry.size = size;
+	entry.md5 = md5;
+	_dirty = true;
+}
+
+bool PersistentMD5Cache::fileExists(const Common::Path &path) {
+	return Common::FSNode(path).exists();
+}
+
+uint PersistentMD5Cache::prune(ExistsFunc exists) {
+	// Many entries share a directory, only check each one once
+	Common::HashMap<Common::Path, bool, Common::Path::Hash, Common::Path::EqualTo> dirExists;
+	uint count = 0;
+
+	for (EntryMap::iterator it = _entries.begin(); it != _entries.end(); ++it) {
+		if (exists(it->_value.path))
+			continue;
+
+		const Common::Path parent = it->_value.path.getParent();
+		if (!dirExists.contains(parent))
+			dirExists[parent] = exists(parent);
+
+		if (dirExists[parent]) {
+			_entries.erase(it);
+			count++;
+		}
+	}
+
+	if (count) {
+		_stats.pruned += count;
+		_dirty = true;
+	}
+	return count;
+}
+
+bool PersistentMD5Cache::load(Common::SeekableReadStream &stream) {
+	if (stream.readLine() != MD5CACHE_HEADER)
+		return false;
+
+	while (!stream.eos() && !stream.err()) {
+		Common::String line = stream.readLine();
+
+		// Each line holds the stamp, the size, the MD5, the path and the key
+		const char *fields[5];
+		fields[0] = line.c_str();
+		int i;
+		for (i = 1; i < 5; i++) {
+			const char *sep = strchr(fields[i - 1], '\t');
+			if (!sep)
+				break;
+			fields[i] = sep + 1;
+		}
+		if (i < 5)
+			continue;
+
+		Entry &entry = _entries.getOrCreateVal(fields[4]);
+		entry.stamp = Common::String(fields[0], fields[1] - 1);
+		entry.size = (int64)Common::String(fields[1], fields[2] - 1).asUint64();
+		entry.md5 = Common::String(fields[2], fields[3] - 1);
+		entry.path = Common::Path::fromConfig(Common::String(fields[3], fields[4] - 1));
+	}
+
+	_dirty = false;
+	return true;
+}
+
+void PersistentMD5Cache::save(Common::WriteStream &stream) {
+	stream.writeString(MD5CACHE_HEADER "\n");
+	for (EntryMap::const_iterator it = _entries.begin(); it != _entries.end(); ++it) {
+		const Entry &entry = it->_value;
+		stream.writeString(Common::String::format("%s\t%lld\t%s\t%s\t%s\n", entry.stamp.c_str(), (long long)entry.size,
+			entry.md5.c_str(), entry.path.toConfig().c_str(), it->_key.c_str()));
+	}
+
+	_dirty = false;
+}
@@ -0,0 +1,119 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef ENGINES_MD5CACHE_H
+#define ENGINES_MD5CACHE_H
+
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+#include "common/path.h"
+#include "common/str.h"
+
+namespace Common {
+class FSNode;
+class SeekableReadStream;
+class WriteStream;
+}
+
+/**
+ * A cache of file MD5s which is kept across runs, so that detection does
+ * not have to read the files again.
+ *
+ * Each entry is stored together with a stamp built from the size and the
+ * modification time of the files it was computed from, and is only used
+ * while the stamp still matches.
+ */
+class PersistentMD5Cache {
+public:
+	struct Stats {
+		Stats() : hits(0), misses(0), invalidated(0), pruned(0) {}
+
+		uint32 hits;        ///< Lookups answered from the cache.
+		uint32 misses;      ///< Lookups for files not in the cache.
+		uint32 invalidated; ///< Entries dropped because the file changed.
+		uint32 pruned;      ///< Entries dropped because the file is gone.
+	};
+
+	/** Tells whether a file or directory exists, used for pruning. */
+	typedef bool (*ExistsFunc)(const Common::Path &path);
+
+	PersistentMD5Cache() : _dirty(false) {}
+
+	/**
+	 * Build the stamp of a file from its size and modification time.
+	 *
+	 * @return false if the backend cannot tell the modification time, in
+	 *         which case the file must not be cached.
+	 */
+	static bool makeStamp(const Common::FSNode &node, Common::String &stamp);
+
+	/**
+	 * Look up an entry.
+	 *
+	 * @param key    Identifies what has been hashed, including the path.
+	 * @param stamp  Current stamp of the files. An entry with a different
+	 *               stamp is stale and is dropped.
+	 * @param size   Receives the cached size.
+	 * @param md5    Receives the cached MD5.
+	 */
+	bool lookup(const Common::String &key, const Common::String &stamp, int64 &size, Common::String &md5);
+
+	/**
+	 * Record an entry.
+	 *
+	 * @param path  File whose disappearance makes the entry obsolete.
+	 */
+	void store(const Common::String &key, const Common::Path &path, const Common::String &stamp, int64 size, const Common::String &md5);
+
+	/**
+	 * Drop the entries of files which no longer exist. Entries are kept
+	 * when their directory is missing as well, so that unmounted drives do
+	 * not lose their entries.
+	 *
+	 * @return the number of dropped entries
+	 */
+	uint prune(ExistsFunc exists = &fileExists);
+
+	bool load(Common::SeekableReadStream &stream);
+	void save(Common::WriteStream &stream);
+
+	uint size() const { return _entries.size(); }
+	bool isDirty() const { return _dirty; }
+	const Stats &getStats() const { return _stats; }
+
+private:
+	struct Entry {
+		Common::String stamp;
+		Common::Path path;
+		int64 size;
+		Common::String md5;
+	};
+
+	typedef Common::HashMap<Common::String, Entry> EntryMap;
+
+	static bool fileExists(const Common::Path &path);
+
+	EntryMap _entries;
+	Stats _stats;
+	bool _dirty;
+};
+
+#endif
@@ -233,6 +233,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("bpe",				WRAP_METHOD(Console, cmdBreakpointFunction));		// alias
 	// VM
 	registerCmd("script_steps",		WRAP_METHOD(Console, cmdScriptSteps));
+	registerCmd("selector_cache",	WRAP_METHOD(Console, cmdSelectorCache));
 	registerCmd("script_objects",   WRAP_METHOD(Console, cmdScriptObjects));
 	registerCmd("scro",             WRAP_METHOD(Console, cmdScriptObjects));
 	registerCmd("script_strings",   WRAP_METHOD(Console, cmdScriptStrings));
@@ -447,6 +448,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf("\n");
 	debugPrintf("VM:\n");
 	debugPrintf(" script_steps - Shows the number of executed SCI operations\n");
+	debugPrintf(" selector_cache - Shows or resets the statistics of the selector lookup cache\n");
 	debugPrintf(" script_objects / scro - Shows all objects inside a specified script\n");
 	debugPrintf(" script_strings / scrs - Shows all strings inside a specified script\n");
 	debugPrintf(" script_said - Shows all said - strings inside a specified script\n");
@@ -3436,6 +3438,29 @@ bool Console::cmdScriptSteps(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdSelectorCache(int argc, const char **argv) {
+	SelectorLookupCache &cache = _engine->_gamestate->_segMan->getSelectorLookupCache();
+
+	if (argc > 2 || (argc == 2 && strcmp(argv[1], "reset") && strcmp(argv[1], "flush"))) {
+		debugPrintf("Shows the statistics of the selector lookup cache.\n");
+		debugPrintf("Usage: %s [reset|flush]\n", argv[0]);
+		debugPrintf("reset clears the counters, flush also drops the cached lookups\n");
+		return true;
+	}
+
+	if (argc == 2) {
+		if (!strcmp(argv[1], "flush"))
+			cache.flush();
+		cache.resetStats();
+	}
+
+	const uint32 lookups = cache.getHits() + cache.getMisses();
+	debugPrintf("Lookups: %u, hits: %u (%u%%), misses: %u\n", lookups, cache.getHits(),
+		lookups ? (uint)((uint64)cache.getHits() * 100 / lookups) : 0, cache.getMisses());
+	debugPrintf("Flushes: %u, used entries: %u of %u\n", cache.getFlushes(), cache.getUsedEntries(), cache.getSize());
+	return true;
+}
+
 bool Console::cmdScriptObjects(int argc, const char **argv) {
 	if (argc < 2) {
 		debugPrintf("Shows all objects inside a specified script.\n");
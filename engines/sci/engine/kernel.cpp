@@ -967,6 +967,9 @@ void script_adjust_opcode_formats() {
 		g_sci->_opcode_formats[op_superP][0] = Script_None;
 	}
 #endif
+
+	g_sci->_opcodeOperands = new OpcodeOperands[256];
+	initOpcodeOperands(g_sci->_opcode_formats, g_sci->_opcodeOperands);
 }
 
 } // End of namespace Sci
@@ -165,6 +165,7 @@ void SegManager::deallocate(SegmentId seg) {
 	if (mobj->getType() == SEG_TYPE_SCRIPT) {
 		Script *scr = (Script *)mobj;
 		_scriptSegMap.erase(scr->getScriptNumber());
+		_selectorLookupCache.flush();
 		if (scr->getLocalsSegment()) {
 			// Check if the locals segment has already been deallocated.
 			// If the locals block has been stored in a segment with an ID
@@ -1102,6 +1103,8 @@ int SegManager::instantiateScript(int scriptNum, bool applyScriptPatches) {
 	scr->load(scriptNum, _resMan, _scriptPatcher, applyScriptPatches);
 	scr->initializeLocals(this);
 	scr->initializeObjects(this, segmentId, applyScriptPatches);
+	// A script reloaded in place puts new objects at the positions of the old ones
+	_selectorLookupCache.flush();
 #ifdef ENABLE_SCI32
 	g_sci->_guestAdditions->instantiateScriptHook(*scr);
 #endif
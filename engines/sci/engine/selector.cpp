@@ -323,36 +323,35 @@ void invokeSelector(EngineState *s, reg_t object, int selectorId,
 	run_vm(s); // Start a new vm
 }
 
-SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector selectorId, ObjVarRef *varp, reg_t *fptr) {
-	const Object *obj = segMan->getObject(obj_location);
-	bool oldScriptHeader = (getSciVersion() == SCI_VERSION_0_EARLY);
-
-	// Early SCI versions used the LSB in the selector ID as a read/write
-	// toggle, meaning that we must remove it for selector lookup.
-	if (oldScriptHeader)
-		selectorId &= ~1;
+void SelectorLookupCache::flush() {
+	for (uint i = 0; i < kCacheSize; i++) {
+		_entries[i].objPos = NULL_REG;
+		_entries[i].selectorId = -1;
+	}
+	_flushes++;
+}
 
-	if (!obj) {
-		error("lookupSelector: Attempt to send to non-object or invalid script. Address %04x:%04x", PRINT_REG(obj_location));
+uint SelectorLookupCache::getUsedEntries() const {
+	uint used = 0;
+	for (uint i = 0; i < kCacheSize; i++) {
+		if (!_entries[i].objPos.isNull())
+			used++;
 	}
+	return used;
+}
 
-	int index = obj->locateVarSelector(segMan, selectorId);
+static SelectorType resolveSelector(SegManager *segMan, const Object *obj, Selector selectorId, int &varIndex, reg_t &func) {
+	varIndex = obj->locateVarSelector(segMan, selectorId);
 
-	if (index >= 0) {
+	if (varIndex >= 0) {
 		// Found it as a variable
-		if (varp) {
-			varp->obj = obj_location;
-			varp->varindex = index;
-		}
 		return kSelectorVariable;
 	} else {
 		// Check if it's a method, with recursive lookup in superclasses
 		while (obj) {
-			index = obj->funcSelectorPosition(selectorId);
+			int index = obj->funcSelectorPosition(selectorId);
 			if (index >= 0) {
-				if (fptr)
-					*fptr = obj->getFunction(index);
-
+				func = obj->getFunction(index);
 				return kSelectorMethod;
 			} else {
 				obj = segMan->getObject(obj->getSuperClassSelector());
@@ -363,4 +362,41 @@ SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector sel
 	}
 }
 
+SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector selectorId, ObjVarRef *varp, reg_t *fptr) {
+	const Object *obj = segMan->getObject(obj_location);
+	bool oldScriptHeader = (getSciVersion() == SCI_VERSION_0_EARLY);
+
+	// Early SCI versions used the LSB in the selector ID as a read/write
+	// toggle, meaning that we must remove it for selector lookup.
+	if (oldScriptHeader)
+		selectorId &= ~1;
+
+	if (!obj) {
+		error("lookupSelector: Attempt to send to non-object or invalid script. Address %04x:%04x", PRINT_REG(obj_location));
+	}
+
+	SelectorLookupCache &cache = segMan->getSelectorLookupCache();
+	const reg_t objPos = obj->getPos();
+	int varIndex;
+	reg_t func = NULL_REG;
+	SelectorType type;
+
+	if (!cache.lookup(objPos, selectorId, varIndex, func, type)) {
+		type = resolveSelector(segMan, obj, selectorId, varIndex, func);
+		cache.store(objPos, selectorId, varIndex, func, type);
+	}
+
+	if (type == kSelectorVariable) {
+		if (varp) {
+			varp->obj = obj_location;
+			varp->varindex = varIndex;
+		}
+	} else if (type == kSelectorMethod) {
+		if (fptr)
+			*fptr = func;
+	}
+
+	return type;
+}
+
 } // End of namespace Sci
@@ -430,66 +430,35 @@ static void callKernelFunc(EngineState *s, int kernelCallNr, int argc) {
 		s->_executionStack.pop_back();
 }
 
-int readPMachineInstruction(const byte *src, byte &extOpcode, int16 opparams[4]) {
+// Inlined into run_vm(), where decoding the instruction is a large part of
+// executing simple opcodes
+static FORCEINLINE int decodePMachineInstruction(const byte *src, byte &extOpcode, int16 opparams[4]) {
 	uint offset = 0;
 	extOpcode = src[offset++]; // Get "extended" opcode (lower bit has special meaning)
 	const byte opcode = extOpcode >> 1;	// get the actual opcode
+	const OpcodeOperands &operands = g_sci->_opcodeOperands[extOpcode];
 
 	memset(opparams, 0, 4*sizeof(int16));
 
-	for (int i = 0; g_sci->_opcode_formats[opcode][i]; ++i) {
-		//debugN("Opcode: 0x%x, Opnumber: 0x%x, temp: %d\n", opcode, opcode, temp);
-		assert(i < 3);
-		switch (g_sci->_opcode_formats[opcode][i]) {
-
-		case Script_Byte:
+	for (int i = 0; i < operands.count; ++i) {
+		switch (operands.encodings[i]) {
+		case kOperandByte:
 			opparams[i] = src[offset++];
 			break;
-		case Script_SByte:
+		case kOperandSByte:
 			opparams[i] = (int8)src[offset++];
 			break;
-
-		case Script_Word:
+		case kOperandWord:
 			opparams[i] = READ_SCI11ENDIAN_UINT16(src + offset);
 			offset += 2;
 			break;
-		case Script_SWord:
+		case kOperandSWord:
 			opparams[i] = (int16)READ_SCI11ENDIAN_UINT16(src + offset);
 			offset += 2;
 			break;
-
-		case Script_Variable:
-		case Script_Property:
-
-		case Script_Local:
-		case Script_Temp:
-		case Script_Global:
-		case Script_Param:
-
-		case Script_Offset:
-			if (extOpcode & 1) {
-				opparams[i] = src[offset++];
-			} else {
-				opparams[i] = READ_SCI11ENDIAN_UINT16(src + offset);
-				offset += 2;
-			}
+		case kOperandNone:
 			break;
-
-		case Script_SVariable:
-		case Script_SRelative:
-			if (extOpcode & 1) {
-				opparams[i] = (int8)src[offset++];
-			} else {
-				opparams[i] = (int16)READ_SCI11ENDIAN_UINT16(src + offset);
-				offset += 2;
-			}
-			break;
-
-		case Script_None:
-		case Script_End:
-			break;
-
-		case Script_Invalid:
+		case kOperandInvalid:
 		default:
 			error("opcode %02x: Invalid", extOpcode);
 		}
@@ -514,6 +483,64 @@ int readPMachineInstruction(const byte *src, byte &extOpcode, int16 opparams[4])
 	return offset;
 }
 
+int readPMachineInstruction(const byte *src, byte &extOpcode, int16 opparams[4]) {
+	return decodePMachineInstruction(src, extOpcode, opparams);
+}
+
+void initOpcodeOperands(const opcode_format (*formats)[4], OpcodeOperands *operands) {
+	for (int extOpcode = 0; extOpcode < 256; ++extOpcode) {
+		OpcodeOperands &extOperands = operands[extOpcode];
+		const bool byteSized = extOpcode & 1;
+
+		extOperands.count = 0;
+		for (int i = 0; formats[extOpcode >> 1][i]; ++i) {
+			assert(i < 3);
+			OperandEncoding encoding;
+			switch (formats[extOpcode >> 1][i]) {
+			case Script_Byte:
+				encoding = kOperandByte;
+				break;
+			case Script_SByte:
+				encoding = kOperandSByte;
+				break;
+			case Script_Word:
+				encoding = kOperandWord;
+				break;
+			case Script_SWord:
+				encoding = kOperandSWord;
+				break;
+
+			case Script_Variable:
+			case Script_Property:
+
+			case Script_Local:
+			case Script_Temp:
+			case Script_Global:
+			case Script_Param:
+
+			case Script_Offset:
+				encoding = byteSized ? kOperandByte : kOperandWord;
+				break;
+
+			case Script_SVariable:
+			case Script_SRelative:
+				encoding = byteSized ? kOperandSByte : kOperandSWord;
+				break;
+
+			case Script_End:
+				encoding = kOperandNone;
+				break;
+
+			case Script_Invalid:
+			default:
+				encoding = kOperandInvalid;
+				break;
+			}
+			extOperands.encodings[extOperands.count++] = encoding;
+		}
+	}
+}
+
 uint32 findOffset(const int16 relOffset, const Script *scr, const uint32 pcOffset) {
 	uint32 offset;
 
@@ -626,7 +653,7 @@ void run_vm(EngineState *s) {
 
 		// Get opcode
 		byte extOpcode;
-		s->xs->addr.pc.incOffset(readPMachineInstruction(scr->getBuf(s->xs->addr.pc.getOffset()), extOpcode, opparams));
+		s->xs->addr.pc.incOffset(decodePMachineInstruction(scr->getBuf(s->xs->addr.pc.getOffset()), extOpcode, opparams));
 		const byte opcode = extOpcode >> 1;
 		//debug("%s: %d, %d, %d, %d, acc = %04x:%04x, script %d, local script %d", opcodeNames[opcode], opparams[0], opparams[1], opparams[2], opparams[3], PRINT_REG(s->r_acc), scr->getScriptNumber(), local_script->getScriptNumber());
 
@@ -330,6 +330,34 @@ enum SciOpcodes {
 
 void script_adjust_opcode_formats();
 
+/**
+ * The encoding of an operand of an "extended" opcode, which follows from the
+ * opcode format of the operand and the low bit of the extended opcode.
+ */
+enum OperandEncoding {
+	kOperandInvalid = 0,
+	kOperandNone,
+	kOperandByte,
+	kOperandSByte,
+	kOperandWord,
+	kOperandSWord
+};
+
+/**
+ * The operands of an "extended" opcode, so that decoding an instruction
+ * does not need to resolve its opcode formats again.
+ */
+struct OpcodeOperands {
+	byte count; ///< number of operands
+	byte encodings[3]; ///< OperandEncoding of each operand
+};
+
+/**
+ * Resolves the opcode formats of all 128 opcodes into the operands of all
+ * 256 "extended" opcodes, as used by readPMachineInstruction().
+ */
+void initOpcodeOperands(const opcode_format (*formats)[4], OpcodeOperands *operands);
+
 /**
  * Executes function pubfunct of the specified script.
  * @param[in] s				The state which is to be executed with
@@ -398,6 +426,88 @@ void run_vm(EngineState *s);
 SelectorType lookupSelector(SegManager *segMan, reg_t obj, Selector selectorid,
 		ObjVarRef *varp, reg_t *fptr);
 
+/**
+ * Caches the results of lookupSelector(), keyed by object definition and
+ * selector.
+ *
+ * Clones keep the position of the object they were cloned from and resolve
+ * selectors exactly like it, so the position of an object identifies the
+ * variable and method tables walked by the lookup. The cached results stay
+ * valid until a script gets loaded or freed, which is when the owning
+ * SegManager flushes the cache.
+ */
+class SelectorLookupCache {
+public:
+	SelectorLookupCache() { flush(); resetStats(); }
+
+	/**
+	 * Finds the cached lookup result of a selector.
+	 * @param[in] objPos		Position of the object definition (Object::getPos())
+	 * @param[in] selectorId	The selector to look up
+	 * @param[out] varIndex		The variable index, if it is a variable selector
+	 * @param[out] func			The method address, if it is a method selector
+	 * @param[out] type			The type of the selector
+	 * @return					true if the result was cached
+	 */
+	bool lookup(reg_t objPos, Selector selectorId, int &varIndex, reg_t &func, SelectorType &type) {
+		const Entry &entry = _entries[getEntryIndex(objPos, selectorId)];
+		if (entry.objPos != objPos || entry.selectorId != selectorId) {
+			_misses++;
+			return false;
+		}
+
+		_hits++;
+		varIndex = entry.varIndex;
+		func = entry.func;
+		type = entry.type;
+		return true;
+	}
+
+	void store(reg_t objPos, Selector selectorId, int varIndex, reg_t func, SelectorType type) {
+		Entry &entry = _entries[getEntryIndex(objPos, selectorId)];
+		entry.objPos = objPos;
+		entry.selectorId = selectorId;
+		entry.varIndex = varIndex;
+		entry.func = func;
+		entry.type = type;
+	}
+
+	/** Drops all the cached results. */
+	void flush();
+
+	void resetStats() { _hits = _misses = _flushes = 0; }
+
+	uint32 getHits() const { return _hits; }
+	uint32 getMisses() const { return _misses; }
+	uint32 getFlushes() const { return _flushes; }
+	uint getUsedEntries() const;
+	uint getSize() const { return kCacheSize; }
+
+private:
+	enum {
+		kCacheSize = 4096 ///< Number of cached results, must be a power of two
+	};
+
+	struct Entry {
+		reg_t objPos; ///< NULL_REG for unused entries
+		Selector selectorId; ///< -1 for unused entries, which no selector matches
+		int varIndex;
+		reg_t func;
+		SelectorType type;
+	};
+
+	static uint getEntryIndex(reg_t objPos, Selector selectorId) {
+		uint32 hash = ((objPos.getSegment() << 16) | objPos.getOffset()) ^ (selectorId * 0x9E3779B1);
+		hash ^= hash >> 15;
+		return hash & (kCacheSize - 1);
+	}
+
+	Entry _entries[kCacheSize];
+	uint32 _hits;
+	uint32 _misses;
+	uint32 _flushes;
+};
+
 /**
  * Read a PMachine instruction from a memory buffer and return its length.
  *
@@ -207,6 +207,7 @@ Resource::Resource(ResourceManager *resMan, ResourceId id) : SciSpan<const byte>
 	_fileOffset = 0;
 	_status = kResStatusNoMalloc;
 	_lockers = 0;
+	_isPrefetched = false;
 	_source = nullptr;
 	_header = nullptr;
 	_headerSize = 0;
@@ -1005,10 +1006,12 @@ ResourceManager::ResourceManager(const bool detectionMode) :
 	_detectionMode(detectionMode) {}
 
 void ResourceManager::init() {
-	_maxMemoryLRU = 256 * 1024; // 256KiB
+	_LRU.setMaxMemory(256 * 1024); // 256KiB
 	_memoryLocked = 0;
-	_memoryLRU = 0;
+	_memoryAudioLRU = 0;
+	_memoryPrefetched = 0;
 	_LRU.clear();
+	_prefetchQueue.clear();
 	_resMap.clear();
 	_audioMapSCI1 = nullptr;
 #ifdef ENABLE_SCI32
@@ -1079,7 +1082,7 @@ void ResourceManager::init() {
 	// cache, leading to constant decompression of picture resources
 	// and making the renderer very slow.
 	if (getSciVersion() >= SCI_VERSION_2) {
-		_maxMemoryLRU = 4096 * 1024; // 4MiB
+		_LRU.setMaxMemory(4096 * 1024); // 4MiB
 	}
 
 	switch (_viewType) {
@@ -1123,41 +1126,109 @@ ResourceManager::~ResourceManager() {
 	}
 }
 
+static bool isAudioResourceType(ResourceType type) {
+	switch (type) {
+	case kResourceTypeAudio:
+	case kResourceTypeAudio36:
+	case kResourceTypeSync:
+	case kResourceTypeSync36:
+	case kResourceTypeRave:
+		return true;
+	default:
+		return false;
+	}
+}
+
 void ResourceManager::removeFromLRU(Resource *res) {
 	if (res->_status != kResStatusEnqueued) {
 		warning("resMan: trying to remove resource that isn't enqueued");
 		return;
 	}
 	_LRU.remove(res);
-	_memoryLRU -= res->size();
+	if (isAudioResourceType(res->getType()))
+		_memoryAudioLRU -= res->size();
+	if (res->_isPrefetched) {
+		res->_isPrefetched = false;
+		_memoryPrefetched -= res->size();
+	}
 	res->_status = kResStatusAllocated;
 }
 
-void ResourceManager::addToLRU(Resource *res) {
+void ResourceManager::addToLRU(Resource *res, bool reused) {
 	if (res->_status != kResStatusAllocated) {
 		warning("resMan: trying to enqueue resource with state %d", res->_status);
 		return;
 	}
-	_LRU.push_front(res);
-	_memoryLRU += res->size();
+	_LRU.push(res, reused);
+	if (isAudioResourceType(res->getType()))
+		_memoryAudioLRU += res->size();
 #ifdef SCI_VERBOSE_RESMAN
 	debug("Adding %s (%d bytes) to lru control: %d bytes total",
 	      res->_id.toString().c_str(), res->size,
-	      _memoryLRU);
+	      _LRU.getMemory());
 #endif
 	res->_status = kResStatusEnqueued;
 }
 
-void ResourceManager::freeOldResources() {
-	while (_maxMemoryLRU < _memoryLRU) {
-		assert(!_LRU.empty());
-		Resource *goner = _LRU.back();
-		removeFromLRU(goner);
-		goner->unalloc();
+void ResourceManager::freeResource(Resource *res) {
+	removeFromLRU(res);
+	res->unalloc();
 #ifdef SCI_VERBOSE_RESMAN
-		debug("resMan-debug: LRU: Freeing %s (%d bytes)", goner->_id.toString().c_str(), goner->size);
+	debug("resMan-debug: LRU: Freeing %s (%d bytes)", res->_id.toString().c_str(), res->size);
 #endif
+}
+
+void ResourceManager::freeOldResources() {
+	// Audio is mostly played only once, so do not let it take over the LRU.
+	// Audio is the only kind of resource with a budget of its own, all other
+	// resources share the whole LRU.
+	while (_memoryAudioLRU > _LRU.getMaxMemory() / 4) {
+		Resource *goner = _LRU.findLeastRecentlyUsed([](const Resource *res) {
+			return isAudioResourceType(res->getType());
+		});
+		assert(goner);
+		freeResource(goner);
+	}
+
+	while (_LRU.isOverBudget()) {
+		assert(!_LRU.empty());
+		freeResource(_LRU.leastRecentlyUsed());
+	}
+}
+
+void ResourceManager::prefetchResource(ResourceId id) {
+	// Keep the queue short, so that it only holds resources that are
+	// likely to be used soon
+	if (_prefetchQueue.size() >= 64)
+		_prefetchQueue.pop_front();
+	_prefetchQueue.push_back(id);
+}
+
+bool ResourceManager::prefetchNextResource() {
+	// Prefetched resources wait in the probationary segment of the LRU
+	// until they are used. Once they fill its share of the LRU, prefetching
+	// more would only evict other resources that were loaded ahead.
+	if (_memoryPrefetched >= _LRU.getProbationaryBudget())
+		return false;
+
+	while (!_prefetchQueue.empty()) {
+		Resource *res = testResource(_prefetchQueue.front());
+		_prefetchQueue.pop_front();
+
+		if (!res || res->_status != kResStatusNoMalloc)
+			continue;
+
+		loadResource(res);
+		if (res->_status == kResStatusAllocated) {
+			addToLRU(res);
+			res->_isPrefetched = true;
+			_memoryPrefetched += res->size();
+			freeOldResources();
+		}
+		return true;
 	}
+
+	return false;
 }
 
 Common::List<ResourceId> ResourceManager::listResources(ResourceType type, int mapNumber) {
@@ -1196,15 +1267,20 @@ Resource *ResourceManager::findResource(ResourceId id, bool lock) {
 	if (!retval)
 		return nullptr;
 
+	bool reused = false;
 	if (retval->_status == kResStatusNoMalloc)
 		loadResource(retval);
-	else if (retval->_status == kResStatusEnqueued)
+	else if (retval->_status == kResStatusEnqueued) {
 		// The resource is removed from its current position
 		// in the LRU list because it has been requested
 		// again. Below, it will either be locked, or it
-		// will be added back to the LRU list at the 'most
-		// recent' position.
+		// will be added back to the protected segment of
+		// the LRU list at the 'most recent' position. A
+		// prefetched resource is only requested for the
+		// first time now, so it stays in probation.
+		reused = !retval->_isPrefetched;
 		removeFromLRU(retval);
+	}
 
 	// Unless an error occurred, the resource is now either
 	// locked or allocated, but never queued or freed.
@@ -1220,7 +1296,7 @@ Resource *ResourceManager::findResource(ResourceId id, bool lock) {
 		retval->_lockers++;
 	} else if (retval->_status != kResStatusLocked) { // Don't lock it
 		if (retval->_status == kResStatusAllocated)
-			addToLRU(retval);
+			addToLRU(retval, reused);
 	}
 
 	if (retval->data())
@@ -24,10 +24,11 @@
 
 #include "common/str.h"
 #include "common/list.h"
-#include "common/hashmap.h"
+#include "common/flat-hashmap.h"
 
 #include "sci/graphics/helpers.h"		// for ViewType
 #include "sci/resource/decompressor.h"
+#include "sci/resource/resource_lru.h"
 #include "sci/sci.h"
 #include "sci/util.h"
 #include "sci/version.h"
@@ -255,6 +256,7 @@ struct ResourceIdHash : public Common::UnaryFunction<ResourceId, uint> {
 /** Class for storing resources in memory */
 class Resource : public SciSpan<const byte> {
 	friend class ResourceManager;
+	friend class SegmentedLRU<Resource>;
 	friend class ResourcePatcher;
 
 	// FIXME: These 'friend' declarations are meant to be a temporary hack to
@@ -309,6 +311,8 @@ protected:
 	int32 _fileOffset; /**< Offset in file */
 	ResourceStatus _status;
 	uint16 _lockers; /**< Number of places where this resource was locked */
+	SegmentedLRUNode<Resource> _lruNode; /**< Position in the LRU list, if enqueued */
+	bool _isPrefetched; /**< Whether the resource was prefetched and is enqueued without having been requested yet */
 	ResourceSource *_source;
 	ResourceManager *_resMan;
 
@@ -321,7 +325,7 @@ protected:
 	int readResourceInfo(ResVersion volVersion, Common::SeekableReadStream *file, uint32 &szPacked, ResourceCompression &compression);
 };
 
-typedef Common::HashMap<ResourceId, Resource *, ResourceIdHash> ResourceMap;
+typedef Common::FlatHashMap<ResourceId, Resource *, ResourceIdHash> ResourceMap;
 
 class IntMapResourceSource;
 class ResourceManager {
@@ -380,6 +384,19 @@ public:
 	 */
 	void unlockResource(Resource *res);
 
+	/**
+	 * Queues a resource to be loaded ahead of time, when the engine is idle.
+	 * Used for the resources which game scripts announce with kLoad.
+	 * @param id	The resource to load
+	 */
+	void prefetchResource(ResourceId id);
+
+	/**
+	 * Loads the next queued resource that isn't in memory yet.
+	 * @return	false if there was no resource left to load
+	 */
+	bool prefetchNextResource();
+
 	/**
 	 * Tests whether a resource exists.
 	 *
@@ -490,18 +507,20 @@ public:
 protected:
 	bool _detectionMode;
 
-	// Maximum number of bytes to allow being allocated for resources
-	// Note: maxMemory will not be interpreted as a hard limit, only as a restriction
-	// for resources which are not explicitly locked. However, a warning will be
-	// issued whenever this limit is exceeded.
-	int _maxMemoryLRU;
-
 	ViewType _viewType; // Used to determine if the game has EGA or VGA graphics
 	typedef Common::List<ResourceSource *> SourcesList;
 	SourcesList _sources;
 	int _memoryLocked;	///< Amount of resource bytes in locked memory
-	int _memoryLRU;		///< Amount of resource bytes under LRU control
-	Common::List<Resource *> _LRU; ///< Last Resource Used list
+	int _memoryAudioLRU; ///< Amount of audio resource bytes under LRU control
+	int _memoryPrefetched; ///< Amount of bytes of prefetched resources which weren't requested yet
+
+	// Last Resource Used list
+	// Note: its maximum number of bytes will not be interpreted as a hard limit, only as a restriction
+	// for resources which are not explicitly locked. However, a warning will be
+	// issued whenever this limit is exceeded.
+	SegmentedLRU<Resource> _LRU;
+
+	Common::List<ResourceId> _prefetchQueue; ///< Resources to load when the engine is idle
 	ResourceMap _resMap;
 	Common::List<Common::File *> _volumeFiles; ///< list of opened volume files
 	ResourceSource *_audioMapSCI1; ///< Currently loaded audio map for SCI1
@@ -644,8 +663,15 @@ protected:
 	 */
 	bool hasOldScriptHeader();
 
-	void addToLRU(Resource *res);
+	/**
+	 * Enqueues an allocated resource in the LRU.
+	 * @param res		The resource to enqueue
+	 * @param reused	Whether the resource was requested again while
+	 *					enqueued, which puts it in the protected segment
+	 */
+	void addToLRU(Resource *res, bool reused = false);
 	void removeFromLRU(Resource *res);
+	void freeResource(Resource *res);
 
 	ResourceCompression getViewCompression();
 	ViewType detectViewType();
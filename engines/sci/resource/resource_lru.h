@@ -0,0 +1,163 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SCI_RESOURCE_RESOURCE_LRU_H
+#define SCI_RESOURCE_RESOURCE_LRU_H
+
+#include "common/list.h"
+
+namespace Sci {
+
+/**
+ * Where an item is enqueued in a SegmentedLRU. Each item holds its own node,
+ * so that it can be unlinked in constant time.
+ */
+template<class T>
+struct SegmentedLRUNode {
+	typename Common::List<T *>::iterator position;
+	bool isProtected;
+
+	SegmentedLRUNode() : isProtected(false) {}
+};
+
+/**
+ * A Last Resource Used list, split in two segments. Items enter the
+ * probationary segment and move to the protected segment when they are used
+ * again while still enqueued. The probationary segment is evicted first, so
+ * that items which are used only once, like the views and the speech of a
+ * cutscene, cannot flush the items in regular use.
+ *
+ * The protected segment may take up to 3/4 of the memory budget. Beyond that,
+ * its least recently used items get another chance in the probationary
+ * segment.
+ *
+ * T must provide a size() method and a SegmentedLRUNode<T> _lruNode member,
+ * which this class may access.
+ */
+template<class T>
+class SegmentedLRU {
+public:
+	typedef typename Common::List<T *>::const_iterator const_iterator;
+
+	SegmentedLRU() : _maxMemory(0), _memory(0), _memoryProtected(0) {}
+
+	void clear() {
+		_probationary.clear();
+		_protected.clear();
+		_memory = 0;
+		_memoryProtected = 0;
+	}
+
+	void setMaxMemory(int maxMemory) { _maxMemory = maxMemory; }
+	int getMaxMemory() const { return _maxMemory; }
+
+	/** The amount of memory the protected segment may take. */
+	int getProtectedBudget() const { return _maxMemory / 4 * 3; }
+	/** The amount of memory left to the probationary segment at least. */
+	int getProbationaryBudget() const { return _maxMemory - getProtectedBudget(); }
+
+	int getMemory() const { return _memory; }
+	int getProtectedMemory() const { return _memoryProtected; }
+	int getProbationaryMemory() const { return _memory - _memoryProtected; }
+
+	bool empty() const { return _probationary.empty() && _protected.empty(); }
+	bool isOverBudget() const { return _memory > _maxMemory; }
+	bool isProtected(const T *item) const { return item->_lruNode.isProtected; }
+
+	/**
+	 * Enqueues an item at the most recent position.
+	 * @param item		The item to enqueue
+	 * @param reused	Whether the item was used again while enqueued, which
+	 *					puts it in the protected segment
+	 */
+	void push(T *item, bool reused) {
+		SegmentedLRUNode<T> &node = item->_lruNode;
+		if (reused) {
+			_protected.push_front(item);
+			node.position = _protected.begin();
+			_memoryProtected += item->size();
+		} else {
+			_probationary.push_front(item);
+			node.position = _probationary.begin();
+		}
+		node.isProtected = reused;
+		_memory += item->size();
+
+		while (_memoryProtected > getProtectedBudget()) {
+			T *demoted = _protected.back();
+			_protected.pop_back();
+			_memoryProtected -= demoted->size();
+			_probationary.push_front(demoted);
+			demoted->_lruNode.position = _probationary.begin();
+			demoted->_lruNode.isProtected = false;
+		}
+	}
+
+	/** Unlinks an enqueued item. */
+	void remove(T *item) {
+		SegmentedLRUNode<T> &node = item->_lruNode;
+		if (node.isProtected) {
+			_protected.erase(node.position);
+			_memoryProtected -= item->size();
+		} else {
+			_probationary.erase(node.position);
+		}
+		node.isProtected = false;
+		_memory -= item->size();
+	}
+
+	/**
+	 * Returns the item to evict first: the least recently used item of the
+	 * probationary segment, or of the protected segment if the probationary
+	 * one is empty.
+	 */
+	T *leastRecentlyUsed() const {
+		return _probationary.empty() ? _protected.back() : _probationary.back();
+	}
+
+	/**
+	 * Returns the first item matching @p pred, in the order in which the
+	 * items are evicted, or nullptr if there is none.
+	 */
+	template<class Predicate>
+	T *findLeastRecentlyUsed(Predicate pred) const {
+		for (const_iterator it = _probationary.reverse_begin(); it != _probationary.end(); --it) {
+			if (pred(*it))
+				return *it;
+		}
+		for (const_iterator it = _protected.reverse_begin(); it != _protected.end(); --it) {
+			if (pred(*it))
+				return *it;
+		}
+		return nullptr;
+	}
+
+private:
+	Common::List<T *> _probationary; ///< Items used once, most recent first
+	Common::List<T *> _protected; ///< Items used again while enqueued, most recent first
+	int _maxMemory; ///< Memory budget of both segments
+	int _memory; ///< Memory taken by both segments
+	int _memoryProtected; ///< Memory taken by the protected segment
+};
+
+} // End of namespace Sci
+
+#endif // SCI_RESOURCE_RESOURCE_LRU_H
@@ -121,6 +121,7 @@ SciEngine::SciEngine(OSystem *syst, const ADGameDescription *desc, SciGameId gam
 	_features(nullptr),
 	_guestAdditions(nullptr),
 	_opcode_formats(nullptr),
+	_opcodeOperands(nullptr),
 	_debugState(),
 	_speedThrottleDelay(kSpeedThrottleDefaultDelay),
 	_gameDescription(desc),
@@ -258,6 +259,7 @@ SciEngine::~SciEngine() {
 	delete _gamestate;
 
 	delete[] _opcode_formats;
+	delete[] _opcodeOperands;
 
 	delete _scriptPatcher;
 	delete _tts;
@@ -996,7 +998,10 @@ void SciEngine::sleep(uint32 msecs) {
 #endif
 		uint32 time = _system->getMillis();
 		if (time + 10 < wakeUpTime) {
-			_system->delayMillis(10);
+			// Use the idle time to load the resources announced by the game
+			// scripts, if there are any left
+			if (!_resMan->prefetchNextResource())
+				_system->delayMillis(10);
 		} else {
 			if (time < wakeUpTime)
 				_system->delayMillis(wakeUpTime - time);
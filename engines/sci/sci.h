@@ -45,6 +45,7 @@ struct ADGameDescription;
 namespace Sci {
 
 struct EngineState;
+struct OpcodeOperands;
 class Vocabulary;
 class ResourceManager;
 class Kernel;
@@ -340,6 +341,7 @@ public:
 	GuestAdditions *_guestAdditions;
 
 	opcode_format (*_opcode_formats)[4];
+	OpcodeOperands *_opcodeOperands; ///< operands of each "extended" opcode, from _opcode_formats
 
 	DebugState _debugState;
 	uint32 _speedThrottleDelay; // kGameIsRestarting maximum delay
@@ -48,6 +48,7 @@ extern "C" void asmCopy8Col(byte* dst, int dstPitch, const byte* src, int height
 namespace Scumm {
 
 static void blit(byte *dst, int dstPitch, const byte *src, int srcPitch, int w, int h, uint8 bitDepth);
+static bool isTextRowTransparent(const byte *text, int width);
 static void fill(byte *dst, int dstPitch, uint16 color, int w, int h, uint8 bitDepth);
 #ifndef USE_ARM_GFX_ASM
 static void copy8Col(byte *dst, int dstPitch, const byte *src, int height, uint8 bitDepth);
@@ -591,32 +592,48 @@ void ScummEngine::updateDirtyScreen(VirtScreenNumber slot) {
 	if (vs->h == 0)
 		return;
 
-	int i;
-	int w = 8;
-	int start = 0;
+	const int numStrips = _gdi->_numStrips;
+	int i = 0;
+
+	while (i < numStrips) {
+		if (!vs->bdirty[i]) {
+			i++;
+			continue;
+		}
+
+		const int start = i;
+		int top = vs->tdirty[i];
+		int bottom = vs->bdirty[i];
+		int dirtyRows = bottom - top;
+		vs->tdirty[i] = vs->h;
+		vs->bdirty[i] = 0;
+
+		// Coalesce neighboring dirty strips into one bigger rectangle, as long
+		// as this adds no more than a fifth of clean pixels to it. Strips with
+		// matching dirty areas are always merged. Sending fewer rectangles
+		// also keeps the backend from falling back to full screen updates.
+		for (i++; i < numStrips && vs->bdirty[i]; i++) {
+			const int newTop = MIN<int>(top, vs->tdirty[i]);
+			const int newBottom = MAX<int>(bottom, vs->bdirty[i]);
+			const int newDirtyRows = dirtyRows + vs->bdirty[i] - vs->tdirty[i];
+			if ((newBottom - newTop) * (i - start + 1) * 4 > newDirtyRows * 5)
+				break;
 
-	for (i = 0; i < _gdi->_numStrips; i++) {
-		if (vs->bdirty[i]) {
-			const int top = vs->tdirty[i];
-			const int bottom = vs->bdirty[i];
+			top = newTop;
+			bottom = newBottom;
+			dirtyRows = newDirtyRows;
 			vs->tdirty[i] = vs->h;
 			vs->bdirty[i] = 0;
-			if (i != (_gdi->_numStrips - 1) && vs->bdirty[i + 1] == bottom && vs->tdirty[i + 1] == top) {
-				// Simple optimizations: if two or more neighboring strips
-				// form one bigger rectangle, coalesce them.
-				w += 8;
-				continue;
-			}
+		}
+
+		const int w = (i - start) * 8;
 #ifndef DISABLE_TOWNS_DUAL_LAYER_MODE
-			if (_game.platform == Common::kPlatformFMTowns && vs->number == kBannerVirtScreen) {
-				int scl = _textSurfaceMultiplier;
-				towns_drawStripToScreen(vs, start * 8 * scl, (vs->topline + top) * scl, start * 8 * scl, top * scl, w * scl, bottom - top);
-			} else
+		if (_game.platform == Common::kPlatformFMTowns && vs->number == kBannerVirtScreen) {
+			int scl = _textSurfaceMultiplier;
+			towns_drawStripToScreen(vs, start * 8 * scl, (vs->topline + top) * scl, start * 8 * scl, top * scl, w * scl, bottom - top);
+		} else
 #endif
-				drawStripToScreen(vs, start * 8, w, top, bottom);
-			w = 8;
-		}
-		start = i + 1;
+			drawStripToScreen(vs, start * 8, w, top, bottom);
 	}
 }
 
@@ -705,6 +722,14 @@ void ScummEngine::drawStripToScreen(VirtScreen *vs, int x, int width, int top, i
 			byte *dstPtr = _compositeBuf;
 
 			for (int h = 0; h < height * m; ++h) {
+				if (vs->format.bytesPerPixel == 2 && isTextRowTransparent(textPtr, width * m)) {
+					// Nothing to compose, which is always the case for HE games
+					memcpy(dstPtr, srcPtr, width * m * 2);
+					dstPtr += width * m * 2;
+					srcPtr += width * m * 2 + vsPitch;
+					textPtr += _textSurface.pitch;
+					continue;
+				}
 				for (int w = 0; w < width * m; ++w) {
 					uint16 tmp = *textPtr++;
 					if (tmp == CHARSET_MASK_TRANSPARENCY) {
@@ -724,35 +749,42 @@ void ScummEngine::drawStripToScreen(VirtScreen *vs, int x, int width, int top, i
 #ifdef USE_ARM_GFX_ASM
 			asmDrawStripToScreen(height, width, text, src, _compositeBuf, vs->pitch, width, _textSurface.pitch);
 #else
-			// We blit four pixels at a time, for improved performance.
-			const uint32 *src32 = (const uint32 *)src;
-			uint32 *dst32 = (uint32 *)_compositeBuf;
-
-			vsPitch >>= 2;
-
-			const uint32 *text32 = (const uint32 *)text;
-			const int textPitch = (_textSurface.pitch - width * m) >> 2;
-			for (int h = height * m; h > 0; --h) {
-				for (int w = width * m; w > 0; w -= 4) {
-					uint32 temp = *text32++;
-
-					// Generate a byte mask for those text pixels (bytes) with
-					// value CHARSET_MASK_TRANSPARENCY. In the end, each byte
-					// in mask will be either equal to 0x00 or 0xFF.
-					// Doing it this way avoids branches and bytewise operations,
-					// at the cost of readability ;).
-					uint32 mask = temp ^ CHARSET_MASK_TRANSPARENCY_32;
-					mask = (((mask & 0x7f7f7f7f) + 0x7f7f7f7f) | mask) & 0x80808080;
-					mask = ((mask >> 7) + 0x7f7f7f7f) ^ 0x80808080;
-
-					// The following line is equivalent to this code:
-					//   *dst32++ = (*src32++ & mask) | (temp & ~mask);
-					// However, some compilers can generate somewhat better
-					// machine code for this equivalent statement:
-					*dst32++ = ((temp ^ *src32++) & mask) ^ temp;
+#ifdef SCUMMVM_SSE2
+			if (m == 1 && _system->hasFeature(OSystem::kFeatureCpuSSE2)) {
+				drawStripToScreenSSE2(height, width, (const byte *)text, _textSurface.pitch, (const byte *)src, vs->pitch, _compositeBuf);
+			} else
+#endif
+			{
+				// We blit four pixels at a time, for improved performance.
+				const uint32 *src32 = (const uint32 *)src;
+				uint32 *dst32 = (uint32 *)_compositeBuf;
+
+				vsPitch >>= 2;
+
+				const uint32 *text32 = (const uint32 *)text;
+				const int textPitch = (_textSurface.pitch - width * m) >> 2;
+				for (int h = height * m; h > 0; --h) {
+					for (int w = width * m; w > 0; w -= 4) {
+						uint32 temp = *text32++;
+
+						// Generate a byte mask for those text pixels (bytes) with
+						// value CHARSET_MASK_TRANSPARENCY. In the end, each byte
+						// in mask will be either equal to 0x00 or 0xFF.
+						// Doing it this way avoids branches and bytewise operations,
+						// at the cost of readability ;).
+						uint32 mask = temp ^ CHARSET_MASK_TRANSPARENCY_32;
+						mask = (((mask & 0x7f7f7f7f) + 0x7f7f7f7f) | mask) & 0x80808080;
+						mask = ((mask >> 7) + 0x7f7f7f7f) ^ 0x80808080;
+
+						// The following line is equivalent to this code:
+						//   *dst32++ = (*src32++ & mask) | (temp & ~mask);
+						// However, some compilers can generate somewhat better
+						// machine code for this equivalent statement:
+						*dst32++ = ((temp ^ *src32++) & mask) ^ temp;
+					}
+					src32 += vsPitch;
+					text32 += textPitch;
 				}
-				src32 += vsPitch;
-				text32 += textPitch;
 			}
 #endif
 		}
@@ -1344,6 +1376,16 @@ byte *Gdi::getMaskBuffer(int x, int y, int z) {
 #pragma mark --- Misc ---
 #pragma mark -
 
+static bool isTextRowTransparent(const byte *text, int width) {
+	// The text surface rows are 4-byte aligned and the width is a multiple of 8
+	const uint32 *text32 = (const uint32 *)text;
+	for (int w = width; w > 0; w -= 4) {
+		if (*text32++ != CHARSET_MASK_TRANSPARENCY_32)
+			return false;
+	}
+	return true;
+}
+
 static void blit(byte *dst, int dstPitch, const byte *src, int srcPitch, int w, int h, uint8 bitDepth) {
 	assert(w > 0);
 	assert(h > 0);
@@ -650,6 +650,11 @@ public:
 	inline byte readBits(byte n);
 };
 
+#ifdef SCUMMVM_SSE2
+// Composes the text surface over the game graphics, 8-bit only, width must be a multiple of 8
+void drawStripToScreenSSE2(int height, int width, const byte *text, int textPitch, const byte *src, int srcPitch, byte *dst);
+#endif
+
 } // End of namespace Scumm
 
 #endif
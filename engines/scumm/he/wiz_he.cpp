@@ -1836,6 +1836,88 @@ void Wiz::dwHandleComplexImageDraw(int image, int state, int x, int y, int shado
 		shadowPtr);
 }
 
+WizPxShrdBuffer Wiz::dwGetDecodedImage(int image, int state, int32 flags, const WizRawPixel *optionalColorConversionTable) {
+	// Uncompressed images can be rendered into, and drawing with the palette
+	// of the image has side effects, so these are decoded every time...
+	if (isUncompressedFormatTypeID(getWizCompressionType(image, state)) || (flags & kWRFUsePalette)) {
+		return drawAWizPrim(image, state, 0, 0, 0, 0, 0, 0, kWRFAlloc | flags, 0, optionalColorConversionTable);
+	}
+
+	// Collect everything the decoded image depends on, just like drawAWizPrimEx() does...
+	if (!optionalColorConversionTable && _vm->_game.heversion > 98) {
+		optionalColorConversionTable = (WizRawPixel *)_vm->getHEPaletteSlot(1);
+	}
+
+	const uint32 generation = _vm->_res->getGeneration(rtImage, image);
+	const int transparentColor = _vm->_game.heversion < 95 ? 0x05 : _vm->VAR(_vm->VAR_WIZ_TRANSPARENT_COLOR);
+	const int paletteChangedCounter = (flags & kWRFRemap) ? _vm->_paletteChangedCounter : 0;
+	const bool compareTable = _uses16BitColor && optionalColorConversionTable;
+
+	WizDecodedImage *oldest = &_decodedImages[0];
+	for (int i = 0; i < NUM_DECODED_IMAGES; i++) {
+		WizDecodedImage &entry = _decodedImages[i];
+
+		if (entry.bitmap() && entry.image == image && entry.state == state && entry.flags == flags &&
+			entry.generation == generation && entry.transparentColor == transparentColor &&
+			entry.paletteChangedCounter == paletteChangedCounter &&
+			(!compareTable || !memcmp(entry.conversionTable, optionalColorConversionTable, sizeof(entry.conversionTable)))) {
+			entry.lastUse = ++_decodedImagesClock;
+			return entry.bitmap;
+		}
+
+		if (!entry.bitmap() || (oldest->bitmap() && entry.lastUse < oldest->lastUse)) {
+			oldest = &entry;
+		}
+	}
+
+	WizPxShrdBuffer bitmap = drawAWizPrim(image, state, 0, 0, 0, 0, 0, 0, kWRFAlloc | flags, 0, optionalColorConversionTable);
+	if (!bitmap()) {
+		return bitmap;
+	}
+
+	int32 w, h;
+	getWizImageDim(image, state, w, h);
+	const int32 size = w * h * (_uses16BitColor ? sizeof(WizRawPixel16) : sizeof(WizRawPixel8));
+
+	if (size > DECODED_IMAGES_MAX_SIZE / 4) {
+		return bitmap;
+	}
+
+	// Make room for the new image, least recently used first...
+	_decodedImagesSize -= oldest->size;
+	oldest->bitmap = WizPxShrdBuffer();
+	oldest->size = 0;
+
+	while (_decodedImagesSize + size > DECODED_IMAGES_MAX_SIZE) {
+		WizDecodedImage *victim = nullptr;
+		for (int i = 0; i < NUM_DECODED_IMAGES; i++) {
+			if (_decodedImages[i].bitmap() && (!victim || _decodedImages[i].lastUse < victim->lastUse)) {
+				victim = &_decodedImages[i];
+			}
+		}
+
+		_decodedImagesSize -= victim->size;
+		victim->bitmap = WizPxShrdBuffer();
+		victim->size = 0;
+	}
+
+	oldest->image = image;
+	oldest->state = state;
+	oldest->flags = flags;
+	oldest->generation = generation;
+	oldest->transparentColor = transparentColor;
+	oldest->paletteChangedCounter = paletteChangedCounter;
+	if (compareTable) {
+		memcpy(oldest->conversionTable, optionalColorConversionTable, sizeof(oldest->conversionTable));
+	}
+	oldest->bitmap = bitmap;
+	oldest->size = size;
+	oldest->lastUse = ++_decodedImagesClock;
+	_decodedImagesSize += size;
+
+	return bitmap;
+}
+
 bool Wiz::dwIsMaskCompatibleCompressionType(int compressionType) {
 	return (kWCTTRLE == compressionType) || (kWCTMRLEWithLineSizePrefix == compressionType);
 }
@@ -1952,9 +2034,7 @@ void Wiz::handleRotate90SpecialCase(int image, int state, int x, int y, int shad
 	}
 
 	// Get the image from the basic drawing function...
-	srcBitmap.bufferPtr = drawAWizPrim(
-		image, state, 0, 0, 0, 0, 0, 0, kWRFAlloc,
-		0, optionalColorConversionTable);
+	srcBitmap.bufferPtr = dwGetDecodedImage(image, state, 0, optionalColorConversionTable);
 
 	srcBitmap.bitmapWidth = w;
 	srcBitmap.bitmapHeight = h;
@@ -624,11 +624,27 @@ enum DstSurface {
 
 class ScummEngine_v71he;
 
+// Decompressed and color converted image state, kept for warped and rotated draws
+struct WizDecodedImage {
+	int image = 0;
+	int state = 0;
+	int32 flags = 0;
+	int transparentColor = 0;
+	int paletteChangedCounter = 0;
+	uint32 generation = 0;
+	WizRawPixel16 conversionTable[256] = {};
+	WizPxShrdBuffer bitmap;
+	int32 size = 0;
+	uint32 lastUse = 0;
+};
+
 class Wiz {
 public:
 	enum {
-		NUM_POLYGONS = 200,
-		NUM_IMAGES   = 255
+		NUM_POLYGONS       = 200,
+		NUM_IMAGES         = 255,
+		NUM_DECODED_IMAGES = 32,
+		DECODED_IMAGES_MAX_SIZE = 4 * 1024 * 1024
 	};
 
 	WizBufferElement _wizBuffer[NUM_IMAGES] = {};
@@ -671,6 +687,7 @@ public:
 	int  dwTryToLoadWiz(Common::SeekableReadStream *inFile, const WizImageCommand *params);
 	void dwAltSourceDrawWiz(int maskImage, int maskState, int x, int y, int sourceImage, int sourceState, int32 flags, int paletteNumber, const Common::Rect *optionalClipRect, const WizSimpleBitmap *destBitmapPtr);
 	void dwHandleComplexImageDraw(int image, int state, int x, int y, int shadow, int angle, int scale, const Common::Rect *clipRect, int32 flags, WizSimpleBitmap *optionalBitmapOverride, const WizRawPixel *optionalColorConversionTable);
+	WizPxShrdBuffer dwGetDecodedImage(int image, int state, int32 flags, const WizRawPixel *optionalColorConversionTable);
 	bool dwIsMaskCompatibleCompressionType(int compressionType);
 	bool dwIsUncompressedFormatTypeID(int id);
 	int	 dwGetImageGeneralProperty(int image, int state, int property);
@@ -816,6 +833,10 @@ public:
 private:
 	ScummEngine_v71he *_vm;
 
+	WizDecodedImage _decodedImages[NUM_DECODED_IMAGES];
+	int32 _decodedImagesSize = 0;
+	uint32 _decodedImagesClock = 0;
+
 
 public:
 	/* Drawing Primitives
@@ -91,7 +91,7 @@ bool Wiz::warpDrawWizTo4Points(int image, int state, const WarpWizPoint *dstPoin
 	if ((getWizCompressionType(image, state) != kWCTNone) ||
 		(optionalColorConversionTable != nullptr) || (flags & (kWRFHFlip | kWRFVFlip | kWRFRemap))) {
 
-		srcBitmap.bufferPtr = drawAWizPrim(image, state, 0, 0, 0, 0, 0, 0, kWRFAlloc | flags, 0, optionalColorConversionTable);
+		srcBitmap.bufferPtr = dwGetDecodedImage(image, state, flags, optionalColorConversionTable);
 
 		if (!srcBitmap.bufferPtr()) {
 			return false;
@@ -392,95 +392,96 @@ void Wiz::warpFindMinMaxpoints(WarpWizPoint *minPtr, WarpWizPoint *maxPtr, const
 	*maxPtr = maxPt;
 }
 
-void Wiz::warpProcessDrawSpansA(WizSimpleBitmap *dstBitmap, const WizSimpleBitmap *srcBitmap, const WarpWizOneDrawSpan *drawSpans, int count) {
-	int xStep, yStep, sw, xOffset, yOffset;
-
-	const WizRawPixel8 *src8;
-	const WizRawPixel16 *src16;
+template<typename T>
+static void warpDrawSpan(T *dst, const T *src, int sw, int fracSize, const WarpWizOneDrawSpan *drawSpan) {
+	int xOffset = drawSpan->xSrcOffset;
+	int yOffset = drawSpan->ySrcOffset;
+	const int xStep = drawSpan->xSrcStep;
+	const int yStep = drawSpan->ySrcStep;
 
-	WizRawPixel8 *dst8 = (WizRawPixel8 *)dstBitmap->bufferPtr();
-	WizRawPixel16 *dst16 = (WizRawPixel16 *)dstBitmap->bufferPtr();
+	if (yStep == 0) {
+		// Unrotated span, the whole span comes from the same source row...
+		const T *srcRow = src + sw * (yOffset >> fracSize);
 
-	sw = srcBitmap->bitmapWidth;
+		for (int xCounter = drawSpan->dstWidth; --xCounter >= 0;) {
+			*dst++ = srcRow[xOffset >> fracSize];
+			xOffset += xStep;
+		}
+	} else {
+		for (int xCounter = drawSpan->dstWidth; --xCounter >= 0;) {
+			*dst++ = *(src + (sw * (yOffset >> fracSize)) + (xOffset >> fracSize));
+			xOffset += xStep;
+			yOffset += yStep;
+		}
+	}
+}
 
-	src8 = (WizRawPixel8 *)srcBitmap->bufferPtr();
-	src16 = (WizRawPixel16 *)srcBitmap->bufferPtr();
+template<typename T>
+static void warpDrawSpanTransparent(T *dst, const T *src, int sw, int fracSize, const WarpWizOneDrawSpan *drawSpan, WizRawPixel transparentColor) {
+	int xOffset = drawSpan->xSrcOffset;
+	int yOffset = drawSpan->ySrcOffset;
+	const int xStep = drawSpan->xSrcStep;
+	const int yStep = drawSpan->ySrcStep;
 
-	for (int yCounter = count; --yCounter >= 0;) {
-		if (!_uses16BitColor) {
-			dst8 = (WizRawPixel8 *)dstBitmap->bufferPtr();
-			dst8 += drawSpans->dstOffset;
-		} else {
-			dst16 = (WizRawPixel16 *)dstBitmap->bufferPtr();
-			dst16 += drawSpans->dstOffset;
-		}
+	if (yStep == 0) {
+		// Unrotated span, the whole span comes from the same source row...
+		const T *srcRow = src + sw * (yOffset >> fracSize);
 
-		xOffset = drawSpans->xSrcOffset;
-		yOffset = drawSpans->ySrcOffset;
-		xStep = drawSpans->xSrcStep;
-		yStep = drawSpans->ySrcStep;
+		for (int xCounter = drawSpan->dstWidth; --xCounter >= 0;) {
+			const WizRawPixel srcColor = srcRow[xOffset >> fracSize];
+			if (srcColor != transparentColor) {
+				*dst = (T)srcColor;
+			}
 
-		for (int xCounter = drawSpans->dstWidth; --xCounter >= 0;) {
-			if (!_uses16BitColor) {
-				*dst8++ = *(src8 + (sw * WARP_FROM_FRAC(yOffset)) + WARP_FROM_FRAC(xOffset));
-			} else {
-				*dst16++ = *(src16 + (sw * WARP_FROM_FRAC(yOffset)) + WARP_FROM_FRAC(xOffset));
+			dst++;
+			xOffset += xStep;
+		}
+	} else {
+		for (int xCounter = drawSpan->dstWidth; --xCounter >= 0;) {
+			const WizRawPixel srcColor = *(src + (sw * (yOffset >> fracSize)) + (xOffset >> fracSize));
+			if (srcColor != transparentColor) {
+				*dst = (T)srcColor;
 			}
 
+			dst++;
 			xOffset += xStep;
 			yOffset += yStep;
 		}
-
-		drawSpans++;
 	}
 }
 
-void Wiz::warpProcessDrawSpansTransparent(WizSimpleBitmap *dstBitmap, const WizSimpleBitmap *srcBitmap, const WarpWizOneDrawSpan *drawSpans, int count, WizRawPixel transparentColor) {
-	int xStep, yStep, sw, xOffset, yOffset;
-
-	const WizRawPixel8 *src8 = (WizRawPixel8 *)srcBitmap->bufferPtr();
-	const WizRawPixel16 *src16 = (WizRawPixel16 *)srcBitmap->bufferPtr();
-
-	WizRawPixel8 *dst8 = (WizRawPixel8 *)dstBitmap->bufferPtr();
-	WizRawPixel16 *dst16 = (WizRawPixel16 *)dstBitmap->bufferPtr();
-
-	WizRawPixel srcColor;
-
-	sw = srcBitmap->bitmapWidth;
+void Wiz::warpProcessDrawSpansA(WizSimpleBitmap *dstBitmap, const WizSimpleBitmap *srcBitmap, const WarpWizOneDrawSpan *drawSpans, int count) {
+	const int fracSize = WARP_FRAC_SIZE;
+	const int sw = srcBitmap->bitmapWidth;
 
 	for (int yCounter = count; --yCounter >= 0;) {
 		if (!_uses16BitColor) {
-			dst8 = (WizRawPixel8 *)dstBitmap->bufferPtr();
-			dst8 += drawSpans->dstOffset;
+			warpDrawSpan<WizRawPixel8>(
+				(WizRawPixel8 *)dstBitmap->bufferPtr() + drawSpans->dstOffset,
+				(const WizRawPixel8 *)srcBitmap->bufferPtr(), sw, fracSize, drawSpans);
 		} else {
-			dst16 = (WizRawPixel16 *)dstBitmap->bufferPtr();
-			dst16 += drawSpans->dstOffset;
+			warpDrawSpan<WizRawPixel16>(
+				(WizRawPixel16 *)dstBitmap->bufferPtr() + drawSpans->dstOffset,
+				(const WizRawPixel16 *)srcBitmap->bufferPtr(), sw, fracSize, drawSpans);
 		}
 
-		xOffset = drawSpans->xSrcOffset;
-		yOffset = drawSpans->ySrcOffset;
-		xStep = drawSpans->xSrcStep;
-		yStep = drawSpans->ySrcStep;
+		drawSpans++;
+	}
+}
 
-		for (int xCounter = drawSpans->dstWidth; --xCounter >= 0;) {
-			if (!_uses16BitColor) {
-				srcColor = *(src8 + (sw * WARP_FROM_FRAC(yOffset)) + WARP_FROM_FRAC(xOffset));
-				if (srcColor != transparentColor) {
-					*dst8++ = (WizRawPixel8)srcColor;
-				} else {
-					dst8++;
-				}
-			} else {
-				srcColor = *(src16 + (sw * WARP_FROM_FRAC(yOffset)) + WARP_FROM_FRAC(xOffset));
-				if (srcColor != transparentColor) {
-					*dst16++ = (WizRawPixel16)srcColor;
-				} else {
-					dst16++;
-				}
-			}
+void Wiz::warpProcessDrawSpansTransparent(WizSimpleBitmap *dstBitmap, const WizSimpleBitmap *srcBitmap, const WarpWizOneDrawSpan *drawSpans, int count, WizRawPixel transparentColor) {
+	const int fracSize = WARP_FRAC_SIZE;
+	const int sw = srcBitmap->bitmapWidth;
 
-			xOffset += xStep;
-			yOffset += yStep;
+	for (int yCounter = count; --yCounter >= 0;) {
+		if (!_uses16BitColor) {
+			warpDrawSpanTransparent<WizRawPixel8>(
+				(WizRawPixel8 *)dstBitmap->bufferPtr() + drawSpans->dstOffset,
+				(const WizRawPixel8 *)srcBitmap->bufferPtr(), sw, fracSize, drawSpans, transparentColor);
+		} else {
+			warpDrawSpanTransparent<WizRawPixel16>(
+				(WizRawPixel16 *)dstBitmap->bufferPtr() + drawSpans->dstOffset,
+				(const WizRawPixel16 *)srcBitmap->bufferPtr(), sw, fracSize, drawSpans, transparentColor);
 		}
 
 		drawSpans++;
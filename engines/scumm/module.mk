@@ -145,6 +145,11 @@ MODULE_OBJS += \
 	gfxARM.o
 endif
 
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	gfx_sse2.o
+endif
+
 ifdef ENABLE_HE
 MODULE_OBJS += \
 	he/animation_he.o \
@@ -883,6 +883,7 @@ ResourceManager::Resource::Resource() {
 	_size = 0;
 	_flags = 0;
 	_status = 0;
+	_generation = 0;
 	_roomno = 0;
 	_roomoffs = 0;
 }
@@ -898,6 +899,7 @@ void ResourceManager::Resource::nuke() {
 	_size = 0;
 	_flags = 0;
 	_status &= ~RS_MODIFIED;
+	_generation++;
 }
 
 ResourceManager::ResTypeData::ResTypeData() {
@@ -1053,6 +1055,12 @@ bool ResourceManager::isModified(ResType type, ResId idx) const {
 	return _types[type][idx].isModified();
 }
 
+uint32 ResourceManager::getGeneration(ResType type, ResId idx) const {
+	if (!validateResource("getGeneration", type, idx))
+		return 0;
+	return _types[type][idx].getGeneration();
+}
+
 bool ResourceManager::isOffHeap(ResType type, ResId idx) const {
 	if (!validateResource("isOffHeap", type, idx))
 		return false;
@@ -1069,6 +1077,7 @@ bool ResourceManager::Resource::isOffHeap() const {
 
 void ResourceManager::Resource::setModified() {
 	_status |= RS_MODIFIED;
+	_generation++;
 }
 
 void ResourceManager::Resource::setOffHeap() {
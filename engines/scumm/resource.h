@@ -114,6 +114,12 @@ public:
 		 */
 		byte _status;
 
+		/**
+		 * Incremented whenever the resource is nuked or marked as modified,
+		 * so that data derived from it can be checked for being outdated.
+		 */
+		uint32 _generation;
+
 	public:
 		/**
 		 * The id of the room (resp. the disk) the resource is contained in.
@@ -146,6 +152,7 @@ public:
 		// HE specific
 		void setModified();
 		bool isModified() const;
+		uint32 getGeneration() const { return _generation; }
 		void setOffHeap();
 		void setOnHeap();
 		bool isOffHeap() const;
@@ -205,6 +212,7 @@ public:
 	// HE Specific
 	void setModified(ResType type, ResId idx);
 	bool isModified(ResType type, ResId idx) const;
+	uint32 getGeneration(ResType type, ResId idx) const;
 	void setOffHeap(ResType type, ResId idx);
 	bool isOffHeap(ResType type, ResId idx) const;
 	void setOnHeap(ResType type, ResId idx);
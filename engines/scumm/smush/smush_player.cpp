@@ -21,6 +21,7 @@
 
 #include "common/config-manager.h"
 #include "common/file.h"
+#include "common/memstream.h"
 #include "common/system.h"
 #include "common/util.h"
 #include "common/rect.h"
@@ -234,6 +235,11 @@ SmushPlayer::SmushPlayer(ScummEngine_v7 *scumm, IMuseDigital *imuseDigital, Insa
 	_base = nullptr;
 	_frameBuffer = nullptr;
 	_specialBuffer = nullptr;
+	_prefetchBuffer = nullptr;
+	_prefetchBufferSize = 0;
+	_prefetchPos = -1;
+	_prefetchSize = 0;
+	_playingPrefetched = false;
 
 	_seekPos = -1;
 
@@ -323,6 +329,11 @@ void SmushPlayer::release() {
 	delete _base;
 	_base = nullptr;
 
+	discardPrefetchedFrame();
+	free(_prefetchBuffer);
+	_prefetchBuffer = nullptr;
+	_prefetchBufferSize = 0;
+
 	free(_specialBuffer);
 	_specialBuffer = nullptr;
 
@@ -815,18 +826,33 @@ void SmushPlayer::handleZlibFrameObject(int32 subSize, Common::SeekableReadStrea
 		return;
 	}
 
-	int32 chunkSize = subSize;
-	byte *chunkBuffer = (byte *)malloc(chunkSize);
-	assert(chunkBuffer);
-	b.read(chunkBuffer, chunkSize);
+	// Use the object inflated ahead of time, if there is one
+	const byte *fobjBuffer = nullptr;
+	byte *inflatedBuffer = nullptr;
+	if (_playingPrefetched) {
+		for (uint i = 0; i < _prefetchedObjects.size(); i++) {
+			if (_prefetchedObjects[i].offset == b.pos()) {
+				fobjBuffer = _prefetchedObjects[i].data;
+				break;
+			}
+		}
+	}
 
-	unsigned long decompressedSize = READ_BE_UINT32(chunkBuffer);
-	byte *fobjBuffer = (byte *)malloc(decompressedSize);
-	if (!Common::inflateZlib(fobjBuffer, &decompressedSize, chunkBuffer + 4, chunkSize - 4))
-		error("SmushPlayer::handleZlibFrameObject() Zlib uncompress error");
-	free(chunkBuffer);
+	if (!fobjBuffer) {
+		int32 chunkSize = subSize;
+		byte *chunkBuffer = (byte *)malloc(chunkSize);
+		assert(chunkBuffer);
+		b.read(chunkBuffer, chunkSize);
+
+		unsigned long decompressedSize = READ_BE_UINT32(chunkBuffer);
+		inflatedBuffer = (byte *)malloc(decompressedSize);
+		if (!Common::inflateZlib(inflatedBuffer, &decompressedSize, chunkBuffer + 4, chunkSize - 4))
+			error("SmushPlayer::handleZlibFrameObject() Zlib uncompress error");
+		free(chunkBuffer);
+		fobjBuffer = inflatedBuffer;
+	}
 
-	byte *ptr = fobjBuffer;
+	const byte *ptr = fobjBuffer;
 	int codec = READ_LE_UINT16(ptr); ptr += 2;
 	int left = READ_LE_UINT16(ptr); ptr += 2;
 	int top = READ_LE_UINT16(ptr); ptr += 2;
@@ -835,7 +861,7 @@ void SmushPlayer::handleZlibFrameObject(int32 subSize, Common::SeekableReadStrea
 
 	decodeFrameObject(codec, fobjBuffer + 14, left, top, width, height);
 
-	free(fobjBuffer);
+	free(inflatedBuffer);
 }
 
 void SmushPlayer::handleFrameObject(int32 subSize, Common::SeekableReadStream &b) {
@@ -1026,6 +1052,8 @@ SmushFont *SmushPlayer::getFont(int font) {
 void SmushPlayer::parseNextFrame() {
 
 	if (_seekPos >= 0) {
+		discardPrefetchedFrame();
+
 		if (_seekFile.size() > 0) {
 			delete _base;
 
@@ -1069,35 +1097,110 @@ void SmushPlayer::parseNextFrame() {
 
 	assert(_base);
 
+	if (_prefetchPos >= 0) {
+		// The frame was already read, _base points past it
+		debug(3, "Chunk: FRME at %x (prefetched)", _prefetchPos + 8);
+
+		Common::MemoryReadStream frame(_prefetchBuffer, _prefetchSize);
+		_playingPrefetched = true;
+		handleFrame(_prefetchSize, frame);
+		_playingPrefetched = false;
+		discardPrefetchedFrame();
+	} else {
+		const uint32 subType = _base->readUint32BE();
+		const int32 subSize = _base->readUint32BE();
+		const int32 subOffset = _base->pos();
+
+		if (_base->pos() >= (int32)_baseSize) {
+			_vm->_smushVideoShouldFinish = true;
+			_endOfFile = true;
+			return;
+		}
+
+		debug(3, "Chunk: %s at %x", tag2str(subType), subOffset);
+
+		switch (subType) {
+		case MKTAG('A','H','D','R'): // FT INSANE may seek file to the beginning
+			handleAnimHeader(subSize, *_base);
+			break;
+		case MKTAG('F','R','M','E'):
+			handleFrame(subSize, *_base);
+			break;
+		default:
+			error("Unknown Chunk found at %x: %s, %d", subOffset, tag2str(subType), subSize);
+		}
+
+		_base->seek(subOffset + subSize, SEEK_SET);
+	}
+
+	if (_insanity)
+		_vm->_sound->processSound();
+
+	_vm->_imuseDigital->flushTracks();
+}
+
+void SmushPlayer::prefetchNextFrame() {
+	// Only a single frame is read ahead, and not when seeking elsewhere
+	if (!_base || _prefetchPos >= 0 || _seekPos >= 0 || _endOfFile)
+		return;
+
+	const int32 pos = _base->pos();
 	const uint32 subType = _base->readUint32BE();
 	const int32 subSize = _base->readUint32BE();
-	const int32 subOffset = _base->pos();
 
-	if (_base->pos() >= (int32)_baseSize) {
-		_vm->_smushVideoShouldFinish = true;
-		_endOfFile = true;
+	// Leave anything but a well formed frame to parseNextFrame()
+	if (_base->eos() || subType != MKTAG('F','R','M','E') || pos + 8 >= (int32)_baseSize ||
+		subSize < 0 || pos + 8 + subSize > (int32)_baseSize) {
+		_base->seek(pos, SEEK_SET);
 		return;
 	}
 
-	debug(3, "Chunk: %s at %x", tag2str(subType), subOffset);
+	if (subSize > _prefetchBufferSize) {
+		free(_prefetchBuffer);
+		_prefetchBuffer = (byte *)malloc(subSize);
+		assert(_prefetchBuffer);
+		_prefetchBufferSize = subSize;
+	}
 
-	switch (subType) {
-	case MKTAG('A','H','D','R'): // FT INSANE may seek file to the beginning
-		handleAnimHeader(subSize, *_base);
-		break;
-	case MKTAG('F','R','M','E'):
-		handleFrame(subSize, *_base);
-		break;
-	default:
-		error("Unknown Chunk found at %x: %s, %d", subOffset, tag2str(subType), subSize);
+	if (_base->read(_prefetchBuffer, subSize) != (uint32)subSize) {
+		_base->seek(pos, SEEK_SET);
+		return;
 	}
 
-	_base->seek(subOffset + subSize, SEEK_SET);
+	_prefetchPos = pos;
+	_prefetchSize = subSize;
+
+	// Inflate the compressed frame objects ahead of time as well; decoding
+	// them has to wait, as the codecs work on the previous frame contents
+	int32 offset = 0;
+	while (offset + 8 <= subSize) {
+		const uint32 objType = READ_BE_UINT32(_prefetchBuffer + offset);
+		const int32 objSize = READ_BE_UINT32(_prefetchBuffer + offset + 4);
+		offset += 8;
+		if (objSize < 0 || offset + objSize > subSize)
+			break;
 
-	if (_insanity)
-		_vm->_sound->processSound();
+		if (objType == MKTAG('Z','F','O','B') && objSize >= 4) {
+			PrefetchedObject obj;
+			obj.offset = offset;
+			obj.size = READ_BE_UINT32(_prefetchBuffer + offset);
+			obj.data = (byte *)malloc(obj.size);
+			if (obj.data && Common::inflateZlib(obj.data, &obj.size, _prefetchBuffer + offset + 4, objSize - 4))
+				_prefetchedObjects.push_back(obj);
+			else
+				free(obj.data);
+		}
 
-	_vm->_imuseDigital->flushTracks();
+		offset += objSize + (objSize & 1);
+	}
+}
+
+void SmushPlayer::discardPrefetchedFrame() {
+	for (uint i = 0; i < _prefetchedObjects.size(); i++)
+		free(_prefetchedObjects[i].data);
+	_prefetchedObjects.clear();
+	_prefetchPos = -1;
+	_prefetchSize = 0;
 }
 
 void SmushPlayer::setPalette(const byte *palette) {
@@ -1350,6 +1453,10 @@ void SmushPlayer::play(const char *filename, int32 speed, int32 offset, int32 st
 			_vm->_system->updateScreen();
 		}
 
+		// Read the next frame while waiting for it to be due
+		if (!_paused)
+			prefetchNextFrame();
+
 		_vm->_system->delayMillis(10);
 	}
 
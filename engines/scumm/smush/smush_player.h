@@ -22,6 +22,7 @@
 #if !defined(SCUMM_SMUSH_PLAYER_H) && defined(ENABLE_SCUMM_7_8)
 #define SCUMM_SMUSH_PLAYER_H
 
+#include "common/array.h"
 #include "common/util.h"
 
 namespace Audio {
@@ -138,6 +139,20 @@ private:
 	SmushDeltaGlyphsDecoder *_deltaGlyphsCodec;
 	Common::SeekableReadStream *_base;
 	uint32 _baseSize;
+
+	struct PrefetchedObject {
+		int32 offset; // position of the ZFOB contents in the frame
+		byte *data;
+		unsigned long size;
+	};
+
+	// Next FRME chunk, read and inflated while waiting for it to be due
+	byte *_prefetchBuffer;
+	int32 _prefetchBufferSize;
+	int32 _prefetchPos; // position of the chunk in _base, -1 if none
+	int32 _prefetchSize;
+	Common::Array<PrefetchedObject> _prefetchedObjects;
+	bool _playingPrefetched;
 	byte *_frameBuffer;
 	byte *_specialBuffer;
 
@@ -229,6 +244,8 @@ protected:
 private:
 	SmushFont *getFont(int font);
 	void parseNextFrame();
+	void prefetchNextFrame();
+	void discardPrefetchedFrame();
 	void init(int32 spped);
 	void setupAnim(const char *file);
 	void updateScreen();
@@ -136,6 +136,11 @@ void RenderManager::renderSceneToScreen() {
 }
 
 void RenderManager::copyToScreen(const Graphics::Surface &surface, Common::Rect &rect, int16 srcLeft, int16 srcTop) {
+	if (surface.format == _engine->_screenPixelFormat) {
+		_system->copyRectToScreen(surface.getBasePtr(srcLeft, srcTop), surface.pitch, rect.left, rect.top, rect.width(), rect.height());
+		return;
+	}
+
 	// Convert the surface to RGB565, if needed
 	Graphics::Surface *outSurface = surface.convertTo(_engine->_screenPixelFormat);
 	_system->copyRectToScreen(outSurface->getBasePtr(srcLeft, srcTop),
@@ -34,6 +34,9 @@ RenderTable::RenderTable(uint numColumns, uint numRows)
 	assert(numRows != 0 && numColumns != 0);
 
 	_internalBuffer = new Common::Point[numRows * numColumns];
+	_offsetTable = new uint32[numRows * numColumns];
+	for (uint32 i = 0; i < numRows * numColumns; ++i)
+		_offsetTable[i] = i;
 
 	memset(&_panoramaOptions, 0, sizeof(_panoramaOptions));
 	memset(&_tiltOptions, 0, sizeof(_tiltOptions));
@@ -41,6 +44,7 @@ RenderTable::RenderTable(uint numColumns, uint numRows)
 
 RenderTable::~RenderTable() {
 	delete[] _internalBuffer;
+	delete[] _offsetTable;
 }
 
 void RenderTable::setRenderState(RenderState newState) {
@@ -87,42 +91,25 @@ void RenderTable::mutateImage(uint16 *sourceBuffer, uint16 *destBuffer, uint32 d
 	uint32 destOffset = 0;
 
 	for (int16 y = subRect.top; y < subRect.bottom; ++y) {
-		uint32 sourceOffset = y * _numColumns;
+		const uint32 *offsets = _offsetTable + y * _numColumns + subRect.left;
+		uint16 *dest = destBuffer + destOffset;
 
-		for (int16 x = subRect.left; x < subRect.right; ++x) {
-			uint32 normalizedX = x - subRect.left;
-			uint32 index = sourceOffset + x;
-
-			// RenderTable only stores offsets from the original coordinates
-			uint32 sourceYIndex = y + _internalBuffer[index].y;
-			uint32 sourceXIndex = x + _internalBuffer[index].x;
-
-			destBuffer[destOffset + normalizedX] = sourceBuffer[sourceYIndex * _numColumns + sourceXIndex];
-		}
+		for (int16 x = 0; x < subRect.width(); ++x)
+			dest[x] = sourceBuffer[offsets[x]];
 
 		destOffset += destWidth;
 	}
 }
 
 void RenderTable::mutateImage(Graphics::Surface *dstBuf, Graphics::Surface *srcBuf) {
-	uint32 destOffset = 0;
-
-	uint16 *sourceBuffer = (uint16 *)srcBuf->getPixels();
+	const uint16 *sourceBuffer = (const uint16 *)srcBuf->getPixels();
 	uint16 *destBuffer = (uint16 *)dstBuf->getPixels();
 
 	for (int16 y = 0; y < srcBuf->h; ++y) {
-		uint32 sourceOffset = y * _numColumns;
-
-		for (int16 x = 0; x < srcBuf->w; ++x) {
-			uint32 index = sourceOffset + x;
+		const uint32 *offsets = _offsetTable + y * _numColumns;
 
-			// RenderTable only stores offsets from the original coordinates
-			uint32 sourceYIndex = y + _internalBuffer[index].y;
-			uint32 sourceXIndex = x + _internalBuffer[index].x;
-
-			destBuffer[destOffset] = sourceBuffer[sourceYIndex * _numColumns + sourceXIndex];
-			destOffset++;
-		}
+		for (int16 x = 0; x < srcBuf->w; ++x)
+			*destBuffer++ = sourceBuffer[offsets[x]];
 	}
 }
 
@@ -148,6 +135,7 @@ void RenderTable::generatePanoramaLookupTable() {
 			uint32 index = y * _numColumns + x;
 			_internalBuffer[index].x = 0;
 			_internalBuffer[index].y = 0;
+			_offsetTable[index] = index;
 		}
 	}
 
@@ -178,6 +166,7 @@ void RenderTable::generatePanoramaLookupTable() {
 			// Only store the (x,y) offsets instead of the absolute positions
 			_internalBuffer[index].x = xInCylinderCoords - x;
 			_internalBuffer[index].y = yInCylinderCoords - y;
+			_offsetTable[index] = yInCylinderCoords * _numColumns + xInCylinderCoords;
 		}
 	}
 }
@@ -213,6 +202,7 @@ void RenderTable::generateTiltLookupTable() {
 			// Only store the (x,y) offsets instead of the absolute positions
 			_internalBuffer[index].x = xInCylinderCoords - x;
 			_internalBuffer[index].y = yInCylinderCoords - y;
+			_offsetTable[index] = yInCylinderCoords * _numColumns + xInCylinderCoords;
 		}
 	}
 }
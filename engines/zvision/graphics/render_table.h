@@ -42,6 +42,8 @@ public:
 private:
 	uint _numColumns, _numRows;
 	Common::Point *_internalBuffer;
+	// The same mapping as absolute offsets into the source, for rendering
+	uint32 *_offsetTable;
 	RenderState _renderState;
 
 	struct {
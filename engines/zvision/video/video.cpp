@@ -88,6 +88,10 @@ void ZVision::playVideo(Video::VideoDecoder &vid, const Common::Rect &destRect,
 	uint16 finalHeight = dst.height() < _workingWindow.height() ? dst.height() : _workingWindow.height();
 	bool showSubs = (_scriptManager->getStateValue(StateKey_Subtitles) == 1);
 
+	// Decode the next frames while waiting, so that a slow frame does not
+	// make the video stutter
+	vid.setFrameAhead(2);
+
 	_clock.stop();
 	vid.start();
 	_videoIsPlaying = true;
@@ -137,7 +141,7 @@ void ZVision::playVideo(Video::VideoDecoder &vid, const Common::Rect &destRect,
 		// Always update the screen so the mouse continues to render
 		_system->updateScreen();
 
-		_system->delayMillis(vid.getTimeToNextFrame() / 2);
+		vid.delayMillis(vid.getTimeToNextFrame() / 2);
 	}
 
 	_cutscenesKeymap->setEnabled(false);
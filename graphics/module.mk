@@ -97,6 +97,19 @@ MODULE_OBJS += \
 	tinygl/ztriangle.o \
 	tinygl/zblit.o \
 	tinygl/zdirtyrect.o
+
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	tinygl/ztriangle-neon.o
+endif
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	tinygl/ztriangle-sse2.o
+endif
+ifdef SCUMMVM_AVX2
+MODULE_OBJS += \
+	tinygl/ztriangle-avx2.o
+endif
 endif
 
 ifdef USE_ASPECT
@@ -130,11 +143,34 @@ MODULE_OBJS += \
 	scaler/hq3x_i386.o
 endif
 
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	scaler/hq-neon.o
+endif
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	scaler/hq-sse2.o
+endif
+ifdef SCUMMVM_AVX2
+MODULE_OBJS += \
+	scaler/hq-avx2.o
+endif
+
 endif
 
 ifdef USE_EDGE_SCALERS
 MODULE_OBJS += \
 	scaler/edge.o
+
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	scaler/edge-neon.o
+endif
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	scaler/edge-sse2.o
+endif
+
 endif
 
 endif
@@ -146,15 +182,18 @@ endif
 
 ifdef SCUMMVM_NEON
 MODULE_OBJS += \
-	blit/blit-neon.o
+	blit/blit-neon.o \
+	yuv_to_rgb-neon.o
 endif
 ifdef SCUMMVM_SSE2
 MODULE_OBJS += \
-	blit/blit-sse2.o
+	blit/blit-sse2.o \
+	yuv_to_rgb-sse2.o
 endif
 ifdef SCUMMVM_AVX2
 MODULE_OBJS += \
-	blit/blit-avx2.o
+	blit/blit-avx2.o \
+	yuv_to_rgb-avx2.o
 endif
 
 # Include common rules
@@ -0,0 +1,67 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+
+#include "graphics/scaler/edge.h"
+
+#include <arm_neon.h>
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("neon"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+void EdgeScaler::greyscaleDiffsNEON(int16 (*diffs)[8], int32 *scores, const int16 (*bplanes)[9]) {
+	for (int i = 0; i < 3; i++) {
+		const int16 *bptr = bplanes[i];
+
+		// The 8 pixels around the center one
+		const int16x8_t outer = vcombine_s16(vld1_s16(bptr), vld1_s16(bptr + 5));
+		const int16x8_t diff = vsubq_s16(outer, vdupq_n_s16(bptr[4]));
+		vst1q_s16(diffs[i], diff);
+
+		int32x4_t sum = vmull_s16(vget_low_s16(diff), vget_low_s16(diff));
+		sum = vmlal_s16(sum, vget_high_s16(diff), vget_high_s16(diff));
+		int32x2_t sum2 = vadd_s32(vget_low_s32(sum), vget_high_s32(sum));
+		scores[i] = vget_lane_s32(vpadd_s32(sum2, sum2), 0);
+	}
+}
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#endif // SCUMMVM_NEON
@@ -0,0 +1,64 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "graphics/scaler/edge.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+void EdgeScaler::greyscaleDiffsSSE2(int16 (*diffs)[8], int32 *scores, const int16 (*bplanes)[9]) {
+	for (int i = 0; i < 3; i++) {
+		const int16 *bptr = bplanes[i];
+
+		// The 8 pixels around the center one
+		const __m128i outer = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)bptr),
+		                                         _mm_loadl_epi64((const __m128i *)(bptr + 5)));
+		const __m128i diff = _mm_sub_epi16(outer, _mm_set1_epi16(bptr[4]));
+		_mm_storeu_si128((__m128i *)diffs[i], diff);
+
+		__m128i sum = _mm_madd_epi16(diff, diff);
+		sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+		sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+		scores[i] = _mm_cvtsi128_si32(sum);
+	}
+}
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
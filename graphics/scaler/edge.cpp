@@ -305,32 +305,14 @@ uint16 convertTo16Bit(const typename ColorMask::PixelType p) {
 }
 
 
-template<typename ColorMask>
-int16 *EdgeScaler::chooseGreyscale(typename ColorMask::PixelType *pixels) {
+void EdgeScaler::greyscaleDiffsGeneric(int16 (*diffs)[8], int32 *scores, const int16 (*bplanes)[9]) {
 	int i, j;
-	int32 scores[3];
 
 	for (i = 0; i < 3; i++) {
-		int16 *diff_ptr;
-		int16 *bptr;
-		typename ColorMask::PixelType *pptr;
-		int16 *grey_ptr;
-		int16 center;
-		int32 sum_diffs;
-
-		sum_diffs = 0;
-
-		grey_ptr = _greyscaleTable[i];
-
-		/* fill the 9 pixel window with greyscale values */
-		bptr = _bplanes[i];
-		pptr = pixels;
-		for (j = 9; j; --j)
-			*bptr++ = grey_ptr[convertTo16Bit<ColorMask>(*pptr++)];
-		bptr = _bplanes[i];
-
-		center = grey_ptr[convertTo16Bit<ColorMask>(pixels[4])];
-		diff_ptr = _greyscaleDiffs[i];
+		const int16 *bptr = bplanes[i];
+		int16 *diff_ptr = diffs[i];
+		int16 center = bptr[4];
+		int32 sum_diffs = 0;
 
 		/* calculate the delta from center pixel */
 		diff_ptr[0] = bptr[0] - center;
@@ -350,6 +332,32 @@ int16 *EdgeScaler::chooseGreyscale(typename ColorMask::PixelType *pixels) {
 
 		scores[i] = sum_diffs;
 	}
+}
+
+EdgeScaler::GreyscaleDiffsFunc EdgeScaler::greyscaleDiffsFunc = nullptr;
+
+template<typename ColorMask>
+int16 *EdgeScaler::chooseGreyscale(typename ColorMask::PixelType *pixels) {
+	int i, j;
+	int32 scores[3];
+	uint16 colors[9];
+
+	for (j = 0; j < 9; j++)
+		colors[j] = convertTo16Bit<ColorMask>(pixels[j]);
+
+	for (i = 0; i < 3; i++) {
+		int16 *bptr;
+		int16 *grey_ptr;
+
+		grey_ptr = _greyscaleTable[i];
+
+		/* fill the 9 pixel window with greyscale values */
+		bptr = _bplanes[i];
+		for (j = 0; j < 9; j++)
+			bptr[j] = grey_ptr[colors[j]];
+	}
+
+	greyscaleDiffsFunc(_greyscaleDiffs, scores, _bplanes);
 
 	/* choose greyscale with highest score, ties decided in GRB order */
 
@@ -3533,6 +3541,17 @@ void EdgeScaler::initTables(const uint8 *srcPtr, uint32 srcPitch,
 EdgeScaler::EdgeScaler(const Graphics::PixelFormat &format) : SourceScaler(format) {
 	_factor = 2;
 
+	// If no diff function has been selected yet, detect and select
+	if (!greyscaleDiffsFunc) {
+		greyscaleDiffsFunc = greyscaleDiffsGeneric;
+#ifdef SCUMMVM_NEON
+		if (g_system->hasFeature(OSystem::kFeatureCpuNEON)) greyscaleDiffsFunc = greyscaleDiffsNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+		if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) greyscaleDiffsFunc = greyscaleDiffsSSE2;
+#endif
+	}
+
 	initTables(0, 0, 0, 0);
 }
 
@@ -30,6 +30,22 @@ public:
 	uint increaseFactor() override;
 	uint decreaseFactor() override;
 
+	/**
+	 * Calculate the deltas of the 8 outer pixels of each greyscale 3x3
+	 * window from its center pixel, and their sum of squares.
+	 */
+	typedef void (*GreyscaleDiffsFunc)(int16 (*diffs)[8], int32 *scores, const int16 (*bplanes)[9]);
+
+	static void greyscaleDiffsGeneric(int16 (*diffs)[8], int32 *scores, const int16 (*bplanes)[9]);
+#ifdef SCUMMVM_NEON
+	static void greyscaleDiffsNEON(int16 (*diffs)[8], int32 *scores, const int16 (*bplanes)[9]);
+#endif
+#ifdef SCUMMVM_SSE2
+	static void greyscaleDiffsSSE2(int16 (*diffs)[8], int32 *scores, const int16 (*bplanes)[9]);
+#endif
+
+	static GreyscaleDiffsFunc greyscaleDiffsFunc;
+
 protected:
 
 	virtual void internScale(const uint8 *srcPtr, uint32 srcPitch,
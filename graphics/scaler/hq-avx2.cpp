@@ -0,0 +1,77 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "graphics/scaler/hq.h"
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+/**
+ * Check which of eight YUV values differ noticeably from the center ones, and
+ * return the given pattern bit for those. Same as diffYUV, but since all
+ * channels are 8 bits wide, it can work on saturated byte differences.
+ */
+static FORCEINLINE __m256i diffYUV(__m256i yuv5, const uint32 *ptr, int bit) {
+	const __m256i thresholds = _mm256_set1_epi32(0x00300706);
+	const __m256i other = _mm256_loadu_si256((const __m256i *)ptr);
+	const __m256i diff = _mm256_or_si256(_mm256_subs_epu8(yuv5, other), _mm256_subs_epu8(other, yuv5));
+	const __m256i same = _mm256_cmpeq_epi32(_mm256_subs_epu8(diff, thresholds), _mm256_setzero_si256());
+	return _mm256_andnot_si256(same, _mm256_set1_epi32(bit));
+}
+
+static FORCEINLINE __m256i computePatterns8(const uint32 *above, const uint32 *center, const uint32 *below) {
+	const __m256i yuv5 = _mm256_loadu_si256((const __m256i *)(center + 1));
+	__m256i pattern = _mm256_or_si256(diffYUV(yuv5, above, 0x0001), diffYUV(yuv5, above + 1, 0x0002));
+	pattern = _mm256_or_si256(pattern, diffYUV(yuv5, above + 2, 0x0004));
+	pattern = _mm256_or_si256(pattern, diffYUV(yuv5, center, 0x0008));
+	pattern = _mm256_or_si256(pattern, diffYUV(yuv5, center + 2, 0x0010));
+	pattern = _mm256_or_si256(pattern, diffYUV(yuv5, below, 0x0020));
+	pattern = _mm256_or_si256(pattern, diffYUV(yuv5, below + 1, 0x0040));
+	return _mm256_or_si256(pattern, diffYUV(yuv5, below + 2, 0x0080));
+}
+
+void HQScaler::computePatternsAVX2(uint8 *patterns, const uint32 *above, const uint32 *center, const uint32 *below, int width) {
+	int i = 0;
+	for (; i + 16 <= width; i += 16) {
+		const __m256i lo = computePatterns8(above + i, center + i, below + i);
+		const __m256i hi = computePatterns8(above + i + 8, center + i + 8, below + i + 8);
+		// The packs work within 128-bit lanes, put the patterns back in order
+		__m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(lo, hi), _MM_SHUFFLE(3, 1, 2, 0));
+		packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(packed, packed), _MM_SHUFFLE(3, 1, 2, 0));
+		_mm_storeu_si128((__m128i *)(patterns + i), _mm256_castsi256_si128(packed));
+	}
+
+	computePatternsGeneric(patterns + i, above + i, center + i, below + i, width - i);
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
@@ -0,0 +1,86 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+
+#include "graphics/scaler/hq.h"
+
+#include <arm_neon.h>
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("neon"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+/**
+ * Check which of four YUV values differ noticeably from the center ones, and
+ * return the given pattern bit for those. Same as diffYUV, but since all
+ * channels are 8 bits wide, it can work on byte differences.
+ */
+static FORCEINLINE uint32x4_t diffYUV(uint8x16_t yuv5, const uint32 *ptr, uint32 bit) {
+	const uint8x16_t thresholds = vreinterpretq_u8_u32(vdupq_n_u32(0x00300706));
+	const uint8x16_t diff = vabdq_u8(yuv5, vreinterpretq_u8_u32(vld1q_u32(ptr)));
+	const uint32x4_t same = vceqq_u32(vreinterpretq_u32_u8(vqsubq_u8(diff, thresholds)), vdupq_n_u32(0));
+	return vbicq_u32(vdupq_n_u32(bit), same);
+}
+
+static FORCEINLINE uint16x4_t computePatterns4(const uint32 *above, const uint32 *center, const uint32 *below) {
+	const uint8x16_t yuv5 = vreinterpretq_u8_u32(vld1q_u32(center + 1));
+	uint32x4_t pattern = vorrq_u32(diffYUV(yuv5, above, 0x0001), diffYUV(yuv5, above + 1, 0x0002));
+	pattern = vorrq_u32(pattern, diffYUV(yuv5, above + 2, 0x0004));
+	pattern = vorrq_u32(pattern, diffYUV(yuv5, center, 0x0008));
+	pattern = vorrq_u32(pattern, diffYUV(yuv5, center + 2, 0x0010));
+	pattern = vorrq_u32(pattern, diffYUV(yuv5, below, 0x0020));
+	pattern = vorrq_u32(pattern, diffYUV(yuv5, below + 1, 0x0040));
+	pattern = vorrq_u32(pattern, diffYUV(yuv5, below + 2, 0x0080));
+	return vmovn_u32(pattern);
+}
+
+void HQScaler::computePatternsNEON(uint8 *patterns, const uint32 *above, const uint32 *center, const uint32 *below, int width) {
+	int i = 0;
+	for (; i + 8 <= width; i += 8) {
+		const uint16x4_t lo = computePatterns4(above + i, center + i, below + i);
+		const uint16x4_t hi = computePatterns4(above + i + 4, center + i + 4, below + i + 4);
+		vst1_u8(patterns + i, vmovn_u16(vcombine_u16(lo, hi)));
+	}
+
+	computePatternsGeneric(patterns + i, above + i, center + i, below + i, width - i);
+}
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#endif // SCUMMVM_NEON
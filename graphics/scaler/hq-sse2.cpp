@@ -0,0 +1,83 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "graphics/scaler/hq.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+/**
+ * Check which of four YUV values differ noticeably from the center ones, and
+ * return the given pattern bit for those. Same as diffYUV, but since all
+ * channels are 8 bits wide, it can work on saturated byte differences.
+ */
+static FORCEINLINE __m128i diffYUV(__m128i yuv5, const uint32 *ptr, int bit) {
+	const __m128i thresholds = _mm_set1_epi32(0x00300706);
+	const __m128i other = _mm_loadu_si128((const __m128i *)ptr);
+	const __m128i diff = _mm_or_si128(_mm_subs_epu8(yuv5, other), _mm_subs_epu8(other, yuv5));
+	const __m128i same = _mm_cmpeq_epi32(_mm_subs_epu8(diff, thresholds), _mm_setzero_si128());
+	return _mm_andnot_si128(same, _mm_set1_epi32(bit));
+}
+
+static FORCEINLINE __m128i computePatterns4(const uint32 *above, const uint32 *center, const uint32 *below) {
+	const __m128i yuv5 = _mm_loadu_si128((const __m128i *)(center + 1));
+	__m128i pattern = _mm_or_si128(diffYUV(yuv5, above, 0x0001), diffYUV(yuv5, above + 1, 0x0002));
+	pattern = _mm_or_si128(pattern, diffYUV(yuv5, above + 2, 0x0004));
+	pattern = _mm_or_si128(pattern, diffYUV(yuv5, center, 0x0008));
+	pattern = _mm_or_si128(pattern, diffYUV(yuv5, center + 2, 0x0010));
+	pattern = _mm_or_si128(pattern, diffYUV(yuv5, below, 0x0020));
+	pattern = _mm_or_si128(pattern, diffYUV(yuv5, below + 1, 0x0040));
+	return _mm_or_si128(pattern, diffYUV(yuv5, below + 2, 0x0080));
+}
+
+void HQScaler::computePatternsSSE2(uint8 *patterns, const uint32 *above, const uint32 *center, const uint32 *below, int width) {
+	int i = 0;
+	for (; i + 8 <= width; i += 8) {
+		const __m128i lo = computePatterns4(above + i, center + i, below + i);
+		const __m128i hi = computePatterns4(above + i + 4, center + i + 4, below + i + 4);
+		const __m128i packed = _mm_packs_epi32(lo, hi);
+		_mm_storel_epi64((__m128i *)(patterns + i), _mm_packus_epi16(packed, packed));
+	}
+
+	computePatternsGeneric(patterns + i, above + i, center + i, below + i, width - i);
+}
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
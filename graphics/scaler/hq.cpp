@@ -22,6 +22,8 @@
 #include "graphics/scaler.h"
 #include "graphics/scaler/intern.h"
 
+#include "common/system.h"
+
 // RGB-to-YUV lookup table
 
 #ifdef USE_NASM
@@ -173,7 +175,12 @@ void HQScaler::initLUT(Graphics::PixelFormat format) {
 #define PIXEL11_90	*(q+1+nextlineDst) = interpolate_2_3_3(w5, w6, w8);
 #define PIXEL11_100	*(q+1+nextlineDst) = interpolate_14_1_1(w5, w6, w8);
 
-#define YUV(x)	(sizeof(Pixel) == 2 ? RGBtoYUV[w ## x] : ConvertYUV<ColorMask>(w ## x, RGBtoYUV))
+// The YUV values of the 3x3 window, taken from the converted source rows
+#define YUV(x)	YUV_ ## x
+#define YUV_2	yuvAbove[i + 1]
+#define YUV_4	yuvCenter[i]
+#define YUV_6	yuvCenter[i + 2]
+#define YUV_8	yuvBelow[i + 1]
 
 /**
  * Convert 32 bit RGB values to Yuv
@@ -193,13 +200,43 @@ static inline uint32 ConvertYUV(uint32 x, const uint32 *RGBtoYUV) {
 	return RGBtoYUV[r | g | b];
 }
 
+/**
+ * Convert a row of pixels to YUV.
+ */
+template<typename ColorMask>
+static void convertRowToYUV(uint32 *dst, const typename ColorMask::PixelType *src, int count, const uint32 *RGBtoYUV) {
+	for (int i = 0; i < count; ++i) {
+		if (sizeof(typename ColorMask::PixelType) == 2)
+			dst[i] = RGBtoYUV[src[i]];
+		else
+			dst[i] = ConvertYUV<ColorMask>(src[i], RGBtoYUV);
+	}
+}
+
+void HQScaler::computePatternsGeneric(uint8 *patterns, const uint32 *above, const uint32 *center, const uint32 *below, int width) {
+	for (int i = 0; i < width; ++i) {
+		const int yuv5 = center[i + 1];
+		int pattern = 0;
+		if (diffYUV(yuv5, above[i]))      pattern |= 0x0001;
+		if (diffYUV(yuv5, above[i + 1]))  pattern |= 0x0002;
+		if (diffYUV(yuv5, above[i + 2]))  pattern |= 0x0004;
+		if (diffYUV(yuv5, center[i]))     pattern |= 0x0008;
+		if (diffYUV(yuv5, center[i + 2])) pattern |= 0x0010;
+		if (diffYUV(yuv5, below[i]))      pattern |= 0x0020;
+		if (diffYUV(yuv5, below[i + 1]))  pattern |= 0x0040;
+		if (diffYUV(yuv5, below[i + 2]))  pattern |= 0x0080;
+		patterns[i] = pattern;
+	}
+}
+
 /*
  * The HQ2x high quality 2x graphics filter.
  * Original author Maxim Stepin (https://web.archive.org/web/20090204033742/http://www.hiend3d.com/hq2x.html).
  * Adapted for ScummVM to 16 bit output and optimized by Max Horn.
  */
 template<typename ColorMask>
-static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, const uint32 *RGBtoYUV) {
+static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, const uint32 *RGBtoYUV,
+                                uint32 *yuvRows, uint8 *patterns, HQScaler::PatternFunc computePatterns) {
 	typedef typename ColorMask::PixelType Pixel;
 
 	int w1, w2, w3, w4, w5, w6, w7, w8, w9;
@@ -221,7 +258,19 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 	//	 | w7 | w8 | w9 |
 	//	 +----+----+----+
 
+	// Each source row is converted to YUV once, and the patterns of a whole
+	// row are computed up front. Equal pixels always have equal YUV values,
+	// so the patterns do not need to compare the pixels themselves.
+	uint32 *yuvAbove = yuvRows;
+	uint32 *yuvCenter = yuvAbove + width + 2;
+	uint32 *yuvBelow = yuvCenter + width + 2;
+	convertRowToYUV<ColorMask>(yuvAbove, p - 1 - nextlineSrc, width + 2, RGBtoYUV);
+	convertRowToYUV<ColorMask>(yuvCenter, p - 1, width + 2, RGBtoYUV);
+
 	while (height--) {
+		convertRowToYUV<ColorMask>(yuvBelow, p - 1 + nextlineSrc, width + 2, RGBtoYUV);
+		computePatterns(patterns, yuvAbove, yuvCenter, yuvBelow, width);
+
 		w1 = *(p - 1 - nextlineSrc);
 		w4 = *(p - 1);
 		w7 = *(p - 1 + nextlineSrc);
@@ -230,24 +279,14 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 		w5 = *(p);
 		w8 = *(p + nextlineSrc);
 
-		int tmpWidth = width;
-		while (tmpWidth--) {
+		for (int i = 0; i < width; ++i) {
 			p++;
 
 			w3 = *(p - nextlineSrc);
 			w6 = *(p);
 			w9 = *(p + nextlineSrc);
 
-			int pattern = 0;
-			const int yuv5 = YUV(5);
-			if (w5 != w1 && diffYUV(yuv5, YUV(1))) pattern |= 0x0001;
-			if (w5 != w2 && diffYUV(yuv5, YUV(2))) pattern |= 0x0002;
-			if (w5 != w3 && diffYUV(yuv5, YUV(3))) pattern |= 0x0004;
-			if (w5 != w4 && diffYUV(yuv5, YUV(4))) pattern |= 0x0008;
-			if (w5 != w6 && diffYUV(yuv5, YUV(6))) pattern |= 0x0010;
-			if (w5 != w7 && diffYUV(yuv5, YUV(7))) pattern |= 0x0020;
-			if (w5 != w8 && diffYUV(yuv5, YUV(8))) pattern |= 0x0040;
-			if (w5 != w9 && diffYUV(yuv5, YUV(9))) pattern |= 0x0080;
+			const int pattern = patterns[i];
 
 			switch (pattern) {
 			case 0:
@@ -2053,6 +2092,11 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 		}
 		p += nextlineSrc - width;
 		q += (nextlineDst - width) * 2;
+
+		uint32 *yuvTmp = yuvAbove;
+		yuvAbove = yuvCenter;
+		yuvCenter = yuvBelow;
+		yuvBelow = yuvTmp;
 	}
 }
 
@@ -2116,7 +2160,8 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
  * Adapted for ScummVM to 16 bit output and optimized by Max Horn.
  */
 template<typename ColorMask>
-static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, const uint32 *RGBtoYUV) {
+static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height, const uint32 *RGBtoYUV,
+                                uint32 *yuvRows, uint8 *patterns, HQScaler::PatternFunc computePatterns) {
 	typedef typename ColorMask::PixelType Pixel;
 
 	int  w1, w2, w3, w4, w5, w6, w7, w8, w9;
@@ -2139,7 +2184,19 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 	//	 | w7 | w8 | w9 |
 	//	 +----+----+----+
 
+	// Each source row is converted to YUV once, and the patterns of a whole
+	// row are computed up front. Equal pixels always have equal YUV values,
+	// so the patterns do not need to compare the pixels themselves.
+	uint32 *yuvAbove = yuvRows;
+	uint32 *yuvCenter = yuvAbove + width + 2;
+	uint32 *yuvBelow = yuvCenter + width + 2;
+	convertRowToYUV<ColorMask>(yuvAbove, p - 1 - nextlineSrc, width + 2, RGBtoYUV);
+	convertRowToYUV<ColorMask>(yuvCenter, p - 1, width + 2, RGBtoYUV);
+
 	while (height--) {
+		convertRowToYUV<ColorMask>(yuvBelow, p - 1 + nextlineSrc, width + 2, RGBtoYUV);
+		computePatterns(patterns, yuvAbove, yuvCenter, yuvBelow, width);
+
 		w1 = *(p - 1 - nextlineSrc);
 		w4 = *(p - 1);
 		w7 = *(p - 1 + nextlineSrc);
@@ -2148,24 +2205,14 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 		w5 = *(p);
 		w8 = *(p + nextlineSrc);
 
-		int tmpWidth = width;
-		while (tmpWidth--) {
+		for (int i = 0; i < width; ++i) {
 			p++;
 
 			w3 = *(p - nextlineSrc);
 			w6 = *(p);
 			w9 = *(p + nextlineSrc);
 
-			int pattern = 0;
-			const int yuv5 = YUV(5);
-			if (w5 != w1 && diffYUV(yuv5, YUV(1))) pattern |= 0x0001;
-			if (w5 != w2 && diffYUV(yuv5, YUV(2))) pattern |= 0x0002;
-			if (w5 != w3 && diffYUV(yuv5, YUV(3))) pattern |= 0x0004;
-			if (w5 != w4 && diffYUV(yuv5, YUV(4))) pattern |= 0x0008;
-			if (w5 != w6 && diffYUV(yuv5, YUV(6))) pattern |= 0x0010;
-			if (w5 != w7 && diffYUV(yuv5, YUV(7))) pattern |= 0x0020;
-			if (w5 != w8 && diffYUV(yuv5, YUV(8))) pattern |= 0x0040;
-			if (w5 != w9 && diffYUV(yuv5, YUV(9))) pattern |= 0x0080;
+			const int pattern = patterns[i];
 
 			switch (pattern) {
 			case 0:
@@ -4944,16 +4991,40 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 		}
 		p += nextlineSrc - width;
 		q += (nextlineDst - width) * 3;
+
+		uint32 *yuvTmp = yuvAbove;
+		yuvAbove = yuvCenter;
+		yuvCenter = yuvBelow;
+		yuvBelow = yuvTmp;
 	}
 }
 
+HQScaler::PatternFunc HQScaler::computePatternsFunc = nullptr;
+
 HQScaler::HQScaler(const Graphics::PixelFormat &format) : Scaler(format),
 #ifdef USE_NASM
 	_hqx_params(nullptr),
 #endif
-	_RGBtoYUV(nullptr) {
+	_RGBtoYUV(nullptr),
+	_yuvRows(nullptr),
+	_patterns(nullptr),
+	_rowBufferWidth(0) {
 	_factor = 2;
 
+	// If no pattern function has been selected yet, detect and select
+	if (!computePatternsFunc) {
+		computePatternsFunc = computePatternsGeneric;
+#ifdef SCUMMVM_NEON
+		if (g_system->hasFeature(OSystem::kFeatureCpuNEON)) computePatternsFunc = computePatternsNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+		if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) computePatternsFunc = computePatternsSSE2;
+#endif
+#ifdef SCUMMVM_AVX2
+		if (g_system->hasFeature(OSystem::kFeatureCpuAVX2)) computePatternsFunc = computePatternsAVX2;
+#endif
+	}
+
 	if (format.bytesPerPixel == 2) {
 		initLUT(format);
 	} else {
@@ -4968,6 +5039,8 @@ HQScaler::HQScaler(const Graphics::PixelFormat &format) : Scaler(format),
 HQScaler::~HQScaler() {
 	delete[] _RGBtoYUV;
 	_RGBtoYUV = nullptr;
+	delete[] _yuvRows;
+	delete[] _patterns;
 
 #ifdef USE_NASM
 	delete _hqx_params;
@@ -4987,19 +5060,19 @@ void HQScaler::HQ3x16(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint3
 void HQScaler::HQ2x16(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height) {
 	if (_format.gLoss == 2)
 		HQ2x_implementation<Graphics::ColorMasks<565> >(srcPtr, srcPitch, dstPtr,
-				dstPitch, width, height, _RGBtoYUV);
+				dstPitch, width, height, _RGBtoYUV, _yuvRows, _patterns, computePatternsFunc);
 	else
 		HQ2x_implementation<Graphics::ColorMasks<555> >(srcPtr, srcPitch, dstPtr,
-				dstPitch, width, height, _RGBtoYUV);
+				dstPitch, width, height, _RGBtoYUV, _yuvRows, _patterns, computePatternsFunc);
 }
 
 void HQScaler::HQ3x16(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height) {
 	if (_format.gLoss == 2)
 		HQ3x_implementation<Graphics::ColorMasks<565> >(srcPtr, srcPitch, dstPtr,
-				dstPitch, width, height, _RGBtoYUV);
+				dstPitch, width, height, _RGBtoYUV, _yuvRows, _patterns, computePatternsFunc);
 	else
 		HQ3x_implementation<Graphics::ColorMasks<555> >(srcPtr, srcPitch, dstPtr,
-				dstPitch, width, height, _RGBtoYUV);
+				dstPitch, width, height, _RGBtoYUV, _yuvRows, _patterns, computePatternsFunc);
 }
 #endif
 
@@ -5007,15 +5080,15 @@ void HQScaler::HQ2x32(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint3
 	if (_format.aLoss == 0) {
 		if (_format.aShift == 0) {
 			HQ2x_implementation<Graphics::ColorMasks<-8888> >(srcPtr, srcPitch, dstPtr,
-					dstPitch, width, height, _RGBtoYUV);
+					dstPitch, width, height, _RGBtoYUV, _yuvRows, _patterns, computePatternsFunc);
 		} else {
 			HQ2x_implementation<Graphics::ColorMasks<8888> >(srcPtr, srcPitch, dstPtr,
-					dstPitch, width, height, _RGBtoYUV);
+					dstPitch, width, height, _RGBtoYUV, _yuvRows, _patterns, computePatternsFunc);
 		}
 	} else {
 		assert((_format.rMax() | _format.gMax() | _format.bMax()) <= 0xffffff);
 		HQ2x_implementation<Graphics::ColorMasks<888> >(srcPtr, srcPitch, dstPtr,
-				dstPitch, width, height, _RGBtoYUV);
+				dstPitch, width, height, _RGBtoYUV, _yuvRows, _patterns, computePatternsFunc);
 	}
 }
 
@@ -5023,20 +5096,28 @@ void HQScaler::HQ3x32(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint3
 	if (_format.aLoss == 0) {
 		if (_format.aShift == 0) {
 			HQ3x_implementation<Graphics::ColorMasks<-8888> >(srcPtr, srcPitch, dstPtr,
-					dstPitch, width, height, _RGBtoYUV);
+					dstPitch, width, height, _RGBtoYUV, _yuvRows, _patterns, computePatternsFunc);
 		} else {
 			HQ3x_implementation<Graphics::ColorMasks<8888> >(srcPtr, srcPitch, dstPtr,
-					dstPitch, width, height, _RGBtoYUV);
+					dstPitch, width, height, _RGBtoYUV, _yuvRows, _patterns, computePatternsFunc);
 		}
 	} else {
 		assert((_format.rMax() | _format.gMax() | _format.bMax()) <= 0xffffff);
 		HQ3x_implementation<Graphics::ColorMasks<888> >(srcPtr, srcPitch, dstPtr,
-				dstPitch, width, height, _RGBtoYUV);
+				dstPitch, width, height, _RGBtoYUV, _yuvRows, _patterns, computePatternsFunc);
 	}
 }
 
 void HQScaler::scaleIntern(const uint8 *srcPtr, uint32 srcPitch,
 							uint8 *dstPtr, uint32 dstPitch, int width, int height, int x, int y) {
+	if (width > _rowBufferWidth) {
+		delete[] _yuvRows;
+		delete[] _patterns;
+		_rowBufferWidth = width;
+		_yuvRows = new uint32[3 * (width + 2)];
+		_patterns = new uint8[width];
+	}
+
 	if (_format.bytesPerPixel == 2) {
 		switch (_factor) {
 		case 2:
@@ -33,6 +33,31 @@ public:
 	~HQScaler();
 	uint increaseFactor() override;
 	uint decreaseFactor() override;
+
+	/**
+	 * Compute the hq pattern of each pixel of a row, that is which of its 8
+	 * neighbours differ noticeably from it.
+	 *
+	 * @param patterns Receives one pattern per pixel.
+	 * @param above    YUV values of the row above, starting one pixel to the left.
+	 * @param center   YUV values of the row itself, starting one pixel to the left.
+	 * @param below    YUV values of the row below, starting one pixel to the left.
+	 * @param width    Number of pixels in the row.
+	 */
+	typedef void (*PatternFunc)(uint8 *patterns, const uint32 *above, const uint32 *center, const uint32 *below, int width);
+
+	static void computePatternsGeneric(uint8 *patterns, const uint32 *above, const uint32 *center, const uint32 *below, int width);
+#ifdef SCUMMVM_NEON
+	static void computePatternsNEON(uint8 *patterns, const uint32 *above, const uint32 *center, const uint32 *below, int width);
+#endif
+#ifdef SCUMMVM_SSE2
+	static void computePatternsSSE2(uint8 *patterns, const uint32 *above, const uint32 *center, const uint32 *below, int width);
+#endif
+#ifdef SCUMMVM_AVX2
+	static void computePatternsAVX2(uint8 *patterns, const uint32 *above, const uint32 *center, const uint32 *below, int width);
+#endif
+
+	static PatternFunc computePatternsFunc;
 protected:
 	virtual void scaleIntern(const uint8 *srcPtr, uint32 srcPitch,
 							uint8 *dstPtr, uint32 dstPitch, int width, int height, int x, int y) override;
@@ -44,6 +69,9 @@ protected:
 	inline void HQ3x32(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height);
 
 	uint32 *_RGBtoYUV;
+	uint32 *_yuvRows;
+	uint8 *_patterns;
+	int _rowBufferWidth;
 #ifdef USE_NASM
 	hqx_parameters *_hqx_params;
 #endif
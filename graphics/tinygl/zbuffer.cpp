@@ -56,6 +56,8 @@ FrameBuffer::FrameBuffer(int width, int height, const Graphics::PixelFormat &for
 	_currentTexture = nullptr;
 
 	_clippingEnabled = false;
+
+	initSpanFuncs();
 }
 
 FrameBuffer::~FrameBuffer() {
@@ -373,6 +373,58 @@ private:
 	template <bool kDepthWrite, bool kEnableScissor, bool kStencilEnabled, bool StippleEnabled, bool kDepthTestEnabled>
 	void putPixelDepth(uint *pz, byte *ps, int _a, int x, int y, uint &z, int &dzdx);
 
+	// State handed to the span kernels below. Colours are interpolated in
+	// the same fixed point format as ZBufferPoint and converted to the
+	// frame buffer format through the shifts and losses.
+	struct SpanParams {
+		uint z;
+		int dzdx;
+		uint r, g, b, a;
+		int drdx, dgdx, dbdx, dadx;
+		int depthFunc;
+		bool depthWrite;
+		byte aLoss, rLoss, gLoss, bLoss;
+		byte aShift, rShift, gShift, bShift;
+
+		void advance(int n) {
+			z += dzdx * n;
+			r += drdx * n;
+			g += dgdx * n;
+			b += dbdx * n;
+			a += dadx * n;
+		}
+	};
+
+	// Depth tests count pixels and, for the ones passing, writes the depth
+	// and (if pp is not null) the colour to a 32bpp frame buffer. This is the
+	// whole of putPixelDepth/putPixelNoTexture when no scissor, stencil,
+	// stipple, alpha test, blending or fog is involved.
+	static void fillSpanGeneric(uint32 *pp, uint *pz, int count, const SpanParams &params);
+	// Returns a bit mask of which of the count (at most 32) pixels pass the
+	// depth test.
+	static uint32 depthSpanMaskGeneric(const uint *pz, uint z, int dzdx, int count, int depthFunc);
+#ifdef SCUMMVM_NEON
+	static void fillSpanNEON(uint32 *pp, uint *pz, int count, const SpanParams &params);
+	static uint32 depthSpanMaskNEON(const uint *pz, uint z, int dzdx, int count, int depthFunc);
+#endif
+#ifdef SCUMMVM_SSE2
+	static void fillSpanSSE2(uint32 *pp, uint *pz, int count, const SpanParams &params);
+	static uint32 depthSpanMaskSSE2(const uint *pz, uint z, int dzdx, int count, int depthFunc);
+#endif
+#ifdef SCUMMVM_AVX2
+	static void fillSpanAVX2(uint32 *pp, uint *pz, int count, const SpanParams &params);
+	static uint32 depthSpanMaskAVX2(const uint *pz, uint z, int dzdx, int count, int depthFunc);
+#endif
+
+	typedef void (*FillSpanFunc)(uint32 *, uint *, int, const SpanParams &);
+	typedef uint32 (*DepthSpanMaskFunc)(const uint *, uint, int, int, int);
+	static FillSpanFunc fillSpanFunc;
+	static DepthSpanMaskFunc depthSpanMaskFunc;
+
+	static void initSpanFuncs();
+
+	void initSpanParams(SpanParams &params, uint z, int dzdx, bool depthWrite, bool depthTest);
+
 
 	template <bool kEnableAlphaTest>
 	FORCEINLINE void writePixel(int pixel, int value) {
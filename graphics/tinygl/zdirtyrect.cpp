@@ -111,8 +111,49 @@ static inline void _appendDirtyRectangle(const DrawCall &call, Common::List<Dirt
 		rectangles.push_back(DirtyRectangle(dirty_region, r, g, b));
 }
 
+// Rasterization draw calls are replayed one screen tile at a time, so the
+// color and depth rows they draw to stay in the cache from one draw call to
+// the next. Tiles span the whole width, as triangles are walked by scanline.
+static const int kDrawCallTileHeight = 32;
+
+typedef Common::List<DrawCall *>::const_iterator DrawCallIterator;
+
+static void _executeDrawCallTiles(DrawCallIterator first, DrawCallIterator last, const Common::List<DirtyRectangle> &rectangles,
+                                  Common::Array<Common::Array<DrawCall *> > &tiles) {
+	// Bin each draw call into the tiles its dirty region overlaps.
+	for (DrawCallIterator it = first; it != last; ++it) {
+		Common::Rect drawCallRegion = (*it)->getDirtyRegion();
+		if (drawCallRegion.isEmpty())
+			continue;
+		int firstTile = MAX<int>(drawCallRegion.top, 0) / kDrawCallTileHeight;
+		int lastTile = MIN<int>((drawCallRegion.bottom - 1) / kDrawCallTileHeight, tiles.size() - 1);
+		for (int tile = firstTile; tile <= lastTile; tile++) {
+			tiles[tile].push_back(*it);
+		}
+	}
+
+	// Tiles and dirty rectangles never overlap each other, so each tile only
+	// has to keep the order of its own draw calls.
+	for (uint tile = 0; tile < tiles.size(); tile++) {
+		if (tiles[tile].empty())
+			continue;
+		int tileTop = tile * kDrawCallTileHeight;
+		for (const auto &rect : rectangles) {
+			Common::Rect tileRegion(rect.rectangle.left, MAX<int>(rect.rectangle.top, tileTop),
+			                        rect.rectangle.right, MIN<int>(rect.rectangle.bottom, tileTop + kDrawCallTileHeight));
+			if (tileRegion.isEmpty())
+				continue;
+			for (const auto &drawCall : tiles[tile]) {
+				if (tileRegion.intersects(drawCall->getDirtyRegion())) {
+					drawCall->execute(true, &tileRegion);
+				}
+			}
+		}
+		tiles[tile].clear();
+	}
+}
+
 void GLContext::presentBufferDirtyRects(Common::List<Common::Rect> &dirtyAreas) {
-	typedef Common::List<DrawCall *>::const_iterator DrawCallIterator;
 	typedef Common::List<DirtyRectangle>::iterator RectangleIterator;
 
 	Common::List<DirtyRectangle> rectangles;
@@ -149,32 +190,18 @@ void GLContext::presentBufferDirtyRects(Common::List<Common::Rect> &dirtyAreas)
 	}
 
 	// Merge coalesce dirty rects.
-	bool restartMerge;
-	do {
-		restartMerge = false;
-		for (RectangleIterator it1 = rectangles.begin(); it1 != rectangles.end(); ++it1) {
-			for (RectangleIterator it2 = rectangles.begin(); it2 != rectangles.end();) {
-				if (it1 != it2) {
-					if ((*it1).rectangle.intersects((*it2).rectangle)) {
-						(*it1).rectangle.extend((*it2).rectangle);
-						it2 = rectangles.erase(it2);
-						restartMerge = true;
-					} else {
-						++it2;
-					}
-				} else {
-					++it2;
-				}
-			}
-		}
-	} while(restartMerge);
-
+	// A rectangle only grows while it is the one being merged into, so once it
+	// does not intersect any other rectangle it never has to be visited again.
+	// This keeps the merge quadratic in the number of rectangles, and leaves
+	// no rectangle intersecting, let alone containing, another one.
 	for (RectangleIterator it1 = rectangles.begin(); it1 != rectangles.end(); ++it1) {
-		RectangleIterator it2 = it1;
-		it2++;
+		RectangleIterator it2 = rectangles.begin();
 		while (it2 != rectangles.end()) {
-			if ((*it1).rectangle.contains((*it2).rectangle)) {
-				it2 = rectangles.erase(it2);
+			if (it1 != it2 && (*it1).rectangle.intersects((*it2).rectangle)) {
+				(*it1).rectangle.extend((*it2).rectangle);
+				rectangles.erase(it2);
+				// The grown rectangle may now intersect ones already checked
+				it2 = rectangles.begin();
 			} else {
 				++it2;
 			}
@@ -191,14 +218,30 @@ void GLContext::presentBufferDirtyRects(Common::List<Common::Rect> &dirtyAreas)
 		}
 
 		// Execute draw calls.
-		for (auto &drawCall : _drawCallsQueue) {
-			Common::Rect drawCallRegion = drawCall->getDirtyRegion();
+		_drawCallTiles.resize((renderRect.bottom + kDrawCallTileHeight - 1) / kDrawCallTileHeight);
+		DrawCallIterator it = _drawCallsQueue.begin();
+		while (it != _drawCallsQueue.end()) {
+			// Runs of rasterization draw calls go through the screen tiles.
+			// Scaled and rotated blits are not clipped to the exact pixel,
+			// so blits and clears still cover a whole dirty rectangle at once.
+			if ((*it)->getType() == DrawCall::DrawCall_Rasterization) {
+				DrawCallIterator runEnd = it;
+				while (runEnd != _drawCallsQueue.end() && (*runEnd)->getType() == DrawCall::DrawCall_Rasterization) {
+					++runEnd;
+				}
+				_executeDrawCallTiles(it, runEnd, rectangles, _drawCallTiles);
+				it = runEnd;
+				continue;
+			}
+
+			Common::Rect drawCallRegion = (*it)->getDirtyRegion();
 			for (auto &rect : rectangles) {
 				Common::Rect dirtyRegion = rect.rectangle;
 				if (dirtyRegion.intersects(drawCallRegion)) {
-					drawCall->execute(true, &dirtyRegion);
+					(*it)->execute(true, &dirtyRegion);
 				}
 			}
+			++it;
 		}
 
 		if (_debugRectsEnabled) {
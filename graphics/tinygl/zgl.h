@@ -464,6 +464,7 @@ struct GLContext {
 	// Draw call queue
 	Common::List<DrawCall *> _drawCallsQueue;
 	Common::List<DrawCall *> _previousFrameDrawCallsQueue;
+	Common::Array<Common::Array<DrawCall *> > _drawCallTiles;
 	int _currentAllocatorIndex;
 	LinearAllocator _drawCallAllocator[2];
 	bool _debugRectsEnabled;
@@ -0,0 +1,157 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "graphics/tinygl/zbuffer.h"
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace TinyGL {
+
+static FORCEINLINE __m256i ramp(uint value, int delta) {
+	return _mm256_setr_epi32(value, value + delta, value + 2 * delta, value + 3 * delta,
+	                         value + 4 * delta, value + 5 * delta, value + 6 * delta, value + 7 * delta);
+}
+
+static FORCEINLINE __m256i depthTest(__m256i zSrc, __m256i zDst, int depthFunc) {
+	// There are only signed compares, so flip the sign bits first
+	const __m256i bias = _mm256_set1_epi32((int)0x80000000);
+	const __m256i ones = _mm256_set1_epi32(-1);
+	__m256i src = _mm256_xor_si256(zSrc, bias);
+	__m256i dst = _mm256_xor_si256(zDst, bias);
+
+	switch (depthFunc) {
+	case TGL_LESS:
+		return _mm256_cmpgt_epi32(src, dst);
+	case TGL_EQUAL:
+		return _mm256_cmpeq_epi32(dst, src);
+	case TGL_LEQUAL:
+		return _mm256_xor_si256(_mm256_cmpgt_epi32(dst, src), ones);
+	case TGL_GREATER:
+		return _mm256_cmpgt_epi32(dst, src);
+	case TGL_NOTEQUAL:
+		return _mm256_xor_si256(_mm256_cmpeq_epi32(dst, src), ones);
+	case TGL_GEQUAL:
+		return _mm256_xor_si256(_mm256_cmpgt_epi32(src, dst), ones);
+	case TGL_ALWAYS:
+		return ones;
+	default:
+		return _mm256_setzero_si256();
+	}
+}
+
+static FORCEINLINE __m256i roundDepth(__m256i z) {
+	// Same as (uint)(float)z: both halves convert exactly, so the sum is
+	// rounded only once
+	const __m256 hi = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(z, 16)), _mm256_set1_ps(65536.0f));
+	const __m256 f = _mm256_add_ps(hi, _mm256_cvtepi32_ps(_mm256_and_si256(z, _mm256_set1_epi32(0xFFFF))));
+	// There is only a signed conversion back, so rebias the upper half of the range
+	const __m256 bias = _mm256_set1_ps(2147483648.0f);
+	const __m256i big = _mm256_castps_si256(_mm256_cmp_ps(f, bias, _CMP_GE_OQ));
+	const __m256i low = _mm256_cvttps_epi32(_mm256_sub_ps(f, _mm256_and_ps(_mm256_castsi256_ps(big), bias)));
+	return _mm256_xor_si256(low, _mm256_and_si256(big, _mm256_set1_epi32((int)0x80000000)));
+}
+
+static FORCEINLINE __m256i channel(__m256i value, int bits, byte loss, byte shift) {
+	value = _mm256_and_si256(_mm256_srli_epi32(value, bits - 8), _mm256_set1_epi32(0xFF));
+	return _mm256_sll_epi32(_mm256_srl_epi32(value, _mm_cvtsi32_si128(loss)), _mm_cvtsi32_si128(shift));
+}
+
+void FrameBuffer::fillSpanAVX2(uint32 *pp, uint *pz, int count, const SpanParams &params) {
+	__m256i z = ramp(params.z, params.dzdx);
+	__m256i r = ramp(params.r, params.drdx);
+	__m256i g = ramp(params.g, params.dgdx);
+	__m256i b = ramp(params.b, params.dbdx);
+	__m256i a = ramp(params.a, params.dadx);
+	const __m256i dz = _mm256_set1_epi32(params.dzdx * 8);
+	const __m256i dr = _mm256_set1_epi32(params.drdx * 8);
+	const __m256i dg = _mm256_set1_epi32(params.dgdx * 8);
+	const __m256i db = _mm256_set1_epi32(params.dbdx * 8);
+	const __m256i da = _mm256_set1_epi32(params.dadx * 8);
+
+	int i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256i dst = _mm256_loadu_si256((const __m256i *)(pz + i));
+		__m256i pass = depthTest(z, dst, params.depthFunc);
+		if (_mm256_movemask_epi8(pass)) {
+			if (pp) {
+				if (params.depthWrite) {
+					// writePixel goes through a float for the depth value
+					__m256i zf = roundDepth(z);
+					_mm256_storeu_si256((__m256i *)(pz + i), _mm256_blendv_epi8(dst, zf, pass));
+				}
+				__m256i color = _mm256_or_si256(
+					_mm256_or_si256(channel(a, ZB_POINT_ALPHA_BITS, params.aLoss, params.aShift),
+					                channel(r, ZB_POINT_RED_BITS, params.rLoss, params.rShift)),
+					_mm256_or_si256(channel(g, ZB_POINT_GREEN_BITS, params.gLoss, params.gShift),
+					                channel(b, ZB_POINT_BLUE_BITS, params.bLoss, params.bShift)));
+				__m256i old = _mm256_loadu_si256((const __m256i *)(pp + i));
+				_mm256_storeu_si256((__m256i *)(pp + i), _mm256_blendv_epi8(old, color, pass));
+			} else if (params.depthWrite) {
+				_mm256_storeu_si256((__m256i *)(pz + i), _mm256_blendv_epi8(dst, z, pass));
+			}
+		}
+		z = _mm256_add_epi32(z, dz);
+		r = _mm256_add_epi32(r, dr);
+		g = _mm256_add_epi32(g, dg);
+		b = _mm256_add_epi32(b, db);
+		a = _mm256_add_epi32(a, da);
+	}
+
+	if (i < count) {
+		SpanParams tail = params;
+		tail.advance(i);
+		fillSpanGeneric(pp ? pp + i : nullptr, pz + i, count - i, tail);
+	}
+}
+
+uint32 FrameBuffer::depthSpanMaskAVX2(const uint *pz, uint z, int dzdx, int count, int depthFunc) {
+	__m256i zv = ramp(z, dzdx);
+	const __m256i dz = _mm256_set1_epi32(dzdx * 8);
+	uint32 mask = 0;
+
+	int i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256i pass = depthTest(zv, _mm256_loadu_si256((const __m256i *)(pz + i)), depthFunc);
+		mask |= (uint32)_mm256_movemask_ps(_mm256_castsi256_ps(pass)) << i;
+		zv = _mm256_add_epi32(zv, dz);
+	}
+
+	if (i < count)
+		mask |= depthSpanMaskGeneric(pz + i, z + dzdx * i, dzdx, count - i, depthFunc) << i;
+	return mask;
+}
+
+} // End of namespace TinyGL
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
@@ -0,0 +1,159 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+
+#include "graphics/tinygl/zbuffer.h"
+
+#include <arm_neon.h>
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("neon"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+namespace TinyGL {
+
+static FORCEINLINE uint32x4_t ramp(uint value, int delta) {
+	const uint32 lanes[4] = { value, value + delta, value + 2 * delta, value + 3 * delta };
+	return vld1q_u32(lanes);
+}
+
+static FORCEINLINE bool anyLane(uint32x4_t mask) {
+	uint32x2_t folded = vorr_u32(vget_low_u32(mask), vget_high_u32(mask));
+	return vget_lane_u64(vreinterpret_u64_u32(folded), 0) != 0;
+}
+
+static FORCEINLINE uint32x4_t depthTest(uint32x4_t src, uint32x4_t dst, int depthFunc) {
+	switch (depthFunc) {
+	case TGL_LESS:
+		return vcltq_u32(dst, src);
+	case TGL_EQUAL:
+		return vceqq_u32(dst, src);
+	case TGL_LEQUAL:
+		return vcleq_u32(dst, src);
+	case TGL_GREATER:
+		return vcgtq_u32(dst, src);
+	case TGL_NOTEQUAL:
+		return vmvnq_u32(vceqq_u32(dst, src));
+	case TGL_GEQUAL:
+		return vcgeq_u32(dst, src);
+	case TGL_ALWAYS:
+		return vdupq_n_u32(0xFFFFFFFF);
+	default:
+		return vdupq_n_u32(0);
+	}
+}
+
+static FORCEINLINE uint32x4_t channel(uint32x4_t value, int bits, byte loss, byte shift) {
+	value = vandq_u32(vshlq_u32(value, vdupq_n_s32(8 - bits)), vdupq_n_u32(0xFF));
+	return vshlq_u32(vshlq_u32(value, vdupq_n_s32(-loss)), vdupq_n_s32(shift));
+}
+
+void FrameBuffer::fillSpanNEON(uint32 *pp, uint *pz, int count, const SpanParams &params) {
+	uint32x4_t z = ramp(params.z, params.dzdx);
+	uint32x4_t r = ramp(params.r, params.drdx);
+	uint32x4_t g = ramp(params.g, params.dgdx);
+	uint32x4_t b = ramp(params.b, params.dbdx);
+	uint32x4_t a = ramp(params.a, params.dadx);
+	const uint32x4_t dz = vdupq_n_u32(params.dzdx * 4);
+	const uint32x4_t dr = vdupq_n_u32(params.drdx * 4);
+	const uint32x4_t dg = vdupq_n_u32(params.dgdx * 4);
+	const uint32x4_t db = vdupq_n_u32(params.dbdx * 4);
+	const uint32x4_t da = vdupq_n_u32(params.dadx * 4);
+
+	int i = 0;
+	for (; i + 4 <= count; i += 4) {
+		uint32x4_t dst = vld1q_u32(pz + i);
+		uint32x4_t pass = depthTest(z, dst, params.depthFunc);
+		if (anyLane(pass)) {
+			if (pp) {
+				if (params.depthWrite) {
+					// writePixel goes through a float for the depth value
+					uint32x4_t zf = vcvtq_u32_f32(vcvtq_f32_u32(z));
+					vst1q_u32(pz + i, vbslq_u32(pass, zf, dst));
+				}
+				uint32x4_t color = vorrq_u32(
+					vorrq_u32(channel(a, ZB_POINT_ALPHA_BITS, params.aLoss, params.aShift),
+					          channel(r, ZB_POINT_RED_BITS, params.rLoss, params.rShift)),
+					vorrq_u32(channel(g, ZB_POINT_GREEN_BITS, params.gLoss, params.gShift),
+					          channel(b, ZB_POINT_BLUE_BITS, params.bLoss, params.bShift)));
+				vst1q_u32(pp + i, vbslq_u32(pass, color, vld1q_u32(pp + i)));
+			} else if (params.depthWrite) {
+				vst1q_u32(pz + i, vbslq_u32(pass, z, dst));
+			}
+		}
+		z = vaddq_u32(z, dz);
+		r = vaddq_u32(r, dr);
+		g = vaddq_u32(g, dg);
+		b = vaddq_u32(b, db);
+		a = vaddq_u32(a, da);
+	}
+
+	if (i < count) {
+		SpanParams tail = params;
+		tail.advance(i);
+		fillSpanGeneric(pp ? pp + i : nullptr, pz + i, count - i, tail);
+	}
+}
+
+uint32 FrameBuffer::depthSpanMaskNEON(const uint *pz, uint z, int dzdx, int count, int depthFunc) {
+	static const uint32 kLaneBits[4] = { 1, 2, 4, 8 };
+	const uint32x4_t laneBits = vld1q_u32(kLaneBits);
+	uint32x4_t zv = ramp(z, dzdx);
+	const uint32x4_t dz = vdupq_n_u32(dzdx * 4);
+	uint32 mask = 0;
+
+	int i = 0;
+	for (; i + 4 <= count; i += 4) {
+		uint32x4_t bits = vandq_u32(depthTest(zv, vld1q_u32(pz + i), depthFunc), laneBits);
+		uint32x2_t sum = vpadd_u32(vget_low_u32(bits), vget_high_u32(bits));
+		sum = vpadd_u32(sum, sum);
+		mask |= vget_lane_u32(sum, 0) << i;
+		zv = vaddq_u32(zv, dz);
+	}
+
+	if (i < count)
+		mask |= depthSpanMaskGeneric(pz + i, z + dzdx * i, dzdx, count - i, depthFunc) << i;
+	return mask;
+}
+
+} // End of namespace TinyGL
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#endif // SCUMMVM_NEON
@@ -0,0 +1,168 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "graphics/tinygl/zbuffer.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace TinyGL {
+
+static FORCEINLINE __m128i ramp(uint value, int delta) {
+	return _mm_setr_epi32(value, value + delta, value + 2 * delta, value + 3 * delta);
+}
+
+static FORCEINLINE __m128i select(__m128i mask, __m128i a, __m128i b) {
+	return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+static FORCEINLINE __m128i depthTest(__m128i zSrc, __m128i zDst, int depthFunc) {
+	// There are only signed compares, so flip the sign bits first
+	const __m128i bias = _mm_set1_epi32((int)0x80000000);
+	const __m128i ones = _mm_set1_epi32(-1);
+	__m128i src = _mm_xor_si128(zSrc, bias);
+	__m128i dst = _mm_xor_si128(zDst, bias);
+
+	switch (depthFunc) {
+	case TGL_LESS:
+		return _mm_cmplt_epi32(dst, src);
+	case TGL_EQUAL:
+		return _mm_cmpeq_epi32(dst, src);
+	case TGL_LEQUAL:
+		return _mm_xor_si128(_mm_cmpgt_epi32(dst, src), ones);
+	case TGL_GREATER:
+		return _mm_cmpgt_epi32(dst, src);
+	case TGL_NOTEQUAL:
+		return _mm_xor_si128(_mm_cmpeq_epi32(dst, src), ones);
+	case TGL_GEQUAL:
+		return _mm_xor_si128(_mm_cmplt_epi32(dst, src), ones);
+	case TGL_ALWAYS:
+		return ones;
+	default:
+		return _mm_setzero_si128();
+	}
+}
+
+static FORCEINLINE __m128i roundDepth(__m128i z) {
+	// Same as (uint)(float)z: both halves convert exactly, so the sum is
+	// rounded only once
+	const __m128 hi = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(z, 16)), _mm_set1_ps(65536.0f));
+	const __m128 f = _mm_add_ps(hi, _mm_cvtepi32_ps(_mm_and_si128(z, _mm_set1_epi32(0xFFFF))));
+	// There is only a signed conversion back, so rebias the upper half of the range
+	const __m128 bias = _mm_set1_ps(2147483648.0f);
+	const __m128i big = _mm_castps_si128(_mm_cmpge_ps(f, bias));
+	const __m128i low = _mm_cvttps_epi32(_mm_sub_ps(f, _mm_and_ps(_mm_castsi128_ps(big), bias)));
+	return _mm_xor_si128(low, _mm_and_si128(big, _mm_set1_epi32((int)0x80000000)));
+}
+
+static FORCEINLINE __m128i channel(__m128i value, int bits, byte loss, byte shift) {
+	value = _mm_and_si128(_mm_srli_epi32(value, bits - 8), _mm_set1_epi32(0xFF));
+	return _mm_sll_epi32(_mm_srl_epi32(value, _mm_cvtsi32_si128(loss)), _mm_cvtsi32_si128(shift));
+}
+
+void FrameBuffer::fillSpanSSE2(uint32 *pp, uint *pz, int count, const SpanParams &params) {
+	__m128i z = ramp(params.z, params.dzdx);
+	__m128i r = ramp(params.r, params.drdx);
+	__m128i g = ramp(params.g, params.dgdx);
+	__m128i b = ramp(params.b, params.dbdx);
+	__m128i a = ramp(params.a, params.dadx);
+	const __m128i dz = _mm_set1_epi32(params.dzdx * 4);
+	const __m128i dr = _mm_set1_epi32(params.drdx * 4);
+	const __m128i dg = _mm_set1_epi32(params.dgdx * 4);
+	const __m128i db = _mm_set1_epi32(params.dbdx * 4);
+	const __m128i da = _mm_set1_epi32(params.dadx * 4);
+
+	int i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m128i dst = _mm_loadu_si128((const __m128i *)(pz + i));
+		__m128i pass = depthTest(z, dst, params.depthFunc);
+		if (_mm_movemask_epi8(pass)) {
+			if (pp) {
+				if (params.depthWrite) {
+					// writePixel goes through a float for the depth value
+					__m128i zf = roundDepth(z);
+					_mm_storeu_si128((__m128i *)(pz + i), select(pass, zf, dst));
+				}
+				__m128i color = _mm_or_si128(
+					_mm_or_si128(channel(a, ZB_POINT_ALPHA_BITS, params.aLoss, params.aShift),
+					             channel(r, ZB_POINT_RED_BITS, params.rLoss, params.rShift)),
+					_mm_or_si128(channel(g, ZB_POINT_GREEN_BITS, params.gLoss, params.gShift),
+					             channel(b, ZB_POINT_BLUE_BITS, params.bLoss, params.bShift)));
+				__m128i old = _mm_loadu_si128((const __m128i *)(pp + i));
+				_mm_storeu_si128((__m128i *)(pp + i), select(pass, color, old));
+			} else if (params.depthWrite) {
+				_mm_storeu_si128((__m128i *)(pz + i), select(pass, z, dst));
+			}
+		}
+		z = _mm_add_epi32(z, dz);
+		r = _mm_add_epi32(r, dr);
+		g = _mm_add_epi32(g, dg);
+		b = _mm_add_epi32(b, db);
+		a = _mm_add_epi32(a, da);
+	}
+
+	if (i < count) {
+		SpanParams tail = params;
+		tail.advance(i);
+		fillSpanGeneric(pp ? pp + i : nullptr, pz + i, count - i, tail);
+	}
+}
+
+uint32 FrameBuffer::depthSpanMaskSSE2(const uint *pz, uint z, int dzdx, int count, int depthFunc) {
+	__m128i zv = ramp(z, dzdx);
+	const __m128i dz = _mm_set1_epi32(dzdx * 4);
+	uint32 mask = 0;
+
+	int i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m128i pass = depthTest(zv, _mm_loadu_si128((const __m128i *)(pz + i)), depthFunc);
+		mask |= (uint32)_mm_movemask_ps(_mm_castsi128_ps(pass)) << i;
+		zv = _mm_add_epi32(zv, dz);
+	}
+
+	if (i < count)
+		mask |= depthSpanMaskGeneric(pz + i, z + dzdx * i, dzdx, count - i, depthFunc) << i;
+	return mask;
+}
+
+} // End of namespace TinyGL
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
@@ -26,6 +26,7 @@
  */
 
 #include "common/endian.h"
+#include "common/system.h"
 #include "graphics/tinygl/texelbuffer.h"
 #include "graphics/tinygl/zbuffer.h"
 #include "graphics/tinygl/zgl.h"
@@ -45,6 +46,112 @@ static bool applyStipplePattern(int x, int y, const byte *stipple) {
 	return (stipple[byteIndex] & bitmask);
 }
 
+static FORCEINLINE bool depthPasses(uint zSrc, uint zDst, int depthFunc) {
+	switch (depthFunc) {
+	case TGL_LESS:
+		return zDst < zSrc;
+	case TGL_EQUAL:
+		return zDst == zSrc;
+	case TGL_LEQUAL:
+		return zDst <= zSrc;
+	case TGL_GREATER:
+		return zDst > zSrc;
+	case TGL_NOTEQUAL:
+		return zDst != zSrc;
+	case TGL_GEQUAL:
+		return zDst >= zSrc;
+	case TGL_ALWAYS:
+		return true;
+	default:
+		return false;
+	}
+}
+
+void FrameBuffer::fillSpanGeneric(uint32 *pp, uint *pz, int count, const SpanParams &params) {
+	uint z = params.z;
+	uint r = params.r, g = params.g, b = params.b, a = params.a;
+	for (int i = 0; i < count; i++) {
+		if (depthPasses(z, pz[i], params.depthFunc)) {
+			if (pp) {
+				// writePixel goes through a float for the depth value
+				if (params.depthWrite)
+					pz[i] = (uint)(float)z;
+				byte ca = a >> (ZB_POINT_ALPHA_BITS - 8);
+				byte cr = r >> (ZB_POINT_RED_BITS - 8);
+				byte cg = g >> (ZB_POINT_GREEN_BITS - 8);
+				byte cb = b >> (ZB_POINT_BLUE_BITS - 8);
+				pp[i] = ((ca >> params.aLoss) << params.aShift) |
+				        ((cr >> params.rLoss) << params.rShift) |
+				        ((cg >> params.gLoss) << params.gShift) |
+				        ((cb >> params.bLoss) << params.bShift);
+			} else if (params.depthWrite) {
+				pz[i] = z;
+			}
+		}
+		z += params.dzdx;
+		r += params.drdx;
+		g += params.dgdx;
+		b += params.dbdx;
+		a += params.dadx;
+	}
+}
+
+uint32 FrameBuffer::depthSpanMaskGeneric(const uint *pz, uint z, int dzdx, int count, int depthFunc) {
+	uint32 mask = 0;
+	for (int i = 0; i < count; i++) {
+		if (depthPasses(z, pz[i], depthFunc))
+			mask |= 1U << i;
+		z += dzdx;
+	}
+	return mask;
+}
+
+FrameBuffer::FillSpanFunc FrameBuffer::fillSpanFunc = nullptr;
+FrameBuffer::DepthSpanMaskFunc FrameBuffer::depthSpanMaskFunc = nullptr;
+
+void FrameBuffer::initSpanFuncs() {
+	if (fillSpanFunc)
+		return;
+
+	fillSpanFunc = fillSpanGeneric;
+	depthSpanMaskFunc = depthSpanMaskGeneric;
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON)) {
+		fillSpanFunc = fillSpanNEON;
+		depthSpanMaskFunc = depthSpanMaskNEON;
+	}
+#endif
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) {
+		fillSpanFunc = fillSpanSSE2;
+		depthSpanMaskFunc = depthSpanMaskSSE2;
+	}
+#endif
+#ifdef SCUMMVM_AVX2
+	if (g_system->hasFeature(OSystem::kFeatureCpuAVX2)) {
+		fillSpanFunc = fillSpanAVX2;
+		depthSpanMaskFunc = depthSpanMaskAVX2;
+	}
+#endif
+}
+
+void FrameBuffer::initSpanParams(SpanParams &params, uint z, int dzdx, bool depthWrite, bool depthTest) {
+	params.z = z;
+	params.dzdx = dzdx;
+	params.r = params.g = params.b = params.a = 0;
+	params.drdx = params.dgdx = params.dbdx = params.dadx = 0;
+	params.depthFunc = depthTest ? _depthFunc : TGL_ALWAYS;
+	params.depthWrite = depthWrite;
+	params.aLoss = _pbufFormat.aLoss;
+	params.rLoss = _pbufFormat.rLoss;
+	params.gLoss = _pbufFormat.gLoss;
+	params.bLoss = _pbufFormat.bLoss;
+	params.aShift = _pbufFormat.aShift;
+	params.rShift = _pbufFormat.rShift;
+	params.gShift = _pbufFormat.gShift;
+	params.bShift = _pbufFormat.bShift;
+}
+
 template <bool kDepthWrite, bool kSmoothMode, bool kFogMode, bool kEnableAlphaTest, bool kEnableScissor, bool kEnableBlending, bool kStencilEnabled, bool kStippleEnabled, bool kDepthTestEnabled>
 void FrameBuffer::putPixelNoTexture(int fbOffset, uint *pz, byte *ps, int _a,
                                     int x, int y, uint &z, uint &r, uint &g, uint &b, uint &a,
@@ -232,6 +339,18 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 		p2 = tp;
 	}
 
+	// Dirty rectangles replay draw calls once per screen tile, so skip
+	// triangles that cannot touch any pixel inside the clipping rectangle.
+	// Edges may step one pixel past the vertices, hence the margin.
+	if (kEnableScissor) {
+		if (p2->y < _clipRectangle.top || p0->y >= _clipRectangle.bottom)
+			return;
+		int minX = MIN(p0->x, MIN(p1->x, p2->x));
+		int maxX = MAX(p0->x, MAX(p1->x, p2->x));
+		if (maxX + 1 < _clipRectangle.left || minX - 1 >= _clipRectangle.right)
+			return;
+	}
+
 	// we compute dXdx and dXdy for all interpolated values
 
 	fdx1 = (float)(p1->x - p0->x);
@@ -449,6 +568,13 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 		// we draw all the scan line of the part
 		while (nb_lines > 0) {
 			int x = x1;
+			if (kEnableScissor) {
+				if (y >= _clipRectangle.bottom)
+					return;
+				// Lines above the clipping rectangle only step the edges
+				if (y < _clipRectangle.top)
+					goto nextLine;
+			}
 			if (!kInterpRGB) {
 				int n;
 				uint *pz;
@@ -462,6 +588,32 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 				if (kStencilEnabled) {
 					ps = ps1 + x1;
 				}
+				if (kEnableScissor) {
+					// Only the part of the line inside the clipping rectangle
+					// is drawn, so the pixels need no scissor test
+					n = MIN(n, _clipRectangle.right - 1 - x);
+					int skip = _clipRectangle.left - x;
+					if (skip > 0) {
+						if (kInterpZ) {
+							pz += skip;
+							z += (uint)dzdx * skip;
+						}
+						if (kStencilEnabled) {
+							ps += skip;
+						}
+						n -= skip;
+						x += skip;
+					}
+				}
+				if (!kStencilEnabled) {
+					// Without a stencil buffer, only depth writes have any effect
+					if (kDepthWrite && n >= 0) {
+						SpanParams params;
+						initSpanParams(params, z, dzdx, true, kDepthTestEnabled);
+						fillSpanFunc(nullptr, pz, n + 1, params);
+					}
+					n = -1;
+				}
 				while (n >= 3) {
 					putPixelDepth<kDepthWrite, kEnableScissor, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>(pz, ps, 0, x, y, z, dzdx);
 					putPixelDepth<kDepthWrite, kEnableScissor, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>(pz, ps, 1, x, y, z, dzdx);
@@ -508,15 +660,76 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 				if (kStencilEnabled) {
 					ps = ps1 + x1;
 				}
+				if (kEnableScissor) {
+					// Only the part of the line inside the clipping rectangle
+					// is drawn, so the pixels need no scissor test
+					n = MIN(n, _clipRectangle.right - 1 - x);
+					int skip = _clipRectangle.left - x;
+					if (skip > 0) {
+						pp += skip;
+						if (kInterpZ) {
+							pz += skip;
+							z += (uint)dzdx * skip;
+						}
+						if (kStencilEnabled) {
+							ps += skip;
+						}
+						if (kFogMode) {
+							fog += (uint)dfdx * skip;
+						}
+						if (kSmoothMode) {
+							r += (uint)drdx * skip;
+							g += (uint)dgdx * skip;
+							b += (uint)dbdx * skip;
+							a += (uint)dadx * skip;
+						}
+						n -= skip;
+						x += skip;
+					}
+				}
+				if (!kStencilEnabled && !kStippleEnabled && !kAlphaTestEnabled &&
+				    !kBlendingEnabled && !kFogMode && _pbufBpp == 4) {
+					if (n >= 0) {
+						SpanParams params;
+						initSpanParams(params, z, dzdx, kDepthWrite, kDepthTestEnabled);
+						params.r = r;
+						params.g = g;
+						params.b = b;
+						params.a = a;
+						if (kSmoothMode) {
+							params.drdx = drdx;
+							params.dgdx = dgdx;
+							params.dbdx = dbdx;
+							params.dadx = dadx;
+						}
+						fillSpanFunc((uint32 *)_pbuf + pp, pz, n + 1, params);
+					}
+					n = -1;
+				}
 				while (n >= 3) {
-					putPixelNoTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>
-					                 (pp, pz, ps, 0, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
-					putPixelNoTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>
-					                 (pp, pz, ps, 1, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
-					putPixelNoTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>
-					                 (pp, pz, ps, 2, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
-					putPixelNoTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>
-					                 (pp, pz, ps, 3, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
+					if (kDepthTestEnabled && !kStencilEnabled &&
+					    !depthSpanMaskFunc(pz, z, dzdx, 4, _depthFunc)) {
+						// The whole block is hidden, only step the interpolants
+						z += dzdx * 4;
+						if (kFogMode) {
+							fog += dfdx * 4;
+						}
+						if (kSmoothMode) {
+							r += drdx * 4;
+							g += dgdx * 4;
+							b += dbdx * 4;
+							a += dadx * 4;
+						}
+					} else {
+						putPixelNoTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>
+						                 (pp, pz, ps, 0, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
+						putPixelNoTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>
+						                 (pp, pz, ps, 1, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
+						putPixelNoTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>
+						                 (pp, pz, ps, 2, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
+						putPixelNoTexture<kDepthWrite, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kStippleEnabled, kDepthTestEnabled>
+						                 (pp, pz, ps, 3, x, y, z, r, g, b, a, dzdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
+					}
 					pp += 4;
 					if (kInterpZ) {
 						pz += 4;
@@ -571,6 +784,11 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 				b = b1;
 				a = a1;
 				while (n >= (NB_INTERP - 1)) {
+					if (kEnableScissor && x >= _clipRectangle.right) {
+						// The rest of the line is outside of the clipping rectangle
+						n = -1;
+						break;
+					}
 					{
 						float ss, tt;
 						ss = sz * zinv;
@@ -582,9 +800,25 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 						fz += fndzdx;
 						zinv = (float)(1.0 / fz);
 					}
-					for (int _a = 0; _a < NB_INTERP; _a++) {
-						putPixelTexture<kDepthWrite, kInterpRGB, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kDepthTestEnabled>
-						               (pp, texture, _wrapS, _wrapT, pz, ps, _a, x, y, z, t, s, r, g, b, a, dzdx, dsdx, dtdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
+					if ((kEnableScissor && x + NB_INTERP <= _clipRectangle.left) ||
+					    (kDepthTestEnabled && !kStencilEnabled && !depthSpanMaskFunc(pz, z, dzdx, NB_INTERP, _depthFunc))) {
+						// The whole block is hidden or outside of the clipping
+						// rectangle, skip the texel fetches
+						z += dzdx * NB_INTERP;
+						if (kFogMode) {
+							fog += dfdx * NB_INTERP;
+						}
+						if (kSmoothMode) {
+							a += dadx * NB_INTERP;
+							r += drdx * NB_INTERP;
+							g += dgdx * NB_INTERP;
+							b += dbdx * NB_INTERP;
+						}
+					} else {
+						for (int _a = 0; _a < NB_INTERP; _a++) {
+							putPixelTexture<kDepthWrite, kInterpRGB, kSmoothMode, kFogMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kDepthTestEnabled>
+							               (pp, texture, _wrapS, _wrapT, pz, ps, _a, x, y, z, t, s, r, g, b, a, dzdx, dsdx, dtdx, drdx, dgdx, dbdx, dadx, fog, fog_r, fog_g, fog_b, dfdx);
+						}
 					}
 					pp += NB_INTERP;
 					if (kInterpZ) {
@@ -624,6 +858,7 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 				}
 			}
 
+nextLine:
 			// left edge
 			error += derror;
 			if (error > 0) {
@@ -0,0 +1,119 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "graphics/yuv_to_rgb.h"
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace Graphics {
+
+/**
+ * Add the chroma to sixteen luminance values and clamp the results, scaling
+ * them from the ITU range if needed.
+ */
+template<bool itu>
+static FORCEINLINE __m256i convertComponent(__m256i y, const int16 *chroma, __m128i loss) {
+	__m256i value = _mm256_add_epi16(y, _mm256_loadu_si256((const __m256i *)chroma));
+
+	if (itu) {
+		value = _mm256_min_epi16(_mm256_max_epi16(value, _mm256_set1_epi16(16)), _mm256_set1_epi16(235));
+		// (value - 16) * 255 / 219, which is exact over the whole clamped range
+		value = _mm256_mulhi_epu16(_mm256_slli_epi16(_mm256_sub_epi16(value, _mm256_set1_epi16(16)), 3), _mm256_set1_epi16(9539));
+	} else {
+		value = _mm256_min_epi16(_mm256_max_epi16(value, _mm256_setzero_si256()), _mm256_set1_epi16(255));
+	}
+
+	return _mm256_srl_epi16(value, loss);
+}
+
+static FORCEINLINE __m256i packPixels(__m128i r, __m128i g, __m128i b, __m128i a, __m128i rShift, __m128i gShift, __m128i bShift, __m128i aShift) {
+	const __m256i rg = _mm256_or_si256(_mm256_sll_epi32(_mm256_cvtepu16_epi32(r), rShift), _mm256_sll_epi32(_mm256_cvtepu16_epi32(g), gShift));
+	const __m256i ba = _mm256_or_si256(_mm256_sll_epi32(_mm256_cvtepu16_epi32(b), bShift), _mm256_sll_epi32(_mm256_cvtepu16_epi32(a), aShift));
+	return _mm256_or_si256(rg, ba);
+}
+
+template<int bytesPerPixel, bool itu>
+static void convertRow(byte *dst, const byte *ySrc, const byte *aSrc, const int16 *crR, const int16 *crbG, const int16 *cbB, int width, const YUVToRGBManager::RowParams &params) {
+	const __m128i rLoss = _mm_cvtsi32_si128(params.rLoss);
+	const __m128i gLoss = _mm_cvtsi32_si128(params.gLoss);
+	const __m128i bLoss = _mm_cvtsi32_si128(params.bLoss);
+	const __m128i aLoss = _mm_cvtsi32_si128(params.aLoss);
+	const __m128i rShift = _mm_cvtsi32_si128(params.rShift);
+	const __m128i gShift = _mm_cvtsi32_si128(params.gShift);
+	const __m128i bShift = _mm_cvtsi32_si128(params.bShift);
+	const __m128i aShift = _mm_cvtsi32_si128(params.aShift);
+	const __m256i opaque = _mm256_srl_epi16(_mm256_set1_epi16(0xFF), aLoss);
+
+	int i = 0;
+	for (; i + 16 <= width; i += 16) {
+		const __m256i y = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(ySrc + i)));
+		const __m256i r = convertComponent<itu>(y, crR + i, rLoss);
+		const __m256i g = convertComponent<itu>(y, crbG + i, gLoss);
+		const __m256i b = convertComponent<itu>(y, cbB + i, bLoss);
+		const __m256i a = aSrc ? _mm256_srl_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(aSrc + i))), aLoss) : opaque;
+
+		if (bytesPerPixel == 2) {
+			__m256i pixels = _mm256_or_si256(_mm256_sll_epi16(r, rShift), _mm256_sll_epi16(g, gShift));
+			pixels = _mm256_or_si256(pixels, _mm256_or_si256(_mm256_sll_epi16(b, bShift), _mm256_sll_epi16(a, aShift)));
+			_mm256_storeu_si256((__m256i *)(dst + i * 2), pixels);
+		} else {
+			const __m256i lo = packPixels(_mm256_castsi256_si128(r), _mm256_castsi256_si128(g), _mm256_castsi256_si128(b), _mm256_castsi256_si128(a),
+			                              rShift, gShift, bShift, aShift);
+			const __m256i hi = packPixels(_mm256_extracti128_si256(r, 1), _mm256_extracti128_si256(g, 1), _mm256_extracti128_si256(b, 1), _mm256_extracti128_si256(a, 1),
+			                              rShift, gShift, bShift, aShift);
+			_mm256_storeu_si256((__m256i *)(dst + i * 4), lo);
+			_mm256_storeu_si256((__m256i *)(dst + i * 4 + 32), hi);
+		}
+	}
+
+	YUVToRGBManager::convertRowGeneric(dst + i * bytesPerPixel, ySrc + i, aSrc ? aSrc + i : nullptr, crR + i, crbG + i, cbB + i, width - i, params);
+}
+
+void YUVToRGBManager::convertRowAVX2(byte *dst, const byte *ySrc, const byte *aSrc, const int16 *crR, const int16 *crbG, const int16 *cbB, int width, const RowParams &params) {
+	if (params.bytesPerPixel == 2) {
+		if (params.scale == kScaleITU)
+			convertRow<2, true>(dst, ySrc, aSrc, crR, crbG, cbB, width, params);
+		else
+			convertRow<2, false>(dst, ySrc, aSrc, crR, crbG, cbB, width, params);
+	} else {
+		if (params.scale == kScaleITU)
+			convertRow<4, true>(dst, ySrc, aSrc, crR, crbG, cbB, width, params);
+		else
+			convertRow<4, false>(dst, ySrc, aSrc, crR, crbG, cbB, width, params);
+	}
+}
+
+} // End of namespace Graphics
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
@@ -0,0 +1,132 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+
+#include "graphics/yuv_to_rgb.h"
+
+#include <arm_neon.h>
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("neon"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+namespace Graphics {
+
+/**
+ * Add the chroma to eight luminance values and clamp the results, scaling
+ * them from the ITU range if needed.
+ */
+template<bool itu>
+static FORCEINLINE uint16x8_t convertComponent(int16x8_t y, const int16 *chroma, int16x8_t loss) {
+	int16x8_t value = vaddq_s16(y, vld1q_s16(chroma));
+	uint16x8_t result;
+
+	if (itu) {
+		value = vminq_s16(vmaxq_s16(value, vdupq_n_s16(16)), vdupq_n_s16(235));
+		// (value - 16) * 255 / 219, which is exact over the whole clamped range
+		const uint16x8_t scaled = vshlq_n_u16(vreinterpretq_u16_s16(vsubq_s16(value, vdupq_n_s16(16))), 3);
+		const uint16x4_t lo = vshrn_n_u32(vmull_u16(vget_low_u16(scaled), vdup_n_u16(9539)), 16);
+		const uint16x4_t hi = vshrn_n_u32(vmull_u16(vget_high_u16(scaled), vdup_n_u16(9539)), 16);
+		result = vcombine_u16(lo, hi);
+	} else {
+		result = vreinterpretq_u16_s16(vminq_s16(vmaxq_s16(value, vdupq_n_s16(0)), vdupq_n_s16(255)));
+	}
+
+	// Shifting left by a negative amount shifts right
+	return vshlq_u16(result, loss);
+}
+
+static FORCEINLINE uint32x4_t packPixels(uint16x4_t r, uint16x4_t g, uint16x4_t b, uint16x4_t a, int32x4_t rShift, int32x4_t gShift, int32x4_t bShift, int32x4_t aShift) {
+	const uint32x4_t rg = vorrq_u32(vshlq_u32(vmovl_u16(r), rShift), vshlq_u32(vmovl_u16(g), gShift));
+	const uint32x4_t ba = vorrq_u32(vshlq_u32(vmovl_u16(b), bShift), vshlq_u32(vmovl_u16(a), aShift));
+	return vorrq_u32(rg, ba);
+}
+
+template<int bytesPerPixel, bool itu>
+static void convertRow(byte *dst, const byte *ySrc, const byte *aSrc, const int16 *crR, const int16 *crbG, const int16 *cbB, int width, const YUVToRGBManager::RowParams &params) {
+	const int16x8_t rLoss = vdupq_n_s16(-params.rLoss);
+	const int16x8_t gLoss = vdupq_n_s16(-params.gLoss);
+	const int16x8_t bLoss = vdupq_n_s16(-params.bLoss);
+	const int16x8_t aLoss = vdupq_n_s16(-params.aLoss);
+	const uint16x8_t opaque = vshlq_u16(vdupq_n_u16(0xFF), aLoss);
+
+	int i = 0;
+	for (; i + 8 <= width; i += 8) {
+		const int16x8_t y = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(ySrc + i)));
+		const uint16x8_t r = convertComponent<itu>(y, crR + i, rLoss);
+		const uint16x8_t g = convertComponent<itu>(y, crbG + i, gLoss);
+		const uint16x8_t b = convertComponent<itu>(y, cbB + i, bLoss);
+		const uint16x8_t a = aSrc ? vshlq_u16(vmovl_u8(vld1_u8(aSrc + i)), aLoss) : opaque;
+
+		if (bytesPerPixel == 2) {
+			uint16x8_t pixels = vorrq_u16(vshlq_u16(r, vdupq_n_s16(params.rShift)), vshlq_u16(g, vdupq_n_s16(params.gShift)));
+			pixels = vorrq_u16(pixels, vorrq_u16(vshlq_u16(b, vdupq_n_s16(params.bShift)), vshlq_u16(a, vdupq_n_s16(params.aShift))));
+			vst1q_u16((uint16 *)(dst + i * 2), pixels);
+		} else {
+			const int32x4_t rShift = vdupq_n_s32(params.rShift);
+			const int32x4_t gShift = vdupq_n_s32(params.gShift);
+			const int32x4_t bShift = vdupq_n_s32(params.bShift);
+			const int32x4_t aShift = vdupq_n_s32(params.aShift);
+			vst1q_u32((uint32 *)(dst + i * 4), packPixels(vget_low_u16(r), vget_low_u16(g), vget_low_u16(b), vget_low_u16(a), rShift, gShift, bShift, aShift));
+			vst1q_u32((uint32 *)(dst + i * 4 + 16), packPixels(vget_high_u16(r), vget_high_u16(g), vget_high_u16(b), vget_high_u16(a), rShift, gShift, bShift, aShift));
+		}
+	}
+
+	YUVToRGBManager::convertRowGeneric(dst + i * bytesPerPixel, ySrc + i, aSrc ? aSrc + i : nullptr, crR + i, crbG + i, cbB + i, width - i, params);
+}
+
+void YUVToRGBManager::convertRowNEON(byte *dst, const byte *ySrc, const byte *aSrc, const int16 *crR, const int16 *crbG, const int16 *cbB, int width, const RowParams &params) {
+	if (params.bytesPerPixel == 2) {
+		if (params.scale == kScaleITU)
+			convertRow<2, true>(dst, ySrc, aSrc, crR, crbG, cbB, width, params);
+		else
+			convertRow<2, false>(dst, ySrc, aSrc, crR, crbG, cbB, width, params);
+	} else {
+		if (params.scale == kScaleITU)
+			convertRow<4, true>(dst, ySrc, aSrc, crR, crbG, cbB, width, params);
+		else
+			convertRow<4, false>(dst, ySrc, aSrc, crR, crbG, cbB, width, params);
+	}
+}
+
+} // End of namespace Graphics
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#endif // SCUMMVM_NEON
@@ -0,0 +1,122 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "graphics/yuv_to_rgb.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace Graphics {
+
+/**
+ * Add the chroma to eight luminance values and clamp the results, scaling
+ * them from the ITU range if needed.
+ */
+template<bool itu>
+static FORCEINLINE __m128i convertComponent(__m128i y, const int16 *chroma, __m128i loss) {
+	__m128i value = _mm_add_epi16(y, _mm_loadu_si128((const __m128i *)chroma));
+
+	if (itu) {
+		value = _mm_min_epi16(_mm_max_epi16(value, _mm_set1_epi16(16)), _mm_set1_epi16(235));
+		// (value - 16) * 255 / 219, which is exact over the whole clamped range
+		value = _mm_mulhi_epu16(_mm_slli_epi16(_mm_sub_epi16(value, _mm_set1_epi16(16)), 3), _mm_set1_epi16(9539));
+	} else {
+		value = _mm_min_epi16(_mm_max_epi16(value, _mm_setzero_si128()), _mm_set1_epi16(255));
+	}
+
+	return _mm_srl_epi16(value, loss);
+}
+
+template<int bytesPerPixel, bool itu>
+static void convertRow(byte *dst, const byte *ySrc, const byte *aSrc, const int16 *crR, const int16 *crbG, const int16 *cbB, int width, const YUVToRGBManager::RowParams &params) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i rLoss = _mm_cvtsi32_si128(params.rLoss);
+	const __m128i gLoss = _mm_cvtsi32_si128(params.gLoss);
+	const __m128i bLoss = _mm_cvtsi32_si128(params.bLoss);
+	const __m128i aLoss = _mm_cvtsi32_si128(params.aLoss);
+	const __m128i rShift = _mm_cvtsi32_si128(params.rShift);
+	const __m128i gShift = _mm_cvtsi32_si128(params.gShift);
+	const __m128i bShift = _mm_cvtsi32_si128(params.bShift);
+	const __m128i aShift = _mm_cvtsi32_si128(params.aShift);
+	const __m128i opaque = _mm_srl_epi16(_mm_set1_epi16(0xFF), aLoss);
+
+	int i = 0;
+	for (; i + 8 <= width; i += 8) {
+		const __m128i y = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(ySrc + i)), zero);
+		const __m128i r = convertComponent<itu>(y, crR + i, rLoss);
+		const __m128i g = convertComponent<itu>(y, crbG + i, gLoss);
+		const __m128i b = convertComponent<itu>(y, cbB + i, bLoss);
+		const __m128i a = aSrc ? _mm_srl_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(aSrc + i)), zero), aLoss) : opaque;
+
+		if (bytesPerPixel == 2) {
+			__m128i pixels = _mm_or_si128(_mm_sll_epi16(r, rShift), _mm_sll_epi16(g, gShift));
+			pixels = _mm_or_si128(pixels, _mm_or_si128(_mm_sll_epi16(b, bShift), _mm_sll_epi16(a, aShift)));
+			_mm_storeu_si128((__m128i *)(dst + i * 2), pixels);
+		} else {
+			__m128i lo = _mm_or_si128(_mm_sll_epi32(_mm_unpacklo_epi16(r, zero), rShift), _mm_sll_epi32(_mm_unpacklo_epi16(g, zero), gShift));
+			lo = _mm_or_si128(lo, _mm_or_si128(_mm_sll_epi32(_mm_unpacklo_epi16(b, zero), bShift), _mm_sll_epi32(_mm_unpacklo_epi16(a, zero), aShift)));
+			__m128i hi = _mm_or_si128(_mm_sll_epi32(_mm_unpackhi_epi16(r, zero), rShift), _mm_sll_epi32(_mm_unpackhi_epi16(g, zero), gShift));
+			hi = _mm_or_si128(hi, _mm_or_si128(_mm_sll_epi32(_mm_unpackhi_epi16(b, zero), bShift), _mm_sll_epi32(_mm_unpackhi_epi16(a, zero), aShift)));
+			_mm_storeu_si128((__m128i *)(dst + i * 4), lo);
+			_mm_storeu_si128((__m128i *)(dst + i * 4 + 16), hi);
+		}
+	}
+
+	YUVToRGBManager::convertRowGeneric(dst + i * bytesPerPixel, ySrc + i, aSrc ? aSrc + i : nullptr, crR + i, crbG + i, cbB + i, width - i, params);
+}
+
+void YUVToRGBManager::convertRowSSE2(byte *dst, const byte *ySrc, const byte *aSrc, const int16 *crR, const int16 *crbG, const int16 *cbB, int width, const RowParams &params) {
+	if (params.bytesPerPixel == 2) {
+		if (params.scale == kScaleITU)
+			convertRow<2, true>(dst, ySrc, aSrc, crR, crbG, cbB, width, params);
+		else
+			convertRow<2, false>(dst, ySrc, aSrc, crR, crbG, cbB, width, params);
+	} else {
+		if (params.scale == kScaleITU)
+			convertRow<4, true>(dst, ySrc, aSrc, crR, crbG, cbB, width, params);
+		else
+			convertRow<4, false>(dst, ySrc, aSrc, crR, crbG, cbB, width, params);
+	}
+}
+
+} // End of namespace Graphics
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
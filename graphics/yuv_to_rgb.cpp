@@ -82,6 +82,7 @@
 // BASIS, AND BROWN UNIVERSITY HAS NO OBLIGATION TO PROVIDE MAINTENANCE,
 // SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 
+#include "common/system.h"
 #include "graphics/surface.h"
 #include "graphics/yuv_to_rgb.h"
 
@@ -98,12 +99,14 @@ public:
 	Graphics::PixelFormat getFormat() const { return _format; }
 	YUVToRGBManager::LuminanceScale getScale() const { return _scale; }
 	const int16 *getColorTable() const { return _colorTab; }
+	const int16 *getChromaTable() const { return _chromaTab; }
 	const byte *getClipTable() const { return _clipTable; }
 
 private:
 	Graphics::PixelFormat _format;
 	YUVToRGBManager::LuminanceScale _scale;
 	int16 _colorTab[4 * 256]; // 2048 bytes
+	int16 _chromaTab[4 * 256]; // Same as _colorTab, without the clip table offsets
 	byte _clipTable[3 * 768];
 };
 
@@ -174,19 +177,29 @@ YUVToRGBLookup::YUVToRGBLookup(Graphics::PixelFormat format, YUVToRGBManager::Lu
 		// would be done here. See the Berkeley mpeg_play sources.
 
 		int16 CR = (i - 128), CB = CR;
-		Cr_r_tab[i] = (int16) ( (0.419 / 0.299) * CR) + r_offset + 256;
-		Cr_g_tab[i] = (int16) (-(0.299 / 0.419) * CR) + g_offset + 256;
-		Cb_g_tab[i] = (int16) (-(0.114 / 0.331) * CB);
-		Cb_b_tab[i] = (int16) ( (0.587 / 0.331) * CB) + b_offset + 256;
+		_chromaTab[0 * 256 + i] = (int16) ( (0.419 / 0.299) * CR);
+		_chromaTab[1 * 256 + i] = (int16) (-(0.299 / 0.419) * CR);
+		_chromaTab[2 * 256 + i] = (int16) (-(0.114 / 0.331) * CB);
+		_chromaTab[3 * 256 + i] = (int16) ( (0.587 / 0.331) * CB);
+
+		Cr_r_tab[i] = _chromaTab[0 * 256 + i] + r_offset + 256;
+		Cr_g_tab[i] = _chromaTab[1 * 256 + i] + g_offset + 256;
+		Cb_g_tab[i] = _chromaTab[2 * 256 + i];
+		Cb_b_tab[i] = _chromaTab[3 * 256 + i] + b_offset + 256;
 	}
 }
 
+YUVToRGBManager::ConvertRowFunc YUVToRGBManager::convertRowFunc = nullptr;
+
 YUVToRGBManager::YUVToRGBManager() {
 	_lookup = 0;
+	_chromaRows = nullptr;
+	_chromaRowWidth = 0;
 }
 
 YUVToRGBManager::~YUVToRGBManager() {
 	delete _lookup;
+	delete[] _chromaRows;
 }
 
 const YUVToRGBLookup *YUVToRGBManager::getLookup(Graphics::PixelFormat format, YUVToRGBManager::LuminanceScale scale) {
@@ -198,6 +211,95 @@ const YUVToRGBLookup *YUVToRGBManager::getLookup(Graphics::PixelFormat format, Y
 	return _lookup;
 }
 
+YUVToRGBManager::ConvertRowFunc YUVToRGBManager::getConvertRowFunc() {
+	// If no row function has been selected yet, detect and select
+	if (!convertRowFunc) {
+		convertRowFunc = convertRowGeneric;
+#ifdef SCUMMVM_NEON
+		if (g_system->hasFeature(OSystem::kFeatureCpuNEON)) convertRowFunc = convertRowNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+		if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) convertRowFunc = convertRowSSE2;
+#endif
+#ifdef SCUMMVM_AVX2
+		if (g_system->hasFeature(OSystem::kFeatureCpuAVX2)) convertRowFunc = convertRowAVX2;
+#endif
+	}
+
+	return convertRowFunc;
+}
+
+void YUVToRGBManager::allocateChromaRows(int width) {
+	if (width <= _chromaRowWidth)
+		return;
+
+	delete[] _chromaRows;
+	_chromaRows = new int16[3 * width];
+	_chromaRowWidth = width;
+}
+
+static YUVToRGBManager::RowParams getRowParams(const Graphics::PixelFormat &format, YUVToRGBManager::LuminanceScale scale) {
+	YUVToRGBManager::RowParams params;
+	params.bytesPerPixel = format.bytesPerPixel;
+	params.scale = scale;
+	params.rLoss = format.rLoss;
+	params.gLoss = format.gLoss;
+	params.bLoss = format.bLoss;
+	params.aLoss = format.aLoss;
+	params.rShift = format.rShift;
+	params.gShift = format.gShift;
+	params.bShift = format.bShift;
+	params.aShift = format.aShift;
+	return params;
+}
+
+/**
+ * Fill the chroma rows with what each pixel adds to its components, where
+ * each chroma sample covers @p step pixels.
+ */
+static void fillChromaRows(const YUVToRGBLookup *lookup, int16 *crR, int16 *crbG, int16 *cbB, const byte *uSrc, const byte *vSrc, int width, int step) {
+	const int16 *Cr_r_tab = lookup->getChromaTable();
+	const int16 *Cr_g_tab = Cr_r_tab + 256;
+	const int16 *Cb_g_tab = Cr_g_tab + 256;
+	const int16 *Cb_b_tab = Cb_g_tab + 256;
+
+	for (int x = 0; x < width; x += step) {
+		const int16 r = Cr_r_tab[*vSrc];
+		const int16 g = Cr_g_tab[*vSrc] + Cb_g_tab[*uSrc];
+		const int16 b = Cb_b_tab[*uSrc];
+		++uSrc;
+		++vSrc;
+
+		for (int i = 0; i < step && x + i < width; i++) {
+			crR[x + i] = r;
+			crbG[x + i] = g;
+			cbB[x + i] = b;
+		}
+	}
+}
+
+static inline uint scaleLuminance(int value, YUVToRGBManager::LuminanceScale scale) {
+	if (scale == YUVToRGBManager::kScaleFull)
+		return CLIP(value, 0, 255);
+
+	return (CLIP(value, 16, 235) - 16) * 255 / 219;
+}
+
+void YUVToRGBManager::convertRowGeneric(byte *dst, const byte *ySrc, const byte *aSrc, const int16 *crR, const int16 *crbG, const int16 *cbB, int width, const RowParams &params) {
+	for (int i = 0; i < width; i++) {
+		const uint32 r = scaleLuminance(ySrc[i] + crR[i], params.scale) >> params.rLoss;
+		const uint32 g = scaleLuminance(ySrc[i] + crbG[i], params.scale) >> params.gLoss;
+		const uint32 b = scaleLuminance(ySrc[i] + cbB[i], params.scale) >> params.bLoss;
+		const uint32 a = (aSrc ? aSrc[i] : 0xFF) >> params.aLoss;
+		const uint32 pixel = (r << params.rShift) | (g << params.gShift) | (b << params.bShift) | (a << params.aShift);
+
+		if (params.bytesPerPixel == 2)
+			((uint16 *)dst)[i] = pixel;
+		else
+			((uint32 *)dst)[i] = pixel;
+	}
+}
+
 #define PUT_PIXEL(s, d) \
 	L = &clipTable[(s)]; \
 	*((PixelInt *)(d)) = ((L[cr_r] << r_shift) | (L[crb_g] << g_shift) | (L[cb_b] << b_shift) | a_mask)
@@ -246,6 +348,25 @@ void YUVToRGBManager::convert444(Graphics::Surface *dst, YUVToRGBManager::Lumina
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
+	// Use the vectorized row converters when there are any
+	ConvertRowFunc convertRow = getConvertRowFunc();
+	if (convertRow != convertRowGeneric) {
+		const RowParams params = getRowParams(dst->format, scale);
+		allocateChromaRows(yWidth);
+		int16 *crR = _chromaRows, *crbG = crR + yWidth, *cbB = crbG + yWidth;
+		byte *dstPtr = (byte *)dst->getPixels();
+
+		for (int h = 0; h < yHeight; h++) {
+			fillChromaRows(lookup, crR, crbG, cbB, uSrc, vSrc, yWidth, 1);
+			convertRow(dstPtr, ySrc, nullptr, crR, crbG, cbB, yWidth, params);
+			dstPtr += dst->pitch;
+			ySrc += yPitch;
+			uSrc += uvPitch;
+			vSrc += uvPitch;
+		}
+		return;
+	}
+
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
 		convertYUV444ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
@@ -299,15 +420,35 @@ void YUVToRGBManager::convert422(Graphics::Surface *dst, YUVToRGBManager::Lumina
 	assert(dst && dst->getPixels());
 	assert(dst->format.bytesPerPixel == 2 || dst->format.bytesPerPixel == 4);
 	assert(ySrc && uSrc && vSrc);
-	assert((yWidth & 1) == 0);
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
+	// Use the vectorized row converters when there are any
+	ConvertRowFunc convertRow = getConvertRowFunc();
+	if (convertRow != convertRowGeneric) {
+		// Like the scalar conversion, skip the last column of odd widths
+		const int width = yWidth & ~1;
+		const RowParams params = getRowParams(dst->format, scale);
+		allocateChromaRows(yWidth);
+		int16 *crR = _chromaRows, *crbG = crR + yWidth, *cbB = crbG + yWidth;
+		byte *dstPtr = (byte *)dst->getPixels();
+
+		for (int h = 0; h < yHeight; h++) {
+			fillChromaRows(lookup, crR, crbG, cbB, uSrc, vSrc, width, 2);
+			convertRow(dstPtr, ySrc, nullptr, crR, crbG, cbB, width, params);
+			dstPtr += dst->pitch;
+			ySrc += yPitch;
+			uSrc += uvPitch;
+			vSrc += uvPitch;
+		}
+		return;
+	}
+
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
-		convertYUV422ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUV422ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth & ~1, yHeight, yPitch, uvPitch);
 	else
-		convertYUV422ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUV422ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth & ~1, yHeight, yPitch, uvPitch);
 }
 
 template<typename PixelInt>
@@ -347,7 +488,7 @@ void convertYUV420ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 			dstPtr += sizeof(PixelInt);
 		}
 
-		dstPtr += dstPitch;
+		dstPtr += (dstPitch << 1) - yWidth * sizeof(PixelInt);
 		ySrc += (yPitch << 1) - yWidth;
 		uSrc += uvPitch - halfWidth;
 		vSrc += uvPitch - halfWidth;
@@ -359,16 +500,37 @@ void YUVToRGBManager::convert420(Graphics::Surface *dst, YUVToRGBManager::Lumina
 	assert(dst && dst->getPixels());
 	assert(dst->format.bytesPerPixel == 2 || dst->format.bytesPerPixel == 4);
 	assert(ySrc && uSrc && vSrc);
-	assert((yWidth & 1) == 0);
 	assert((yHeight & 1) == 0);
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
+	// Use the vectorized row converters when there are any
+	ConvertRowFunc convertRow = getConvertRowFunc();
+	if (convertRow != convertRowGeneric) {
+		// Like the scalar conversion, skip the last column of odd widths
+		const int width = yWidth & ~1;
+		const RowParams params = getRowParams(dst->format, scale);
+		allocateChromaRows(yWidth);
+		int16 *crR = _chromaRows, *crbG = crR + yWidth, *cbB = crbG + yWidth;
+		byte *dstPtr = (byte *)dst->getPixels();
+
+		for (int h = 0; h < (yHeight >> 1); h++) {
+			fillChromaRows(lookup, crR, crbG, cbB, uSrc, vSrc, width, 2);
+			convertRow(dstPtr, ySrc, nullptr, crR, crbG, cbB, width, params);
+			convertRow(dstPtr + dst->pitch, ySrc + yPitch, nullptr, crR, crbG, cbB, width, params);
+			dstPtr += dst->pitch << 1;
+			ySrc += yPitch << 1;
+			uSrc += uvPitch;
+			vSrc += uvPitch;
+		}
+		return;
+	}
+
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
-		convertYUV420ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUV420ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth & ~1, yHeight, yPitch, uvPitch);
 	else
-		convertYUV420ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUV420ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth & ~1, yHeight, yPitch, uvPitch);
 }
 
 #define PUT_PIXELA(s, a, d) \
@@ -415,7 +577,7 @@ void convertYUVA420ToRGBA(byte *dstPtr, int dstPitch, const YUVToRGBLookup *look
 			dstPtr += sizeof(PixelInt);
 		}
 
-		dstPtr += dstPitch;
+		dstPtr += (dstPitch << 1) - yWidth * sizeof(PixelInt);
 		ySrc += (yPitch << 1) - yWidth;
 		aSrc += (yPitch << 1) - yWidth;
 		uSrc += uvPitch - halfWidth;
@@ -428,16 +590,38 @@ void YUVToRGBManager::convert420Alpha(Graphics::Surface *dst, YUVToRGBManager::L
 	assert(dst && dst->getPixels());
 	assert(dst->format.bytesPerPixel == 2 || dst->format.bytesPerPixel == 4);
 	assert(ySrc && uSrc && vSrc);
-	assert((yWidth & 1) == 0);
 	assert((yHeight & 1) == 0);
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
+	// Use the vectorized row converters when there are any
+	ConvertRowFunc convertRow = getConvertRowFunc();
+	if (convertRow != convertRowGeneric) {
+		// Like the scalar conversion, skip the last column of odd widths
+		const int width = yWidth & ~1;
+		const RowParams params = getRowParams(dst->format, scale);
+		allocateChromaRows(yWidth);
+		int16 *crR = _chromaRows, *crbG = crR + yWidth, *cbB = crbG + yWidth;
+		byte *dstPtr = (byte *)dst->getPixels();
+
+		for (int h = 0; h < (yHeight >> 1); h++) {
+			fillChromaRows(lookup, crR, crbG, cbB, uSrc, vSrc, width, 2);
+			convertRow(dstPtr, ySrc, aSrc, crR, crbG, cbB, width, params);
+			convertRow(dstPtr + dst->pitch, ySrc + yPitch, aSrc + yPitch, crR, crbG, cbB, width, params);
+			dstPtr += dst->pitch << 1;
+			ySrc += yPitch << 1;
+			aSrc += yPitch << 1;
+			uSrc += uvPitch;
+			vSrc += uvPitch;
+		}
+		return;
+	}
+
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
-		convertYUVA420ToRGBA<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, aSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUVA420ToRGBA<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, aSrc, yWidth & ~1, yHeight, yPitch, uvPitch);
 	else
-		convertYUVA420ToRGBA<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, aSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUVA420ToRGBA<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, aSrc, yWidth & ~1, yHeight, yPitch, uvPitch);
 }
 
 #define READ_QUAD(ptr, prefix) \
@@ -509,6 +693,36 @@ void convertYUV410ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 	}
 }
 
+/**
+ * Fill the chroma rows for a row of a YUV410 image, interpolating the chroma
+ * the same way as convertYUV410ToRGB does.
+ */
+static void fillChromaRows410(const YUVToRGBLookup *lookup, int16 *crR, int16 *crbG, int16 *cbB, const byte *uSrc, const byte *vSrc, int yWidth, int yDiff, int uvPitch) {
+	const int16 *Cr_r_tab = lookup->getChromaTable();
+	const int16 *Cr_g_tab = Cr_r_tab + 256;
+	const int16 *Cb_g_tab = Cr_g_tab + 256;
+	const int16 *Cb_b_tab = Cb_g_tab + 256;
+
+	int quarterWidth = yWidth >> 2;
+
+	for (int x = 0; x < quarterWidth; x++) {
+		int index = x;
+		byte u, v;
+
+		READ_QUAD(uSrc, u);
+		READ_QUAD(vSrc, v);
+
+		for (int xDiff = 0; xDiff < 4; xDiff++) {
+			DO_INTERPOLATION(u);
+			DO_INTERPOLATION(v);
+
+			*crR++  = Cr_r_tab[v];
+			*crbG++ = Cr_g_tab[v] + Cb_g_tab[u];
+			*cbB++  = Cb_b_tab[u];
+		}
+	}
+}
+
 #undef READ_QUAD
 #undef DO_INTERPOLATION
 #undef DO_YUV410_PIXEL
@@ -518,16 +732,35 @@ void YUVToRGBManager::convert410(Graphics::Surface *dst, YUVToRGBManager::Lumina
 	assert(dst && dst->getPixels());
 	assert(dst->format.bytesPerPixel == 2 || dst->format.bytesPerPixel == 4);
 	assert(ySrc && uSrc && vSrc);
-	assert((yWidth & 3) == 0);
 	assert((yHeight & 3) == 0);
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
+	// Use the vectorized row converters when there are any
+	ConvertRowFunc convertRow = getConvertRowFunc();
+	if (convertRow != convertRowGeneric) {
+		// Like the scalar conversion, skip the last columns of widths which
+		// are not divisible by 4, as they have no chroma filled in
+		const int width = yWidth & ~3;
+		const RowParams params = getRowParams(dst->format, scale);
+		allocateChromaRows(yWidth);
+		int16 *crR = _chromaRows, *crbG = crR + yWidth, *cbB = crbG + yWidth;
+		byte *dstPtr = (byte *)dst->getPixels();
+
+		for (int h = 0; h < yHeight; h++) {
+			fillChromaRows410(lookup, crR, crbG, cbB, uSrc + (h >> 2) * uvPitch, vSrc + (h >> 2) * uvPitch, yWidth, h & 3, uvPitch);
+			convertRow(dstPtr, ySrc, nullptr, crR, crbG, cbB, width, params);
+			dstPtr += dst->pitch;
+			ySrc += yPitch;
+		}
+		return;
+	}
+
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
-		convertYUV410ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUV410ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth & ~3, yHeight, yPitch, uvPitch);
 	else
-		convertYUV410ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUV410ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth & ~3, yHeight, yPitch, uvPitch);
 }
 
 } // End of namespace Graphics
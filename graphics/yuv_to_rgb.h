@@ -76,7 +76,7 @@ public:
 	 * @param ySrc    the source of the y component
 	 * @param uSrc    the source of the u component
 	 * @param vSrc    the source of the v component
-	 * @param yWidth  the width of the y surface (must be divisible by 2)
+	 * @param yWidth  the width of the y surface (the last column of odd widths is not converted)
 	 * @param yHeight the height of the y surface
 	 * @param yPitch  the pitch of the y surface
 	 * @param uvPitch the pitch of the u and v surfaces
@@ -91,7 +91,7 @@ public:
 	 * @param ySrc    the source of the y component
 	 * @param uSrc    the source of the u component
 	 * @param vSrc    the source of the v component
-	 * @param yWidth  the width of the y surface (must be divisible by 2)
+	 * @param yWidth  the width of the y surface (the last column of odd widths is not converted)
 	 * @param yHeight the height of the y surface (must be divisible by 2)
 	 * @param yPitch  the pitch of the y surface
 	 * @param uvPitch the pitch of the u and v surfaces
@@ -107,7 +107,7 @@ public:
 	 * @param uSrc    the source of the u component
 	 * @param vSrc    the source of the v component
 	 * @param aSrc    the source of the a component
-	 * @param yWidth  the width of the y surface (must be divisible by 2)
+	 * @param yWidth  the width of the y surface (the last column of odd widths is not converted)
 	 * @param yHeight the height of the y surface (must be divisible by 2)
 	 * @param yPitch  the pitch of the y surface
 	 * @param uvPitch the pitch of the u and v surfaces
@@ -128,21 +128,64 @@ public:
 	 * @param ySrc    the source of the y component
 	 * @param uSrc    the source of the u component
 	 * @param vSrc    the source of the v component
-	 * @param yWidth  the width of the y surface (must be divisible by 4)
+	 * @param yWidth  the width of the y surface (the last columns of widths not divisible by 4 are not converted)
 	 * @param yHeight the height of the y surface (must be divisible by 4)
 	 * @param yPitch  the pitch of the y surface
 	 * @param uvPitch the pitch of the u and v surfaces
 	 */
 	void convert410(Graphics::Surface *dst, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch);
 
+	/** The destination format of a row conversion. */
+	struct RowParams {
+		int bytesPerPixel;
+		LuminanceScale scale;
+		byte rLoss, gLoss, bLoss, aLoss;
+		byte rShift, gShift, bShift, aShift;
+	};
+
+	/**
+	 * Convert a row of pixels to RGB.
+	 *
+	 * @param dst    the destination row
+	 * @param ySrc   the y components of the row
+	 * @param aSrc   the alpha components of the row, or nullptr for opaque pixels
+	 * @param crR    what the chroma of each pixel adds to its red component
+	 * @param crbG   what the chroma of each pixel adds to its green component
+	 * @param cbB    what the chroma of each pixel adds to its blue component
+	 * @param width  the number of pixels in the row
+	 * @param params the destination format
+	 */
+	typedef void (*ConvertRowFunc)(byte *dst, const byte *ySrc, const byte *aSrc, const int16 *crR, const int16 *crbG, const int16 *cbB, int width, const RowParams &params);
+
+	/**
+	 * Used for the last pixels of the rows by the vectorized versions. When
+	 * it is selected, the conversions use the lookup tables instead.
+	 */
+	static void convertRowGeneric(byte *dst, const byte *ySrc, const byte *aSrc, const int16 *crR, const int16 *crbG, const int16 *cbB, int width, const RowParams &params);
+#ifdef SCUMMVM_NEON
+	static void convertRowNEON(byte *dst, const byte *ySrc, const byte *aSrc, const int16 *crR, const int16 *crbG, const int16 *cbB, int width, const RowParams &params);
+#endif
+#ifdef SCUMMVM_SSE2
+	static void convertRowSSE2(byte *dst, const byte *ySrc, const byte *aSrc, const int16 *crR, const int16 *crbG, const int16 *cbB, int width, const RowParams &params);
+#endif
+#ifdef SCUMMVM_AVX2
+	static void convertRowAVX2(byte *dst, const byte *ySrc, const byte *aSrc, const int16 *crR, const int16 *crbG, const int16 *cbB, int width, const RowParams &params);
+#endif
+
+	static ConvertRowFunc convertRowFunc;
+
 private:
 	friend class Common::Singleton<SingletonBaseType>;
 	YUVToRGBManager();
 	~YUVToRGBManager();
 
 	const YUVToRGBLookup *getLookup(Graphics::PixelFormat format, LuminanceScale scale);
+	static ConvertRowFunc getConvertRowFunc();
+	void allocateChromaRows(int width);
 
 	YUVToRGBLookup *_lookup;
+	int16 *_chromaRows;
+	int _chromaRowWidth;
 };
  /** @} */
 } // End of namespace Graphics
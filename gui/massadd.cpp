@@ -277,6 +277,9 @@ void MassAddDialog::handleTickle() {
 	Common::U32String buf;
 
 	if (_scanStack.empty()) {
+		// Make sure all MD5s computed during the scan are stored
+		ADCacheMan.savePersistentCache(true);
+
 		// Enable the OK button
 		_okButton->setEnabled(true);
 
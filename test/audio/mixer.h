@@ -0,0 +1,125 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/mixer_intern.h"
+#include "audio/decoders/raw.h"
+#include "common/memstream.h"
+#include "common/random.h"
+
+#include "../null_osystem.h"
+#include "../instrset_detect.h"
+
+#if defined(HAVE_CONFIG_H)
+#include "config.h"
+#endif
+
+class MixerTestSuite : public CxxTest::TestSuite {
+public:
+	MixerTestSuite() {
+		Common::install_null_g_system();
+		// The null backend has no CPU feature detection
+		Audio::MixerImpl::clampBufferFunc = Audio::MixerImpl::clampBufferGeneric;
+	}
+
+	static void fillMixedSamples(int32 *buf, uint len, Common::RandomSource &rnd) {
+		static const int32 extremes[] = {
+			-2147483647 - 1, -65536, -32769, -32768, -32767, 0,
+			32766, 32767, 32768, 65535, 2147483647
+		};
+
+		for (uint i = 0; i < len; i++) {
+			if (rnd.getRandomNumber(3) == 0)
+				buf[i] = extremes[rnd.getRandomNumber(ARRAYSIZE(extremes) - 1)];
+			else
+				buf[i] = (int32)rnd.getRandomNumber(0x3FFFF) - 0x20000;
+		}
+	}
+
+	static void checkClampBuffer(Audio::MixerImpl::ClampBufferFunc func) {
+		// Lengths which are not a multiple of the vector widths exercise
+		// the scalar tails of the kernels
+		static const uint lengths[] = { 0, 1, 7, 8, 9, 15, 16, 17, 33, 1000, 1027 };
+		Common::RandomSource rnd("mixer");
+
+		for (uint l = 0; l < ARRAYSIZE(lengths); l++) {
+			const uint len = lengths[l];
+			int32 *src = new int32[len + 1];
+			int16 *expected = new int16[len + 1];
+			int16 *actual = new int16[len + 1];
+
+			fillMixedSamples(src, len, rnd);
+			expected[len] = actual[len] = 0x1234;
+
+			Audio::MixerImpl::clampBufferGeneric(expected, src, len);
+			func(actual, src, len);
+
+			TS_ASSERT_EQUALS(memcmp(expected, actual, (len + 1) * sizeof(int16)), 0);
+
+			delete[] src;
+			delete[] expected;
+			delete[] actual;
+		}
+	}
+
+	void test_clamp_buffer_generic() {
+		static const int32 src[] = { -2147483647 - 1, -32769, -32768, 0, 32767, 32768, 2147483647 };
+		int16 dst[ARRAYSIZE(src)];
+
+		Audio::MixerImpl::clampBufferGeneric(dst, src, ARRAYSIZE(src));
+
+#ifdef OUTPUT_UNSIGNED_AUDIO
+		static const uint16 expected[] = { 0, 0, 0, 0x8000, 0xFFFF, 0xFFFF, 0xFFFF };
+		TS_ASSERT_EQUALS(memcmp(dst, expected, sizeof(dst)), 0);
+#else
+		static const int16 expected[] = { -32768, -32768, -32768, 0, 32767, 32767, 32767 };
+		TS_ASSERT_EQUALS(memcmp(dst, expected, sizeof(dst)), 0);
+#endif
+	}
+
+	void test_clamp_buffer_simd() {
+#ifdef SCUMMVM_NEON
+		checkClampBuffer(Audio::MixerImpl::clampBufferNEON);
+#endif
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			checkClampBuffer(Audio::MixerImpl::clampBufferSSE2);
+#endif
+#ifdef SCUMMVM_AVX2
+		if (instrset_detect() >= 8)
+			checkClampBuffer(Audio::MixerImpl::clampBufferAVX2);
+#endif
+	}
+
+	static int16 *mixNoise(uint outBufSize, uint frames) {
+		Audio::MixerImpl mixer(22050, true, outBufSize);
+		mixer.setReady(true);
+
+		const uint noiseSamples = frames * 2;
+		int16 *noise = (int16 *)malloc(noiseSamples * sizeof(int16));
+		Common::RandomSource rnd("mixer");
+		for (uint i = 0; i < noiseSamples; i++)
+			noise[i] = (int16)rnd.getRandomNumber(0xFFFF);
+
+		Audio::SoundHandle handle;
+		mixer.playStream(Audio::Mixer::kPlainSoundType, &handle,
+			Audio::makeRawStream((byte *)noise, noiseSamples * sizeof(int16), 22050,
+				Audio::FLAG_16BITS | Audio::FLAG_STEREO | Audio::FLAG_LITTLE_ENDIAN),
+			-1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::YES, false, false);
+
+		int16 *out = new int16[noiseSamples];
+		mixer.mixCallback((byte *)out, noiseSamples * sizeof(int16));
+		return out;
+	}
+
+	void test_mix_callback_in_chunks() {
+		// A callback asking for more samples than the intermediate buffer
+		// holds is mixed in several chunks, with the same result
+		const uint frames = 1000;
+		int16 *whole = mixNoise(4096, frames);
+		int16 *chunked = mixNoise(64, frames);
+
+		TS_ASSERT_EQUALS(memcmp(whole, chunked, frames * 2 * sizeof(int16)), 0);
+
+		delete[] whole;
+		delete[] chunked;
+	}
+};
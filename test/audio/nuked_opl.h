@@ -0,0 +1,159 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#if defined(HAVE_CONFIG_H)
+#include "config.h"
+#endif
+
+#include "audio/softsynth/opl/nuked.h"
+
+class NukedOPLTestSuite : public CxxTest::TestSuite {
+#ifndef DISABLE_NUKED_OPL
+	typedef void (*SlotGenCalcFunc)(OPL::NUKED::opl3_chip *chip);
+
+	uint32 _seed;
+
+	uint32 nextRandom() {
+		_seed = _seed * 1103515245u + 12345u;
+		return _seed >> 8;
+	}
+
+	// Writes a burst of random operator and channel registers
+	void writeRandomRegs(OPL::NUKED::opl3_chip *chip, int count) {
+		static const int slotRegs[18] = { 0, 1, 2, 3, 4, 5, 8, 9, 10, 11, 12, 13, 16, 17, 18, 19, 20, 21 };
+
+		for (int i = 0; i < count; i++) {
+			const uint16 high = (nextRandom() & 1) << 8;
+			const uint8 val = nextRandom() & 0xff;
+
+			switch (nextRandom() % 8) {
+			case 0:
+				OPL::NUKED::OPL3_WriteReg(chip, high | (0x20 + slotRegs[nextRandom() % 18]), val);
+				break;
+			case 1:
+				OPL::NUKED::OPL3_WriteReg(chip, high | (0x40 + slotRegs[nextRandom() % 18]), val & 0x9f);
+				break;
+			case 2:
+				OPL::NUKED::OPL3_WriteReg(chip, high | (0x60 + slotRegs[nextRandom() % 18]), val);
+				break;
+			case 3:
+				OPL::NUKED::OPL3_WriteReg(chip, high | (0x80 + slotRegs[nextRandom() % 18]), val);
+				break;
+			case 4:
+				OPL::NUKED::OPL3_WriteReg(chip, high | (0xe0 + slotRegs[nextRandom() % 18]), val);
+				break;
+			case 5:
+				OPL::NUKED::OPL3_WriteReg(chip, high | (0xa0 + nextRandom() % 9), val);
+				break;
+			case 6:
+				OPL::NUKED::OPL3_WriteReg(chip, high | (0xb0 + nextRandom() % 9), val);
+				break;
+			default:
+				OPL::NUKED::OPL3_WriteReg(chip, high | (0xc0 + nextRandom() % 9), val);
+				break;
+			}
+		}
+	}
+
+	void setupChip(OPL::NUKED::opl3_chip *chip) {
+		OPL::NUKED::OPL3_Reset(chip, 44100);
+		OPL::NUKED::OPL3_WriteReg(chip, 0x105, 0x01);
+		OPL::NUKED::OPL3_WriteReg(chip, 0x104, 0x09);
+	}
+
+	void checkSlotGenFunc(SlotGenCalcFunc func) {
+		OPL::NUKED::opl3_chip *ref = new OPL::NUKED::opl3_chip;
+		OPL::NUKED::opl3_chip *chip = new OPL::NUKED::opl3_chip;
+
+		_seed = 2;
+		setupChip(ref);
+		setupChip(chip);
+
+		for (int block = 0; block < 64; block++) {
+			const uint32 seed = _seed;
+			writeRandomRegs(ref, 24);
+			_seed = seed;
+			writeRandomRegs(chip, 24);
+
+			OPL::NUKED::OPL3_SlotGenUpdate(ref);
+			OPL::NUKED::OPL3_SlotGenUpdate(chip);
+
+			for (int i = 0; i < 256; i++) {
+				// Drive the global generator state through every combination
+				const uint32 state = nextRandom();
+				ref->eg_state = chip->eg_state = state & 1;
+				ref->eg_add = chip->eg_add = (state >> 1) % 14;
+				ref->eg_timer_lo = chip->eg_timer_lo = (state >> 5) & 3;
+				ref->tremolo = chip->tremolo = (state >> 7) % 27;
+				ref->vibpos = chip->vibpos = (state >> 12) & 7;
+				ref->vibshift = chip->vibshift = (state >> 15) & 1;
+
+				OPL::NUKED::OPL3_SlotGenCalcGeneric(ref);
+				func(chip);
+
+				const OPL::NUKED::opl3_slotgen &a = ref->slotgen;
+				const OPL::NUKED::opl3_slotgen &b = chip->slotgen;
+				for (int slot = 0; slot < 36; slot++) {
+					TS_ASSERT_EQUALS(a.eg_rout[slot], b.eg_rout[slot]);
+					TS_ASSERT_EQUALS(a.eg_out[slot], b.eg_out[slot]);
+					TS_ASSERT_EQUALS(a.eg_gen[slot], b.eg_gen[slot]);
+					TS_ASSERT_EQUALS(a.pg_reset[slot], b.pg_reset[slot]);
+					TS_ASSERT_EQUALS(a.pg_phase[slot], b.pg_phase[slot]);
+					TS_ASSERT_EQUALS(a.pg_phase_out[slot], b.pg_phase_out[slot]);
+				}
+			}
+		}
+
+		delete ref;
+		delete chip;
+	}
+#endif
+
+public:
+	void test_generate() {
+#ifndef DISABLE_NUKED_OPL
+		OPL::NUKED::opl3_chip *chip = new OPL::NUKED::opl3_chip;
+
+		_seed = 1;
+		setupChip(chip);
+
+		// Hash of the output of the original, per slot implementation
+		uint32 hash = 0;
+		for (int block = 0; block < 64; block++) {
+			writeRandomRegs(chip, 24);
+			if (block % 16 == 8)
+				OPL::NUKED::OPL3_WriteReg(chip, 0xbd, 0x20 | (nextRandom() & 0xdf));
+
+			for (int i = 0; i < 512; i++) {
+				int16 buf[4];
+				OPL::NUKED::OPL3_Generate4Ch(chip, buf);
+				for (int j = 0; j < 4; j++)
+					hash = hash * 31 + (uint16)buf[j];
+			}
+		}
+		TS_ASSERT_EQUALS(hash, 0xDBE83C7Du);
+
+		delete chip;
+#endif
+	}
+
+	void test_slotgen_neon() {
+#if defined(SCUMMVM_NEON) && !defined(DISABLE_NUKED_OPL)
+		checkSlotGenFunc(OPL::NUKED::OPL3_SlotGenCalcNEON);
+#endif
+	}
+
+	void test_slotgen_sse2() {
+#if defined(SCUMMVM_SSE2) && !defined(DISABLE_NUKED_OPL)
+		if (instrset_detect() >= 2)
+			checkSlotGenFunc(OPL::NUKED::OPL3_SlotGenCalcSSE2);
+#endif
+	}
+
+	void test_slotgen_avx2() {
+#if defined(SCUMMVM_AVX2) && !defined(DISABLE_NUKED_OPL)
+		if (instrset_detect() >= 8)
+			checkSlotGenFunc(OPL::NUKED::OPL3_SlotGenCalcAVX2);
+#endif
+	}
+};
@@ -0,0 +1,233 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#if defined(HAVE_CONFIG_H)
+#include "config.h"
+#endif
+
+#include "audio/decoders/raw.h"
+#include "audio/audiostream.h"
+#include "audio/mixer.h"
+#include "audio/rate.h"
+#include "audio/rate_intern.h"
+
+#include "helper.h"
+#include "../null_osystem.h"
+
+#if NULL_OSYSTEM_IS_AVAILABLE
+#define BENCHMARK_TIME 1
+#else
+#define BENCHMARK_TIME 0
+#endif
+
+class RateConverterTestSuite : public CxxTest::TestSuite
+{
+private:
+	void sincConvertTestTemplate(const int inRate, const int outRate, const bool isStereo) {
+		// The null backend cannot be asked for the CPU features
+		Audio::sincFilterFunc = Audio::sincFilterGeneric;
+
+		int16 *sine;
+		Audio::SeekableAudioStream *s = createSineStream<int16>(inRate, 1, &sine, false, isStereo);
+		Audio::RateConverter *converter = Audio::makeRateConverter(inRate, outRate, isStereo, true, false, Audio::kRateConverterQualityHigh);
+
+		const int outFrames = outRate + 64;
+		int16 *buffer = new int16[outFrames * 2];
+		memset(buffer, 0, sizeof(int16) * outFrames * 2);
+
+		int total = 0;
+		while (total < outFrames) {
+			const int res = converter->convert(*s, buffer + total * 2, MIN(512, outFrames - total), Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume);
+			if (res == 0)
+				break;
+			total += res;
+		}
+
+		// All input must have been consumed, including the filter delay
+		TS_ASSERT(ABS(total - outRate) <= outRate / inRate + 4);
+		TS_ASSERT_EQUALS(s->endOfData(), true);
+		TS_ASSERT_EQUALS(converter->needsDraining(), false);
+
+		// Away from the edges, the output must closely follow the input sine
+		for (int i = 32; i < outRate - 32; ++i) {
+			const double pos = (double)i * inRate / outRate;
+			const int in = (int)pos;
+			const double frac = pos - in;
+			const int channels = isStereo ? 2 : 1;
+			const double expected = sine[in * channels] * (1.0 - frac) + sine[(in + 1) * channels] * frac;
+			TS_ASSERT_DELTA(buffer[i * 2], expected, 400);
+			TS_ASSERT_DELTA(buffer[i * 2 + 1], expected, 400);
+		}
+
+		delete converter;
+		delete[] buffer;
+		delete[] sine;
+		delete s;
+	}
+
+	/**
+	 * Pull samples through the converter the way the mixer does, until the
+	 * stream has ended and the converter has nothing left to drain.
+	 */
+	int drainConverter(Audio::RateConverter *converter, Audio::AudioStream &stream, int16 *buffer, const int outFrames, Audio::QueuingAudioStream *refill = nullptr, int16 *refillData = nullptr, int refillSamples = 0) {
+		int total = 0;
+		bool starved = false;
+		for (int iter = 0; iter < 100000 && !(stream.endOfStream() && !converter->needsDraining()); ++iter) {
+			const int res = converter->convert(stream, buffer + total * 2, MIN(64, outFrames - total), Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume);
+			total += res;
+
+			if (refill && !starved && stream.endOfData()) {
+				// Give the converter a few more chances to run while starved
+				for (int i = 0; i < 4; ++i)
+					total += converter->convert(stream, buffer + total * 2, MIN(64, outFrames - total), Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume);
+
+				refill->queueBuffer((byte *)refillData, refillSamples * sizeof(int16), DisposeAfterUse::YES, Audio::FLAG_16BITS
+#ifdef SCUMM_LITTLE_ENDIAN
+				                    | Audio::FLAG_LITTLE_ENDIAN
+#endif
+				                   );
+				refill->finish();
+				starved = true;
+			}
+		}
+		return total;
+	}
+
+	void sincFilterTestTemplate(Audio::SincFilterFunc filter) {
+		int16 in[512 + Audio::kSincTaps];
+		int16 coeffs[Audio::kSincPhases * Audio::kSincTaps];
+		for (int i = 0; i < ARRAYSIZE(in); ++i)
+			in[i] = (int16)((i * 7919) & 0xffff);
+		for (int i = 0; i < ARRAYSIZE(coeffs); ++i)
+			coeffs[i] = (int16)((i * 104729) % 4096 - 2048);
+
+		int32 expected[256], result[256];
+		const frac_t inc = (11025 << Audio::FRAC_BITS_LOW) / 22050 + 3;
+		Audio::sincFilterGeneric(expected, ARRAYSIZE(expected), in, 5, inc, coeffs);
+		filter(result, ARRAYSIZE(result), in, 5, inc, coeffs);
+		TS_ASSERT_EQUALS(memcmp(expected, result, sizeof(expected)), 0);
+	}
+
+public:
+	void test_sinc_convert_mono_upsample() {
+		sincConvertTestTemplate(11025, 44100, false);
+	}
+
+	void test_sinc_convert_stereo_upsample() {
+		sincConvertTestTemplate(22050, 48000, true);
+	}
+
+	void test_sinc_convert_mono_downsample() {
+		sincConvertTestTemplate(48000, 44100, false);
+	}
+
+	void test_sinc_convert_starved_queue() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		// Queuing streams need mutexes
+		Common::install_null_g_system();
+		Audio::sincFilterFunc = Audio::sincFilterGeneric;
+
+		const int inRate = 22050, outRate = 44100;
+		const int outFrames = outRate + 64;
+
+		// Reference: the whole sine in a single stream
+		int16 *sine;
+		Audio::SeekableAudioStream *s = createSineStream<int16>(inRate, 1, &sine, false, false);
+		Audio::RateConverter *converter = Audio::makeRateConverter(inRate, outRate, false, true, false, Audio::kRateConverterQualityHigh);
+		int16 *expected = new int16[outFrames * 2];
+		memset(expected, 0, sizeof(int16) * outFrames * 2);
+		const int expectedTotal = drainConverter(converter, *s, expected, outFrames);
+		delete converter;
+		delete s;
+
+		// The same sine, fed through a queue which runs dry half way
+		const int half = inRate / 2;
+		int16 *first = (int16 *)malloc(half * sizeof(int16));
+		int16 *second = (int16 *)malloc((inRate - half) * sizeof(int16));
+		memcpy(first, sine, half * sizeof(int16));
+		memcpy(second, sine + half, (inRate - half) * sizeof(int16));
+
+		Audio::QueuingAudioStream *q = Audio::makeQueuingAudioStream(inRate, false);
+		q->queueBuffer((byte *)first, half * sizeof(int16), DisposeAfterUse::YES, Audio::FLAG_16BITS
+#ifdef SCUMM_LITTLE_ENDIAN
+		               | Audio::FLAG_LITTLE_ENDIAN
+#endif
+		              );
+		converter = Audio::makeRateConverter(inRate, outRate, false, true, false, Audio::kRateConverterQualityHigh);
+		int16 *buffer = new int16[outFrames * 2];
+		memset(buffer, 0, sizeof(int16) * outFrames * 2);
+		const int total = drainConverter(converter, *q, buffer, outFrames, q, second, inRate - half);
+
+		// No silence may be inserted where the queue ran dry, and the filter
+		// tail must not be cut off at the end
+		TS_ASSERT(ABS(expectedTotal - outRate) <= outRate / inRate + 4);
+		TS_ASSERT_EQUALS(total, expectedTotal);
+		TS_ASSERT_EQUALS(memcmp(buffer, expected, sizeof(int16) * outFrames * 2), 0);
+
+		delete converter;
+		delete q;
+		delete[] buffer;
+		delete[] expected;
+		delete[] sine;
+#endif
+	}
+
+	void test_sinc_speed() {
+#if BENCHMARK_TIME
+		Common::install_null_g_system();
+
+		Audio::SincFilterFunc simdFunc = Audio::sincFilterGeneric;
+#ifdef SCUMMVM_NEON
+		simdFunc = Audio::sincFilterNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			simdFunc = Audio::sincFilterSSE2;
+#endif
+
+#ifdef SLOW_TESTS
+		const int iters = 200;
+#else
+		const int iters = 1;
+#endif
+		const int inRate = 22050, outRate = 48000;
+		int16 *sine;
+		Audio::SeekableAudioStream *s = createSineStream<int16>(inRate, 1, &sine, false, true);
+		int32 *buffer = new int32[512 * 2];
+
+		// Linear interpolation, generic filter, SIMD filter
+		double times[3] = { 0.0, 0.0, 0.0 };
+		for (int mode = 0; mode < 3; mode++) {
+			Audio::sincFilterFunc = (mode == 2) ? simdFunc : Audio::sincFilterGeneric;
+			const uint32 start = g_system->getMillis();
+			for (int i = 0; i < iters; i++) {
+				s->rewind();
+				Audio::RateConverter *converter = Audio::makeRateConverter(inRate, outRate, true, true, false,
+					mode == 0 ? Audio::kRateConverterQualityDefault : Audio::kRateConverterQualityHigh);
+				while (converter->convert(*s, buffer, 512, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume) > 0)
+					;
+				delete converter;
+			}
+			times[mode] = g_system->getMillis() - start;
+		}
+
+		debug("Linear interpolation: %f ms per second of 22050 Hz stereo input", times[0] / iters);
+		debug("Sinc filter (non SIMD): %f ms per second of 22050 Hz stereo input", times[1] / iters);
+		debug("Sinc filter: %f ms per second of 22050 Hz stereo input", times[2] / iters);
+
+		delete[] buffer;
+		delete[] sine;
+		delete s;
+#endif
+	}
+
+	void test_sinc_filter_simd() {
+#ifdef SCUMMVM_NEON
+		sincFilterTestTemplate(Audio::sincFilterNEON);
+#endif
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			sincFilterTestTemplate(Audio::sincFilterSSE2);
+#endif
+	}
+};
@@ -0,0 +1,304 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/flat-hashmap.h"
+#include "common/hash-str.h"
+
+class FlatHashMapTestSuite : public CxxTest::TestSuite
+{
+	public:
+	void test_empty_clear() {
+		Common::FlatHashMap<int, int> container;
+		TS_ASSERT(container.empty());
+		container[0] = 17;
+		container[1] = 33;
+		TS_ASSERT(!container.empty());
+		container.clear();
+		TS_ASSERT(container.empty());
+
+		Common::FlatHashMap<Common::String, Common::String> container2;
+		TS_ASSERT(container2.empty());
+		container2["foo"] = "bar";
+		container2["quux"] = "blub";
+		TS_ASSERT(!container2.empty());
+		container2.clear();
+		TS_ASSERT(container2.empty());
+	}
+
+	void test_contains() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = 33;
+		TS_ASSERT(container.contains(0));
+		TS_ASSERT(container.contains(1));
+		TS_ASSERT(!container.contains(17));
+		TS_ASSERT(!container.contains(-1));
+
+		Common::FlatHashMap<Common::String, Common::String> container2;
+		container2["foo"] = "bar";
+		container2["quux"] = "blub";
+		TS_ASSERT(container2.contains("foo"));
+		TS_ASSERT(container2.contains("quux"));
+		TS_ASSERT(!container2.contains("bar"));
+		TS_ASSERT(!container2.contains("asdf"));
+	}
+
+	void test_add_remove() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = 33;
+		container[2] = 45;
+		container[3] = 12;
+		container[4] = 96;
+		TS_ASSERT(container.contains(1));
+		container.erase(1);
+		TS_ASSERT(!container.contains(1));
+		container[1] = 42;
+		TS_ASSERT(container.contains(1));
+		container.erase(0);
+		TS_ASSERT(!container.empty());
+		container.erase(1);
+		TS_ASSERT(!container.empty());
+		container.erase(2);
+		TS_ASSERT(!container.empty());
+		container.erase(3);
+		TS_ASSERT(!container.empty());
+		container.erase(4);
+		TS_ASSERT(container.empty());
+		container[1] = 33;
+		TS_ASSERT(container.contains(1));
+		TS_ASSERT(!container.empty());
+		container.erase(1);
+		TS_ASSERT(container.empty());
+	}
+
+	void test_add_remove_iterator() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = 33;
+		container[2] = 45;
+		container[3] = 12;
+		container[4] = 96;
+		TS_ASSERT(container.contains(1));
+		container.erase(container.find(1));
+		TS_ASSERT(!container.contains(1));
+		container[1] = 42;
+		TS_ASSERT(container.contains(1));
+		container.erase(container.find(0));
+		TS_ASSERT(!container.empty());
+		container.erase(container.find(1));
+		TS_ASSERT(!container.empty());
+		container.erase(container.find(2));
+		TS_ASSERT(!container.empty());
+		container.erase(container.find(3));
+		TS_ASSERT(!container.empty());
+		container.erase(container.find(4));
+		TS_ASSERT(container.empty());
+		container[1] = 33;
+		TS_ASSERT(container.contains(1));
+		TS_ASSERT(!container.empty());
+		container.erase(container.find(1));
+		TS_ASSERT(container.empty());
+	}
+
+	void test_lookup() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = -1;
+		container[2] = 45;
+		container[3] = 12;
+		container[4] = 96;
+
+		TS_ASSERT_EQUALS(container[0], 17);
+		TS_ASSERT_EQUALS(container[1], -1);
+		TS_ASSERT_EQUALS(container[2], 45);
+		TS_ASSERT_EQUALS(container[3], 12);
+		TS_ASSERT_EQUALS(container[4], 96);
+	}
+
+	void test_lookup_with_default() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = -1;
+		container[2] = 45;
+		container[3] = 12;
+		container[4] = 96;
+
+		// We take a const ref now to ensure that the map
+		// is not modified by getValOrDefault.
+		const Common::FlatHashMap<int, int> &containerRef = container;
+
+		TS_ASSERT_EQUALS(containerRef.getValOrDefault(0), 17);
+		TS_ASSERT_EQUALS(containerRef.getValOrDefault(17), 0);
+		TS_ASSERT_EQUALS(containerRef.getValOrDefault(0, -10), 17);
+		TS_ASSERT_EQUALS(containerRef.getValOrDefault(17, -10), -10);
+	}
+
+	void test_iterator_begin_end() {
+		Common::FlatHashMap<int, int> container;
+
+		// The container is initially empty ...
+		TS_ASSERT_EQUALS(container.begin(), container.end());
+
+		// ... then non-empty ...
+		container[324] = 33;
+		TS_ASSERT_DIFFERS(container.begin(), container.end());
+
+		// ... and again empty.
+		container.clear();
+		TS_ASSERT_EQUALS(container.begin(), container.end());
+	}
+
+	void test_hash_map_copy() {
+		Common::FlatHashMap<int, int> map1, container2;
+		map1[323] = 32;
+		container2 = map1;
+		TS_ASSERT_EQUALS(container2[323], 32);
+	}
+
+	void test_collision() {
+		// NB: The usefulness of this example depends strongly on the
+		// specific hashmap implementation.
+		// It is constructed to insert multiple colliding elements.
+		Common::FlatHashMap<int, int> h;
+		h[5] = 1;
+		h[32+5] = 1;
+		h[64+5] = 1;
+		h[128+5] = 1;
+		TS_ASSERT(h.contains(5));
+		TS_ASSERT(h.contains(32+5));
+		TS_ASSERT(h.contains(64+5));
+		TS_ASSERT(h.contains(128+5));
+		h.erase(32+5);
+		TS_ASSERT(h.contains(5));
+		TS_ASSERT(h.contains(64+5));
+		TS_ASSERT(h.contains(128+5));
+		h.erase(5);
+		TS_ASSERT(h.contains(64+5));
+		TS_ASSERT(h.contains(128+5));
+		h[32+5] = 1;
+		TS_ASSERT(h.contains(32+5));
+		TS_ASSERT(h.contains(64+5));
+		TS_ASSERT(h.contains(128+5));
+		h[5] = 1;
+		TS_ASSERT(h.contains(5));
+		TS_ASSERT(h.contains(32+5));
+		TS_ASSERT(h.contains(64+5));
+		TS_ASSERT(h.contains(128+5));
+		h.erase(5);
+		TS_ASSERT(h.contains(32+5));
+		TS_ASSERT(h.contains(64+5));
+		TS_ASSERT(h.contains(128+5));
+		h.erase(64+5);
+		TS_ASSERT(h.contains(32+5));
+		TS_ASSERT(h.contains(128+5));
+		h.erase(128+5);
+		TS_ASSERT(h.contains(32+5));
+		h.erase(32+5);
+		TS_ASSERT(h.empty());
+	}
+
+	void test_high_bit_keys() {
+		// Keys like SCI resource ids, (type << 16) | number, may only differ
+		// in their high bits, and must still be spread over the groups.
+		Common::FlatHashMap<uint, uint> container;
+		for (uint i = 0; i < 4096; ++i)
+			container[(i << 16) | 5] = i;
+
+		uint total = 0, longest = 0;
+		for (uint i = 0; i < 4096; ++i) {
+			const uint probes = container.probeLength((i << 16) | 5);
+			total += probes;
+			longest = MAX(longest, probes);
+		}
+		TS_ASSERT_LESS_THAN(total, 4096u * 2);
+		TS_ASSERT_LESS_THAN_EQUALS(longest, 16u);
+
+		// Looking up missing keys stops as soon as possible as well.
+		TS_ASSERT_LESS_THAN_EQUALS(container.probeLength((5000u << 16) | 5), 16u);
+	}
+
+	void test_iterator() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = 33;
+		container[2] = 45;
+		container[3] = 12;
+		container[4] = 96;
+		container.erase(1);
+		container[1] = 42;
+		container.erase(0);
+		container.erase(1);
+
+		int found = 0;
+		Common::FlatHashMap<int, int>::iterator i;
+		for (i = container.begin(); i != container.end(); ++i) {
+			int key = i->_key;
+			TS_ASSERT(key >= 0 && key <= 4);
+			TS_ASSERT(!(found & (1 << key)));
+			found |= 1 << key;
+		}
+		TS_ASSERT(found == 16+8+4);
+
+		found = 0;
+		Common::FlatHashMap<int, int>::const_iterator j;
+		for (j = container.begin(); j != container.end(); ++j) {
+			int key = j->_key;
+			TS_ASSERT(key >= 0 && key <= 4);
+			TS_ASSERT(!(found & (1 << key)));
+			found |= 1 << key;
+		}
+		TS_ASSERT(found == 16+8+4);
+}
+
+	void test_string_keys() {
+		Common::FlatHashMap<Common::String, int, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> container;
+		container["Foo"] = 1;
+		container["BAR"] = 2;
+		TS_ASSERT(container.contains("foo"));
+		TS_ASSERT(container.contains("bar"));
+		TS_ASSERT_EQUALS(container.getVal("FOO"), 1);
+		container["foo"] = 3;
+		TS_ASSERT_EQUALS(container.size(), 2u);
+		TS_ASSERT_EQUALS(container.getVal("Foo"), 3);
+	}
+
+	void test_against_hashmap() {
+		// Perform the same random operations on a FlatHashMap and a
+		// HashMap, with enough keys to make the map grow several times
+		// and to leave plenty of erased slots around.
+		Common::FlatHashMap<uint, uint> flat;
+		Common::HashMap<uint, uint> reference;
+		uint32 seed = 12345;
+
+		for (int i = 0; i < 20000; ++i) {
+			seed = seed * 1664525 + 1013904223;
+			const uint key = (seed >> 8) % 3000;
+			if ((seed >> 28) < 5) {
+				flat.erase(key);
+				reference.erase(key);
+			} else {
+				flat[key] = i;
+				reference[key] = i;
+			}
+			TS_ASSERT_EQUALS(flat.size(), reference.size());
+		}
+
+		for (uint key = 0; key < 3000; ++key) {
+			TS_ASSERT_EQUALS(flat.contains(key), reference.contains(key));
+			TS_ASSERT_EQUALS(flat.getValOrDefault(key, 12345678), reference.getValOrDefault(key, 12345678));
+		}
+
+		uint count = 0;
+		for (Common::FlatHashMap<uint, uint>::const_iterator i = flat.begin(); i != flat.end(); ++i) {
+			TS_ASSERT_EQUALS(i->_value, reference.getVal(i->_key));
+			++count;
+		}
+		TS_ASSERT_EQUALS(count, reference.size());
+
+		// Erasing everything while iterating must leave an empty map
+		for (Common::FlatHashMap<uint, uint>::iterator i = flat.begin(); i != flat.end(); ++i)
+			flat.erase(i);
+		TS_ASSERT(flat.empty());
+		TS_ASSERT_EQUALS(flat.begin(), flat.end());
+	}
+};
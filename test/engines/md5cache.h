@@ -0,0 +1,103 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+
+#include "engines/md5cache.h"
+
+static bool md5CacheTestExists(const Common::Path &path) {
+	// Only the "games" directory and its "kept" file still exist
+	Common::String name = path.toString('/');
+	if (name.hasSuffix("/"))
+		name.deleteLastChar();
+	return name == "games" || name == "games/kept";
+}
+
+class PersistentMD5CacheTestSuite : public CxxTest::TestSuite {
+public:
+	void test_hit_and_miss() {
+		PersistentMD5Cache cache;
+		int64 size = 0;
+		Common::String md5;
+
+		TS_ASSERT(!cache.lookup("f:5000:games/a", "10:1", size, md5));
+		TS_ASSERT_EQUALS(cache.getStats().misses, 1u);
+
+		cache.store("f:5000:games/a", Common::Path("games/a"), "10:1", 10, "0123456789abcdef0123456789abcdef");
+		TS_ASSERT(cache.isDirty());
+
+		TS_ASSERT(cache.lookup("f:5000:games/a", "10:1", size, md5));
+		TS_ASSERT_EQUALS(size, 10);
+		TS_ASSERT_EQUALS(md5, "0123456789abcdef0123456789abcdef");
+		TS_ASSERT_EQUALS(cache.getStats().hits, 1u);
+
+		// Same file hashed differently
+		TS_ASSERT(!cache.lookup("t:5000:games/a", "10:1", size, md5));
+		TS_ASSERT_EQUALS(cache.getStats().misses, 2u);
+	}
+
+	void test_invalidation() {
+		PersistentMD5Cache cache;
+		int64 size = 0;
+		Common::String md5;
+
+		cache.store("f:5000:games/a", Common::Path("games/a"), "10:1", 10, "0123456789abcdef0123456789abcdef");
+
+		// A file replaced by another one of the same size
+		TS_ASSERT(!cache.lookup("f:5000:games/a", "10:2", size, md5));
+		TS_ASSERT_EQUALS(cache.getStats().invalidated, 1u);
+		TS_ASSERT_EQUALS(cache.size(), 0u);
+
+		// The stale entry is gone for good
+		TS_ASSERT(!cache.lookup("f:5000:games/a", "10:1", size, md5));
+		TS_ASSERT_EQUALS(cache.getStats().invalidated, 1u);
+	}
+
+	void test_pruning() {
+		PersistentMD5Cache cache;
+
+		cache.store("f:5000:games/kept", Common::Path("games/kept"), "10:1", 10, "0123456789abcdef0123456789abcdef");
+		cache.store("f:5000:games/removed", Common::Path("games/removed"), "10:1", 10, "0123456789abcdef0123456789abcdef");
+		cache.store("f:5000:offline/file", Common::Path("offline/file"), "10:1", 10, "0123456789abcdef0123456789abcdef");
+
+		TS_ASSERT_EQUALS(cache.prune(&md5CacheTestExists), 1u);
+		TS_ASSERT_EQUALS(cache.getStats().pruned, 1u);
+		TS_ASSERT_EQUALS(cache.size(), 2u);
+
+		int64 size = 0;
+		Common::String md5;
+		TS_ASSERT(cache.lookup("f:5000:games/kept", "10:1", size, md5));
+		TS_ASSERT(!cache.lookup("f:5000:games/removed", "10:1", size, md5));
+
+		// Entries on a missing drive are kept
+		TS_ASSERT(cache.lookup("f:5000:offline/file", "10:1", size, md5));
+	}
+
+	void test_save_and_load() {
+		PersistentMD5Cache cache;
+		cache.store("f:5000:games/a", Common::Path("games/a"), "10:1", 10, "0123456789abcdef0123456789abcdef");
+		cache.store("tr:5000:games/b", Common::Path("games/b"), "20:2,-,-,30:3", 1234, "fedcba9876543210fedcba9876543210");
+
+		Common::MemoryWriteStreamDynamic out(DisposeAfterUse::YES);
+		cache.save(out);
+		TS_ASSERT(!cache.isDirty());
+
+		Common::MemoryReadStream in(out.getData(), out.size());
+		PersistentMD5Cache loaded;
+		TS_ASSERT(loaded.load(in));
+		TS_ASSERT_EQUALS(loaded.size(), 2u);
+
+		int64 size = 0;
+		Common::String md5;
+		TS_ASSERT(loaded.lookup("tr:5000:games/b", "20:2,-,-,30:3", size, md5));
+		TS_ASSERT_EQUALS(size, 1234);
+		TS_ASSERT_EQUALS(md5, "fedcba9876543210fedcba9876543210");
+		TS_ASSERT_EQUALS(loaded.prune(&md5CacheTestExists), 2u);
+
+		// Files of an older format are ignored
+		const char oldCache[] = "ScummVM detection cache 1\n10\t0123456789abcdef0123456789abcdef\tf:5000:games/a\n";
+		Common::MemoryReadStream oldIn((const byte *)oldCache, sizeof(oldCache) - 1);
+		PersistentMD5Cache old;
+		TS_ASSERT(!old.load(oldIn));
+		TS_ASSERT_EQUALS(old.size(), 0u);
+	}
+};
@@ -0,0 +1,110 @@
+#include <cxxtest/TestSuite.h>
+
+#include "engines/sci/resource/resource_lru.h"
+
+struct SegmentedLRUTestItem {
+	SegmentedLRUTestItem(int itemSize = 100, bool itemAudio = false) : _size(itemSize), audio(itemAudio) {}
+
+	int size() const { return _size; }
+
+	int _size;
+	bool audio;
+	Sci::SegmentedLRUNode<SegmentedLRUTestItem> _lruNode;
+};
+
+class SegmentedLRUTestSuite : public CxxTest::TestSuite {
+public:
+	void test_eviction_order() {
+		Sci::SegmentedLRU<SegmentedLRUTestItem> lru;
+		lru.setMaxMemory(1000);
+		SegmentedLRUTestItem a, b, c;
+
+		lru.push(&a, false);
+		lru.push(&b, false);
+		lru.push(&c, false);
+		TS_ASSERT_EQUALS(lru.getMemory(), 300);
+		TS_ASSERT_EQUALS(lru.leastRecentlyUsed(), &a);
+
+		// Using an item again protects it
+		lru.remove(&a);
+		lru.push(&a, true);
+		TS_ASSERT(lru.isProtected(&a));
+		TS_ASSERT_EQUALS(lru.getProtectedMemory(), 100);
+		TS_ASSERT_EQUALS(lru.getProbationaryMemory(), 200);
+
+		// The probationary segment is evicted first, least recent first
+		TS_ASSERT_EQUALS(lru.leastRecentlyUsed(), &b);
+		lru.remove(&b);
+		TS_ASSERT_EQUALS(lru.leastRecentlyUsed(), &c);
+		lru.remove(&c);
+		TS_ASSERT_EQUALS(lru.leastRecentlyUsed(), &a);
+		lru.remove(&a);
+
+		TS_ASSERT(lru.empty());
+		TS_ASSERT_EQUALS(lru.getMemory(), 0);
+		TS_ASSERT_EQUALS(lru.getProtectedMemory(), 0);
+	}
+
+	void test_one_time_items_keep_protected_ones() {
+		Sci::SegmentedLRU<SegmentedLRUTestItem> lru;
+		lru.setMaxMemory(1000);
+		SegmentedLRUTestItem used;
+		SegmentedLRUTestItem burst[20];
+
+		lru.push(&used, false);
+		lru.remove(&used);
+		lru.push(&used, true);
+
+		// Evicting as the resource manager does, after each new item
+		for (int i = 0; i < 20; i++) {
+			lru.push(&burst[i], false);
+			while (lru.isOverBudget())
+				lru.remove(lru.leastRecentlyUsed());
+		}
+
+		TS_ASSERT(lru.isProtected(&used));
+		TS_ASSERT_EQUALS(lru.getMemory(), 1000);
+		TS_ASSERT_EQUALS(lru.leastRecentlyUsed(), &burst[11]);
+	}
+
+	void test_protected_budget() {
+		Sci::SegmentedLRU<SegmentedLRUTestItem> lru;
+		lru.setMaxMemory(1000);
+		TS_ASSERT_EQUALS(lru.getProtectedBudget(), 750);
+		TS_ASSERT_EQUALS(lru.getProbationaryBudget(), 250);
+
+		SegmentedLRUTestItem items[8];
+		for (int i = 0; i < 8; i++)
+			lru.push(&items[i], true);
+
+		// The least recently used protected items are demoted
+		TS_ASSERT_EQUALS(lru.getProtectedMemory(), 700);
+		TS_ASSERT(!lru.isProtected(&items[0]));
+		TS_ASSERT(lru.isProtected(&items[1]));
+		TS_ASSERT_EQUALS(lru.leastRecentlyUsed(), &items[0]);
+
+		// Promoting a demoted item demotes the next least recent one
+		lru.remove(&items[0]);
+		lru.push(&items[0], true);
+		TS_ASSERT(lru.isProtected(&items[0]));
+		TS_ASSERT(!lru.isProtected(&items[1]));
+		TS_ASSERT_EQUALS(lru.leastRecentlyUsed(), &items[1]);
+	}
+
+	void test_find_least_recently_used() {
+		Sci::SegmentedLRU<SegmentedLRUTestItem> lru;
+		lru.setMaxMemory(1000);
+		SegmentedLRUTestItem speech1(100, true), speech2(100, true), view;
+
+		lru.push(&speech1, true);
+		lru.push(&view, false);
+		lru.push(&speech2, false);
+
+		auto isAudio = [](const SegmentedLRUTestItem *item) { return item->audio; };
+		TS_ASSERT_EQUALS(lru.findLeastRecentlyUsed(isAudio), &speech2);
+		lru.remove(&speech2);
+		TS_ASSERT_EQUALS(lru.findLeastRecentlyUsed(isAudio), &speech1);
+		lru.remove(&speech1);
+		TS_ASSERT(!lru.findLeastRecentlyUsed(isAudio));
+	}
+};
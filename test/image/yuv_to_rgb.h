@@ -0,0 +1,189 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#if defined(HAVE_CONFIG_H)
+#include "config.h"
+#endif
+
+#include "common/array.h"
+#include "graphics/surface.h"
+#include "graphics/yuv_to_rgb.h"
+
+class YUVToRGBTestSuite : public CxxTest::TestSuite {
+	enum Subsampling {
+		kYUV444,
+		kYUV422,
+		kYUV420,
+		kYUVA420,
+		kYUV410
+	};
+
+	static const int kWidth = 52;
+	static const int kHeight = 12;
+	static const int kPitch = kWidth + 8;
+
+	byte _y[kPitch * kHeight], _u[kPitch * kHeight], _v[kPitch * kHeight], _a[kPitch * kHeight];
+
+	void convert(Graphics::Surface &dst, Subsampling subsampling, Graphics::YUVToRGBManager::LuminanceScale scale, int width, int height) {
+		switch (subsampling) {
+		case kYUV444:
+			YUVToRGBMan.convert444(&dst, scale, _y, _u, _v, width, height, kPitch, kPitch);
+			break;
+		case kYUV422:
+			YUVToRGBMan.convert422(&dst, scale, _y, _u, _v, width, height, kPitch, kPitch);
+			break;
+		case kYUV420:
+			YUVToRGBMan.convert420(&dst, scale, _y, _u, _v, width, height, kPitch, kPitch);
+			break;
+		case kYUVA420:
+			YUVToRGBMan.convert420Alpha(&dst, scale, _y, _u, _v, _a, width, height, kPitch, kPitch);
+			break;
+		case kYUV410:
+			YUVToRGBMan.convert410(&dst, scale, _y, _u, _v, width, height, kPitch, kPitch);
+			break;
+		}
+	}
+
+	// Compare a row converter against the lookup tables
+	void checkRowFunc(Graphics::YUVToRGBManager::ConvertRowFunc func) {
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+			Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 0, 0, 8, 16, 0)
+		};
+		const Graphics::YUVToRGBManager::LuminanceScale scales[] = {
+			Graphics::YUVToRGBManager::kScaleFull,
+			Graphics::YUVToRGBManager::kScaleITU
+		};
+		const Subsampling subsamplings[] = { kYUV444, kYUV422, kYUV420, kYUVA420, kYUV410 };
+		// Including widths which are not divisible by the chroma subsampling
+		const int widths[] = { 4, 5, 6, 7, 36, 37, kWidth };
+
+		Graphics::YUVToRGBManager::ConvertRowFunc oldFunc = Graphics::YUVToRGBManager::convertRowFunc;
+
+		for (uint f = 0; f < ARRAYSIZE(formats); f++) {
+			for (uint s = 0; s < ARRAYSIZE(scales); s++) {
+				for (uint c = 0; c < ARRAYSIZE(subsamplings); c++) {
+					for (uint w = 0; w < ARRAYSIZE(widths); w++) {
+						const int height = (subsamplings[c] == kYUV410) ? 8 : 6;
+						Graphics::Surface expected, actual;
+						expected.create(widths[w], height, formats[f]);
+						actual.create(widths[w], height, formats[f]);
+
+						Graphics::YUVToRGBManager::convertRowFunc = Graphics::YUVToRGBManager::convertRowGeneric;
+						convert(expected, subsamplings[c], scales[s], widths[w], height);
+						Graphics::YUVToRGBManager::convertRowFunc = func;
+						convert(actual, subsamplings[c], scales[s], widths[w], height);
+
+						for (int y = 0; y < height; y++)
+							TS_ASSERT_SAME_DATA(expected.getBasePtr(0, y), actual.getBasePtr(0, y), widths[w] * formats[f].bytesPerPixel);
+
+						expected.free();
+						actual.free();
+					}
+				}
+			}
+		}
+
+		Graphics::YUVToRGBManager::convertRowFunc = oldFunc;
+	}
+
+public:
+	void setUp() {
+		// Cover the whole range of every component, including the
+		// luminance values outside of the ITU range
+		uint32 seed = 0x1234567;
+		for (int i = 0; i < kPitch * kHeight; i++) {
+			seed = seed * 1103515245 + 12345;
+			_y[i] = seed >> 24;
+			_u[i] = seed >> 16;
+			_v[i] = seed >> 8;
+			_a[i] = (seed >> 20) ^ i;
+		}
+	}
+
+	void test_convert_row_generic() {
+		const byte y[4] = { 0, 16, 128, 255 };
+		const byte a[4] = { 0, 64, 128, 255 };
+		const int16 crR[4] = { -10, 0, 20, 10 };
+		const int16 crbG[4] = { 0, -16, 0, 0 };
+		const int16 cbB[4] = { 10, 219, -128, -255 };
+		uint32 pixels[4];
+
+		Graphics::YUVToRGBManager::RowParams params;
+		params.bytesPerPixel = 4;
+		params.scale = Graphics::YUVToRGBManager::kScaleFull;
+		params.rLoss = params.gLoss = params.bLoss = params.aLoss = 0;
+		params.rShift = 16;
+		params.gShift = 8;
+		params.bShift = 0;
+		params.aShift = 24;
+
+		Graphics::YUVToRGBManager::convertRowGeneric((byte *)pixels, y, a, crR, crbG, cbB, 4, params);
+		TS_ASSERT_EQUALS(pixels[0], 0x0000000Au);
+		TS_ASSERT_EQUALS(pixels[1], 0x401000EBu);
+		TS_ASSERT_EQUALS(pixels[2], 0x80948000u);
+		TS_ASSERT_EQUALS(pixels[3], 0xFFFFFF00u);
+
+		// Without an alpha source, the pixels are opaque
+		params.scale = Graphics::YUVToRGBManager::kScaleITU;
+		Graphics::YUVToRGBManager::convertRowGeneric((byte *)pixels, y, nullptr, crR, crbG, cbB, 4, params);
+		TS_ASSERT_EQUALS(pixels[0], 0xFF000000u);
+		TS_ASSERT_EQUALS(pixels[1], 0xFF0000FFu);
+		TS_ASSERT_EQUALS(pixels[2], 0xFF998200u);
+		TS_ASSERT_EQUALS(pixels[3], 0xFFFFFF00u);
+	}
+
+	void test_convert_uneven_width() {
+		// Columns without a whole chroma sample are left alone, and the
+		// other ones are converted as for the narrower width
+		const Graphics::PixelFormat format(4, 8, 8, 8, 8, 24, 16, 8, 0);
+		const Subsampling subsamplings[] = { kYUV422, kYUV420, kYUVA420, kYUV410 };
+		Graphics::YUVToRGBManager::ConvertRowFunc oldFunc = Graphics::YUVToRGBManager::convertRowFunc;
+		Graphics::YUVToRGBManager::convertRowFunc = Graphics::YUVToRGBManager::convertRowGeneric;
+
+		for (uint c = 0; c < ARRAYSIZE(subsamplings); c++) {
+			const int width = 7, height = 8;
+			const int coveredWidth = (subsamplings[c] == kYUV410) ? 4 : 6;
+			Graphics::Surface expected, actual;
+			expected.create(coveredWidth, height, format);
+			actual.create(width, height, format);
+
+			convert(expected, subsamplings[c], Graphics::YUVToRGBManager::kScaleFull, coveredWidth, height);
+			convert(actual, subsamplings[c], Graphics::YUVToRGBManager::kScaleFull, width, height);
+
+			for (int y = 0; y < height; y++) {
+				TS_ASSERT_SAME_DATA(expected.getBasePtr(0, y), actual.getBasePtr(0, y), coveredWidth * format.bytesPerPixel);
+				for (int x = coveredWidth; x < width; x++)
+					TS_ASSERT_EQUALS(*(const uint32 *)actual.getBasePtr(x, y), 0u);
+			}
+
+			expected.free();
+			actual.free();
+		}
+
+		Graphics::YUVToRGBManager::convertRowFunc = oldFunc;
+	}
+
+	void test_convert_row_neon() {
+#ifdef SCUMMVM_NEON
+		checkRowFunc(Graphics::YUVToRGBManager::convertRowNEON);
+#endif
+	}
+
+	void test_convert_row_sse2() {
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			checkRowFunc(Graphics::YUVToRGBManager::convertRowSSE2);
+#endif
+	}
+
+	void test_convert_row_avx2() {
+#ifdef SCUMMVM_AVX2
+		if (instrset_detect() >= 8)
+			checkRowFunc(Graphics::YUVToRGBManager::convertRowAVX2);
+#endif
+	}
+};
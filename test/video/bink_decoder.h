@@ -0,0 +1,134 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#if defined(HAVE_CONFIG_H)
+#include "config.h"
+#endif
+
+#include "common/random.h"
+#include "video/bink_decoder.h"
+
+class BinkDecoderTestSuite : public CxxTest::TestSuite {
+#ifdef USE_BINK
+	typedef Video::BinkDecoder::BinkVideoTrack BinkVideoTrack;
+
+	// Wider than a block, so that writes past its right edge are caught
+	static const int kPitch = 16;
+
+	enum BlockKind {
+		kBlockRandom,
+		kBlockSaturated,
+		kBlockDCOnly,
+		kBlockSparse,
+		kBlockKindCount
+	};
+
+	/** Fill a block with values within +-2047, the range of the bundles. */
+	template<typename T>
+	static void fillBlock(T *block, BlockKind kind, Common::RandomSource &rnd) {
+		for (int i = 0; i < 64; i++) {
+			switch (kind) {
+			case kBlockRandom:
+				block[i] = (T)rnd.getRandomNumber(4094) - 2047;
+				break;
+			case kBlockSaturated:
+				block[i] = rnd.getRandomBit() ? 2047 : -2047;
+				break;
+			case kBlockDCOnly:
+				block[i] = (i == 0) ? (T)rnd.getRandomNumber(4094) - 2047 : 0;
+				break;
+			case kBlockSparse:
+				block[i] = (rnd.getRandomNumber(7) == 0) ? (T)rnd.getRandomNumber(4094) - 2047 : 0;
+				break;
+			default:
+				break;
+			}
+		}
+	}
+
+	static void fillPlane(byte *plane, Common::RandomSource &rnd) {
+		for (int i = 0; i < kPitch * 8; i++)
+			plane[i] = rnd.getRandomNumber(255);
+	}
+
+	template<typename T, typename Func>
+	static void checkKernel(Func expectedFunc, Func actualFunc) {
+		Common::RandomSource rnd("bink");
+		T block[64];
+		byte expected[kPitch * 8], actual[kPitch * 8];
+
+		for (int i = 0; i < 200; i++) {
+			fillBlock(block, (BlockKind)(i % kBlockKindCount), rnd);
+			fillPlane(expected, rnd);
+			memcpy(actual, expected, sizeof(actual));
+
+			expectedFunc(expected, kPitch, block);
+			actualFunc(actual, kPitch, block);
+
+			TS_ASSERT_EQUALS(memcmp(expected, actual, sizeof(actual)), 0);
+		}
+	}
+
+	static void checkIDCTPut(BinkVideoTrack::IDCTFunc func) {
+		checkKernel<int32>(BinkVideoTrack::IDCTPutGeneric, func);
+	}
+
+	static void checkIDCTAdd(BinkVideoTrack::IDCTFunc func) {
+		checkKernel<int32>(BinkVideoTrack::IDCTAddGeneric, func);
+	}
+
+	static void checkAddResidue(BinkVideoTrack::ResidueFunc func) {
+		checkKernel<int16>(BinkVideoTrack::addResidueGeneric, func);
+	}
+#endif
+
+public:
+	void test_idct_generic() {
+#ifdef USE_BINK
+		// A block holding only a DC coefficient is flat
+		int32 block[64] = { 0 };
+		byte plane[kPitch * 8];
+		memset(plane, 0, sizeof(plane));
+
+		block[0] = 100 << 8;
+		BinkVideoTrack::IDCTPutGeneric(plane, kPitch, block);
+		for (int y = 0; y < 8; y++) {
+			for (int x = 0; x < kPitch; x++)
+				TS_ASSERT_EQUALS(plane[y * kPitch + x], x < 8 ? 100 : 0);
+		}
+
+		BinkVideoTrack::IDCTAddGeneric(plane, kPitch, block);
+		for (int y = 0; y < 8; y++) {
+			for (int x = 0; x < kPitch; x++)
+				TS_ASSERT_EQUALS(plane[y * kPitch + x], x < 8 ? 200 : 0);
+		}
+#endif
+	}
+
+	void test_kernels_neon() {
+#if defined(USE_BINK) && defined(SCUMMVM_NEON)
+		checkIDCTPut(BinkVideoTrack::IDCTPutNEON);
+		checkIDCTAdd(BinkVideoTrack::IDCTAddNEON);
+		checkAddResidue(BinkVideoTrack::addResidueNEON);
+#endif
+	}
+
+	void test_kernels_sse2() {
+#if defined(USE_BINK) && defined(SCUMMVM_SSE2)
+		if (instrset_detect() >= 2) {
+			checkIDCTPut(BinkVideoTrack::IDCTPutSSE2);
+			checkIDCTAdd(BinkVideoTrack::IDCTAddSSE2);
+			checkAddResidue(BinkVideoTrack::addResidueSSE2);
+		}
+#endif
+	}
+
+	void test_kernels_avx2() {
+#if defined(USE_BINK) && defined(SCUMMVM_AVX2)
+		if (instrset_detect() >= 8) {
+			checkIDCTPut(BinkVideoTrack::IDCTPutAVX2);
+			checkIDCTAdd(BinkVideoTrack::IDCTAddAVX2);
+		}
+#endif
+	}
+};
@@ -0,0 +1,115 @@
+#include <cxxtest/TestSuite.h>
+
+#include "video/video_decoder.h"
+#include "graphics/surface.h"
+
+#include "../null_osystem.h"
+
+// A video of ten 1x1 frames at ten frames per second, where the pixel of
+// each frame holds its number
+class CountingVideoDecoder : public Video::VideoDecoder {
+public:
+	bool loadStream(Common::SeekableReadStream *stream) override {
+		addTrack(new CountingVideoTrack());
+		return true;
+	}
+
+private:
+	class CountingVideoTrack : public FixedRateVideoTrack {
+	public:
+		CountingVideoTrack() : _curFrame(-1) {
+			_surface.create(1, 1, Graphics::PixelFormat::createFormatCLUT8());
+		}
+
+		~CountingVideoTrack() override {
+			_surface.free();
+		}
+
+		uint16 getWidth() const override { return 1; }
+		uint16 getHeight() const override { return 1; }
+		Graphics::PixelFormat getPixelFormat() const override { return _surface.format; }
+		int getCurFrame() const override { return _curFrame; }
+		int getFrameCount() const override { return 10; }
+
+		const Graphics::Surface *decodeNextFrame() override {
+			_curFrame++;
+			*(byte *)_surface.getPixels() = _curFrame;
+			return &_surface;
+		}
+
+		bool isSeekable() const override { return true; }
+
+		bool seek(const Audio::Timestamp &time) override {
+			_curFrame = getFrameAtTime(time) - 1;
+			return true;
+		}
+
+	protected:
+		Common::Rational getFrameRate() const override { return 10; }
+
+	private:
+		int _curFrame;
+		Graphics::Surface _surface;
+	};
+};
+
+class VideoDecoderTestSuite : public CxxTest::TestSuite {
+public:
+	VideoDecoderTestSuite() {
+		Common::install_null_g_system();
+	}
+
+	static int frameNumber(const Graphics::Surface *frame) {
+		return frame ? *(const byte *)frame->getPixels() : -1;
+	}
+
+	void test_frame_ahead_order() {
+		CountingVideoDecoder decoder;
+		decoder.loadStream(nullptr);
+		TS_ASSERT(decoder.setFrameAhead(3));
+
+		// Nothing is decoded ahead before the first frame is asked for
+		decoder.decodeFramesAhead(1000);
+		TS_ASSERT_EQUALS(decoder.getCurFrame(), -1);
+
+		TS_ASSERT_EQUALS(frameNumber(decoder.decodeNextFrame()), 0);
+		TS_ASSERT(!decoder.setFrameAhead(0));
+
+		// The frames decoded ahead are not visible until handed over
+		decoder.decodeFramesAhead(1000);
+		TS_ASSERT_EQUALS(decoder.getCurFrame(), 0);
+		TS_ASSERT_EQUALS(decoder.getTimeToNextFrame(), 100u);
+
+		for (int frame = 1; frame < 10; frame++) {
+			decoder.decodeFramesAhead(0);
+			TS_ASSERT(!decoder.endOfVideo());
+			TS_ASSERT_EQUALS(frameNumber(decoder.decodeNextFrame()), frame);
+			TS_ASSERT_EQUALS(decoder.getCurFrame(), frame);
+		}
+
+		TS_ASSERT(decoder.endOfVideo());
+	}
+
+	void test_frame_ahead_seek_rewind() {
+		CountingVideoDecoder decoder;
+		decoder.loadStream(nullptr);
+		TS_ASSERT(decoder.setFrameAhead(3));
+
+		TS_ASSERT_EQUALS(frameNumber(decoder.decodeNextFrame()), 0);
+		decoder.decodeFramesAhead(1000);
+
+		// Seeking throws the frames decoded ahead away
+		TS_ASSERT(decoder.seek(Audio::Timestamp(500, 1000)));
+		TS_ASSERT_EQUALS(decoder.getCurFrame(), 4);
+		TS_ASSERT_EQUALS(frameNumber(decoder.decodeNextFrame()), 5);
+
+		decoder.decodeFramesAhead(1000);
+		TS_ASSERT_EQUALS(decoder.getCurFrame(), 5);
+
+		// So does rewinding
+		TS_ASSERT(decoder.rewind());
+		TS_ASSERT_EQUALS(decoder.getCurFrame(), -1);
+		TS_ASSERT_EQUALS(frameNumber(decoder.decodeNextFrame()), 0);
+		TS_ASSERT_EQUALS(frameNumber(decoder.decodeNextFrame()), 1);
+	}
+};
@@ -0,0 +1,157 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "common/scummsys.h"
+
+#ifdef USE_BINK
+
+#include "video/bink_decoder.h"
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace Video {
+
+template<int factor>
+static FORCEINLINE __m256i mulShift(__m256i x) {
+	return _mm256_srai_epi32(_mm256_mullo_epi32(x, _mm256_set1_epi32(factor)), 11);
+}
+
+/** One dimensional IDCT of all eight columns at once, in place. */
+template<bool row>
+static FORCEINLINE void idct8(__m256i *s) {
+	const __m256i a0 = _mm256_add_epi32(s[0], s[4]);
+	const __m256i a1 = _mm256_sub_epi32(s[0], s[4]);
+	const __m256i a2 = _mm256_add_epi32(s[2], s[6]);
+	const __m256i a3 = mulShift<2896>(_mm256_sub_epi32(s[2], s[6]));
+	const __m256i a4 = _mm256_add_epi32(s[5], s[3]);
+	const __m256i a5 = _mm256_sub_epi32(s[5], s[3]);
+	const __m256i a6 = _mm256_add_epi32(s[1], s[7]);
+	const __m256i a7 = _mm256_sub_epi32(s[1], s[7]);
+	const __m256i b0 = _mm256_add_epi32(a4, a6);
+	const __m256i b1 = mulShift<3784>(_mm256_add_epi32(a5, a7));
+	const __m256i b2 = _mm256_add_epi32(_mm256_sub_epi32(mulShift<-5352>(a5), b0), b1);
+	const __m256i b3 = _mm256_sub_epi32(mulShift<2896>(_mm256_sub_epi32(a6, a4)), b2);
+	const __m256i b4 = _mm256_sub_epi32(_mm256_add_epi32(mulShift<2217>(a7), b3), b1);
+
+	const __m256i c0 = _mm256_add_epi32(a0, a2);
+	const __m256i c1 = _mm256_sub_epi32(_mm256_add_epi32(a1, a3), a2);
+	const __m256i c2 = _mm256_add_epi32(_mm256_sub_epi32(a1, a3), a2);
+	const __m256i c3 = _mm256_sub_epi32(a0, a2);
+
+	s[0] = _mm256_add_epi32(c0, b0);
+	s[1] = _mm256_add_epi32(c1, b2);
+	s[2] = _mm256_add_epi32(c2, b3);
+	s[3] = _mm256_sub_epi32(c3, b4);
+	s[4] = _mm256_add_epi32(c3, b4);
+	s[5] = _mm256_sub_epi32(c2, b3);
+	s[6] = _mm256_sub_epi32(c1, b2);
+	s[7] = _mm256_sub_epi32(c0, b0);
+
+	if (row) {
+		const __m256i round = _mm256_set1_epi32(0x7F);
+		for (int i = 0; i < 8; i++)
+			s[i] = _mm256_srai_epi32(_mm256_add_epi32(s[i], round), 8);
+	}
+}
+
+static FORCEINLINE void transpose8(__m256i *s) {
+	__m256i t[8], u[8];
+
+	for (int i = 0; i < 8; i += 2) {
+		t[i]     = _mm256_unpacklo_epi32(s[i], s[i + 1]);
+		t[i + 1] = _mm256_unpackhi_epi32(s[i], s[i + 1]);
+	}
+
+	for (int i = 0; i < 8; i += 4) {
+		u[i]     = _mm256_unpacklo_epi64(t[i],     t[i + 2]);
+		u[i + 1] = _mm256_unpackhi_epi64(t[i],     t[i + 2]);
+		u[i + 2] = _mm256_unpacklo_epi64(t[i + 1], t[i + 3]);
+		u[i + 3] = _mm256_unpackhi_epi64(t[i + 1], t[i + 3]);
+	}
+
+	for (int i = 0; i < 4; i++) {
+		s[i]     = _mm256_permute2x128_si256(u[i], u[i + 4], 0x20);
+		s[i + 4] = _mm256_permute2x128_si256(u[i], u[i + 4], 0x31);
+	}
+}
+
+/**
+ * Inverse transform a block into four vectors of pixels, each holding
+ * two rows.
+ */
+static FORCEINLINE void idct(const int32 *block, __m128i *pixels) {
+	__m256i s[8];
+
+	for (int i = 0; i < 8; i++)
+		s[i] = _mm256_loadu_si256((const __m256i *)(block + i * 8));
+
+	idct8<false>(s);
+	transpose8(s);
+	idct8<true>(s);
+	transpose8(s);
+
+	const __m256i mask = _mm256_set1_epi32(0xFF);
+	for (int i = 0; i < 8; i += 2) {
+		// Packing works within the 128-bit lanes, giving the words of
+		// row i and row i + 1 interleaved four at a time
+		const __m256i words = _mm256_packs_epi32(_mm256_and_si256(s[i], mask), _mm256_and_si256(s[i + 1], mask));
+		const __m256i rows = _mm256_permute4x64_epi64(words, _MM_SHUFFLE(3, 1, 2, 0));
+		pixels[i / 2] = _mm_packus_epi16(_mm256_castsi256_si128(rows), _mm256_extracti128_si256(rows, 1));
+	}
+}
+
+void BinkDecoder::BinkVideoTrack::IDCTPutAVX2(byte *dest, uint32 pitch, const int32 *block) {
+	__m128i pixels[4];
+	idct(block, pixels);
+
+	for (int i = 0; i < 4; i++, dest += pitch * 2) {
+		_mm_storel_epi64((__m128i *)dest, pixels[i]);
+		_mm_storel_epi64((__m128i *)(dest + pitch), _mm_unpackhi_epi64(pixels[i], pixels[i]));
+	}
+}
+
+void BinkDecoder::BinkVideoTrack::IDCTAddAVX2(byte *dest, uint32 pitch, const int32 *block) {
+	__m128i pixels[4];
+	idct(block, pixels);
+
+	for (int i = 0; i < 4; i++, dest += pitch * 2) {
+		const __m128i old = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)dest), _mm_loadl_epi64((const __m128i *)(dest + pitch)));
+		const __m128i sum = _mm_add_epi8(old, pixels[i]);
+		_mm_storel_epi64((__m128i *)dest, sum);
+		_mm_storel_epi64((__m128i *)(dest + pitch), _mm_unpackhi_epi64(sum, sum));
+	}
+}
+
+} // End of namespace Video
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // USE_BINK
@@ -0,0 +1,162 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "common/scummsys.h"
+
+#if defined(USE_BINK) && defined(SCUMMVM_NEON)
+
+#include "video/bink_decoder.h"
+
+#include <arm_neon.h>
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("neon"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+namespace Video {
+
+/** One dimensional IDCT of four columns at once, in place. */
+template<bool row>
+static FORCEINLINE void idct8(int32x4_t *s) {
+	const int32x4_t a0 = vaddq_s32(s[0], s[4]);
+	const int32x4_t a1 = vsubq_s32(s[0], s[4]);
+	const int32x4_t a2 = vaddq_s32(s[2], s[6]);
+	const int32x4_t a3 = vshrq_n_s32(vmulq_n_s32(vsubq_s32(s[2], s[6]), 2896), 11);
+	const int32x4_t a4 = vaddq_s32(s[5], s[3]);
+	const int32x4_t a5 = vsubq_s32(s[5], s[3]);
+	const int32x4_t a6 = vaddq_s32(s[1], s[7]);
+	const int32x4_t a7 = vsubq_s32(s[1], s[7]);
+	const int32x4_t b0 = vaddq_s32(a4, a6);
+	const int32x4_t b1 = vshrq_n_s32(vmulq_n_s32(vaddq_s32(a5, a7), 3784), 11);
+	const int32x4_t b2 = vaddq_s32(vsubq_s32(vshrq_n_s32(vmulq_n_s32(a5, -5352), 11), b0), b1);
+	const int32x4_t b3 = vsubq_s32(vshrq_n_s32(vmulq_n_s32(vsubq_s32(a6, a4), 2896), 11), b2);
+	const int32x4_t b4 = vsubq_s32(vaddq_s32(vshrq_n_s32(vmulq_n_s32(a7, 2217), 11), b3), b1);
+
+	const int32x4_t c0 = vaddq_s32(a0, a2);
+	const int32x4_t c1 = vsubq_s32(vaddq_s32(a1, a3), a2);
+	const int32x4_t c2 = vaddq_s32(vsubq_s32(a1, a3), a2);
+	const int32x4_t c3 = vsubq_s32(a0, a2);
+
+	s[0] = vaddq_s32(c0, b0);
+	s[1] = vaddq_s32(c1, b2);
+	s[2] = vaddq_s32(c2, b3);
+	s[3] = vsubq_s32(c3, b4);
+	s[4] = vaddq_s32(c3, b4);
+	s[5] = vsubq_s32(c2, b3);
+	s[6] = vsubq_s32(c1, b2);
+	s[7] = vsubq_s32(c0, b0);
+
+	if (row) {
+		const int32x4_t round = vdupq_n_s32(0x7F);
+		for (int i = 0; i < 8; i++)
+			s[i] = vshrq_n_s32(vaddq_s32(s[i], round), 8);
+	}
+}
+
+static FORCEINLINE void transpose4(int32x4_t &a, int32x4_t &b, int32x4_t &c, int32x4_t &d) {
+	const int32x4x2_t ab = vtrnq_s32(a, b);
+	const int32x4x2_t cd = vtrnq_s32(c, d);
+	a = vcombine_s32(vget_low_s32(ab.val[0]),  vget_low_s32(cd.val[0]));
+	b = vcombine_s32(vget_low_s32(ab.val[1]),  vget_low_s32(cd.val[1]));
+	c = vcombine_s32(vget_high_s32(ab.val[0]), vget_high_s32(cd.val[0]));
+	d = vcombine_s32(vget_high_s32(ab.val[1]), vget_high_s32(cd.val[1]));
+}
+
+/**
+ * Transpose an 8x8 block held as the left (l) and right (r) halves of
+ * its rows.
+ */
+static FORCEINLINE void transpose8(int32x4_t *l, int32x4_t *r) {
+	transpose4(l[0], l[1], l[2], l[3]);
+	transpose4(r[0], r[1], r[2], r[3]);
+	transpose4(l[4], l[5], l[6], l[7]);
+	transpose4(r[4], r[5], r[6], r[7]);
+
+	for (int i = 0; i < 4; i++) {
+		const int32x4_t t = r[i];
+		r[i] = l[i + 4];
+		l[i + 4] = t;
+	}
+}
+
+/** Inverse transform a block into eight rows of pixels. */
+static FORCEINLINE void idct(const int32 *block, uint8x8_t *rows) {
+	int32x4_t l[8], r[8];
+
+	for (int i = 0; i < 8; i++) {
+		l[i] = vld1q_s32(block + i * 8);
+		r[i] = vld1q_s32(block + i * 8 + 4);
+	}
+
+	idct8<false>(l);
+	idct8<false>(r);
+	transpose8(l, r);
+	idct8<true>(l);
+	idct8<true>(r);
+	transpose8(l, r);
+
+	// Narrowing keeps the low bits, just like storing into a byte
+	for (int i = 0; i < 8; i++)
+		rows[i] = vmovn_u16(vreinterpretq_u16_s16(vcombine_s16(vmovn_s32(l[i]), vmovn_s32(r[i]))));
+}
+
+void BinkDecoder::BinkVideoTrack::IDCTPutNEON(byte *dest, uint32 pitch, const int32 *block) {
+	uint8x8_t rows[8];
+	idct(block, rows);
+
+	for (int i = 0; i < 8; i++, dest += pitch)
+		vst1_u8(dest, rows[i]);
+}
+
+void BinkDecoder::BinkVideoTrack::IDCTAddNEON(byte *dest, uint32 pitch, const int32 *block) {
+	uint8x8_t rows[8];
+	idct(block, rows);
+
+	for (int i = 0; i < 8; i++, dest += pitch)
+		vst1_u8(dest, vadd_u8(vld1_u8(dest), rows[i]));
+}
+
+void BinkDecoder::BinkVideoTrack::addResidueNEON(byte *dest, uint32 pitch, const int16 *block) {
+	for (int i = 0; i < 8; i++, dest += pitch, block += 8) {
+		const uint8x8_t residue = vmovn_u16(vreinterpretq_u16_s16(vld1q_s16(block)));
+		vst1_u8(dest, vadd_u8(vld1_u8(dest), residue));
+	}
+}
+
+} // End of namespace Video
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#endif // defined(USE_BINK) && defined(SCUMMVM_NEON)
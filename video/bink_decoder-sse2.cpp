@@ -0,0 +1,194 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include "common/scummsys.h"
+
+#ifdef USE_BINK
+
+#include "video/bink_decoder.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace Video {
+
+/**
+ * Multiply four 32-bit values by a constant, keeping the low 32 bits
+ * of the products. SSE2 has no 32-bit multiplication, so the even and
+ * odd lanes are multiplied separately as 64-bit products.
+ */
+template<int factor>
+static FORCEINLINE __m128i mulConst(__m128i x) {
+	const __m128i f = _mm_set1_epi32(factor);
+	__m128i even = _mm_mul_epu32(x, f);
+	__m128i odd  = _mm_mul_epu32(_mm_srli_epi64(x, 32), f);
+	return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+/** One dimensional IDCT of four columns at once, in place. */
+template<bool row>
+static FORCEINLINE void idct8(__m128i *s) {
+	const __m128i a0 = _mm_add_epi32(s[0], s[4]);
+	const __m128i a1 = _mm_sub_epi32(s[0], s[4]);
+	const __m128i a2 = _mm_add_epi32(s[2], s[6]);
+	const __m128i a3 = _mm_srai_epi32(mulConst<2896>(_mm_sub_epi32(s[2], s[6])), 11);
+	const __m128i a4 = _mm_add_epi32(s[5], s[3]);
+	const __m128i a5 = _mm_sub_epi32(s[5], s[3]);
+	const __m128i a6 = _mm_add_epi32(s[1], s[7]);
+	const __m128i a7 = _mm_sub_epi32(s[1], s[7]);
+	const __m128i b0 = _mm_add_epi32(a4, a6);
+	const __m128i b1 = _mm_srai_epi32(mulConst<3784>(_mm_add_epi32(a5, a7)), 11);
+	const __m128i b2 = _mm_add_epi32(_mm_sub_epi32(_mm_srai_epi32(mulConst<-5352>(a5), 11), b0), b1);
+	const __m128i b3 = _mm_sub_epi32(_mm_srai_epi32(mulConst<2896>(_mm_sub_epi32(a6, a4)), 11), b2);
+	const __m128i b4 = _mm_sub_epi32(_mm_add_epi32(_mm_srai_epi32(mulConst<2217>(a7), 11), b3), b1);
+
+	const __m128i c0 = _mm_add_epi32(a0, a2);
+	const __m128i c1 = _mm_sub_epi32(_mm_add_epi32(a1, a3), a2);
+	const __m128i c2 = _mm_add_epi32(_mm_sub_epi32(a1, a3), a2);
+	const __m128i c3 = _mm_sub_epi32(a0, a2);
+
+	s[0] = _mm_add_epi32(c0, b0);
+	s[1] = _mm_add_epi32(c1, b2);
+	s[2] = _mm_add_epi32(c2, b3);
+	s[3] = _mm_sub_epi32(c3, b4);
+	s[4] = _mm_add_epi32(c3, b4);
+	s[5] = _mm_sub_epi32(c2, b3);
+	s[6] = _mm_sub_epi32(c1, b2);
+	s[7] = _mm_sub_epi32(c0, b0);
+
+	if (row) {
+		const __m128i round = _mm_set1_epi32(0x7F);
+		for (int i = 0; i < 8; i++)
+			s[i] = _mm_srai_epi32(_mm_add_epi32(s[i], round), 8);
+	}
+}
+
+static FORCEINLINE void transpose4(__m128i &a, __m128i &b, __m128i &c, __m128i &d) {
+	const __m128i t0 = _mm_unpacklo_epi32(a, b);
+	const __m128i t1 = _mm_unpacklo_epi32(c, d);
+	const __m128i t2 = _mm_unpackhi_epi32(a, b);
+	const __m128i t3 = _mm_unpackhi_epi32(c, d);
+	a = _mm_unpacklo_epi64(t0, t1);
+	b = _mm_unpackhi_epi64(t0, t1);
+	c = _mm_unpacklo_epi64(t2, t3);
+	d = _mm_unpackhi_epi64(t2, t3);
+}
+
+/**
+ * Transpose an 8x8 block held as the left (l) and right (r) halves of
+ * its rows.
+ */
+static FORCEINLINE void transpose8(__m128i *l, __m128i *r) {
+	transpose4(l[0], l[1], l[2], l[3]);
+	transpose4(r[0], r[1], r[2], r[3]);
+	transpose4(l[4], l[5], l[6], l[7]);
+	transpose4(r[4], r[5], r[6], r[7]);
+
+	for (int i = 0; i < 4; i++) {
+		const __m128i t = r[i];
+		r[i] = l[i + 4];
+		l[i + 4] = t;
+	}
+}
+
+/**
+ * Inverse transform a block, leaving the low byte of each result in the
+ * low byte of every 16-bit lane of the eight rows.
+ */
+static FORCEINLINE void idct(const int32 *block, __m128i *rows) {
+	__m128i l[8], r[8];
+
+	for (int i = 0; i < 8; i++) {
+		l[i] = _mm_loadu_si128((const __m128i *)(block + i * 8));
+		r[i] = _mm_loadu_si128((const __m128i *)(block + i * 8 + 4));
+	}
+
+	idct8<false>(l);
+	idct8<false>(r);
+	transpose8(l, r);
+	idct8<true>(l);
+	idct8<true>(r);
+	transpose8(l, r);
+
+	const __m128i mask = _mm_set1_epi32(0xFF);
+	for (int i = 0; i < 8; i++)
+		rows[i] = _mm_packs_epi32(_mm_and_si128(l[i], mask), _mm_and_si128(r[i], mask));
+}
+
+void BinkDecoder::BinkVideoTrack::IDCTPutSSE2(byte *dest, uint32 pitch, const int32 *block) {
+	__m128i rows[8];
+	idct(block, rows);
+
+	for (int i = 0; i < 8; i += 2, dest += pitch * 2) {
+		const __m128i pixels = _mm_packus_epi16(rows[i], rows[i + 1]);
+		_mm_storel_epi64((__m128i *)dest, pixels);
+		_mm_storel_epi64((__m128i *)(dest + pitch), _mm_unpackhi_epi64(pixels, pixels));
+	}
+}
+
+void BinkDecoder::BinkVideoTrack::IDCTAddSSE2(byte *dest, uint32 pitch, const int32 *block) {
+	__m128i rows[8];
+	idct(block, rows);
+
+	for (int i = 0; i < 8; i += 2, dest += pitch * 2) {
+		const __m128i pixels = _mm_packus_epi16(rows[i], rows[i + 1]);
+		const __m128i old = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)dest), _mm_loadl_epi64((const __m128i *)(dest + pitch)));
+		const __m128i sum = _mm_add_epi8(old, pixels);
+		_mm_storel_epi64((__m128i *)dest, sum);
+		_mm_storel_epi64((__m128i *)(dest + pitch), _mm_unpackhi_epi64(sum, sum));
+	}
+}
+
+void BinkDecoder::BinkVideoTrack::addResidueSSE2(byte *dest, uint32 pitch, const int16 *block) {
+	const __m128i mask = _mm_set1_epi16(0xFF);
+
+	for (int i = 0; i < 8; i += 2, dest += pitch * 2, block += 16) {
+		const __m128i row0 = _mm_and_si128(_mm_loadu_si128((const __m128i *)block), mask);
+		const __m128i row1 = _mm_and_si128(_mm_loadu_si128((const __m128i *)(block + 8)), mask);
+		const __m128i old = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)dest), _mm_loadl_epi64((const __m128i *)(dest + pitch)));
+		const __m128i sum = _mm_add_epi8(old, _mm_packus_epi16(row0, row1));
+		_mm_storel_epi64((__m128i *)dest, sum);
+		_mm_storel_epi64((__m128i *)(dest + pitch), _mm_unpackhi_epi64(sum, sum));
+	}
+}
+
+} // End of namespace Video
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
+
+#endif // USE_BINK
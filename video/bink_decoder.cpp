@@ -281,6 +281,8 @@ BinkDecoder::BinkVideoTrack::BinkVideoTrack(uint32 width, uint32 height, uint32
 
 	_pixelFormat = g_system->getScreenFormat();
 
+	initKernels();
+
 	// Default to a 32bpp format, if in 8bpp mode
 	if (_pixelFormat.bytesPerPixel == 1)
 		_pixelFormat = Graphics::PixelFormat(4, 8, 8, 8, 8, 8, 16, 24, 0);
@@ -815,11 +817,12 @@ void BinkDecoder::BinkVideoTrack::blockScaledIntra(DecodeContext &ctx) {
 
 	readDCTCoeffs(*ctx.video, block, true);
 
-	IDCT(block);
+	byte pixels[64];
+	IDCTPut(pixels, 8, block);
 
-	int32 *src   = block;
-	byte  *dest1 = ctx.dest;
-	byte  *dest2 = ctx.dest + ctx.pitch;
+	const byte *src = pixels;
+	byte *dest1 = ctx.dest;
+	byte *dest2 = ctx.dest + ctx.pitch;
 	for (int j = 0; j < 8; j++, dest1 += (ctx.pitch << 1) - 16, dest2 += (ctx.pitch << 1) - 16, src += 8) {
 
 		for (int i = 0; i < 8; i++, dest1 += 2, dest2 += 2)
@@ -945,11 +948,7 @@ void BinkDecoder::BinkVideoTrack::blockResidue(DecodeContext &ctx) {
 
 	readResidue(*ctx.video, block, v);
 
-	byte  *dst = ctx.dest;
-	int16 *src = block;
-	for (int i = 0; i < 8; i++, dst += ctx.pitch, src += 8)
-		for (int j = 0; j < 8; j++)
-			dst[j] += src[j];
+	addResidue(ctx.dest, ctx.pitch, block);
 }
 
 void BinkDecoder::BinkVideoTrack::blockIntra(DecodeContext &ctx) {
@@ -960,7 +959,7 @@ void BinkDecoder::BinkVideoTrack::blockIntra(DecodeContext &ctx) {
 
 	readDCTCoeffs(*ctx.video, block, true);
 
-	IDCTPut(ctx, block);
+	IDCTPut(ctx.dest, ctx.pitch, block);
 }
 
 void BinkDecoder::BinkVideoTrack::blockFill(DecodeContext &ctx) {
@@ -981,7 +980,7 @@ void BinkDecoder::BinkVideoTrack::blockInter(DecodeContext &ctx) {
 
 	readDCTCoeffs(*ctx.video, block, false);
 
-	IDCTAdd(ctx, block);
+	IDCTAdd(ctx.dest, ctx.pitch, block);
 }
 
 void BinkDecoder::BinkVideoTrack::blockPattern(DecodeContext &ctx) {
@@ -1461,37 +1460,69 @@ static inline void IDCTCol(int32 *dest, const int32 *src) {
 	}
 }
 
-void BinkDecoder::BinkVideoTrack::IDCT(int32 *block) {
+void BinkDecoder::BinkVideoTrack::IDCTPutGeneric(byte *dest, uint32 pitch, const int32 *block) {
 	int i;
 	int32 temp[64];
-
 	for (i = 0; i < 8; i++)
 		IDCTCol(&temp[i], &block[i]);
 	for (i = 0; i < 8; i++) {
-		IDCT_ROW( (&block[8*i]), (&temp[8*i]) );
+		IDCT_ROW( (&dest[i*pitch]), (&temp[8*i]) );
 	}
 }
 
-void BinkDecoder::BinkVideoTrack::IDCTAdd(DecodeContext &ctx, int32 *block) {
+void BinkDecoder::BinkVideoTrack::IDCTAddGeneric(byte *dest, uint32 pitch, const int32 *block) {
 	int i, j;
-
-	IDCT(block);
-	byte *dest = ctx.dest;
-	for (i = 0; i < 8; i++, dest += ctx.pitch, block += 8)
-		for (j = 0; j < 8; j++)
-			 dest[j] += block[j];
-}
-
-void BinkDecoder::BinkVideoTrack::IDCTPut(DecodeContext &ctx, int32 *block) {
-	int i;
 	int32 temp[64];
+	int32 row[8];
 	for (i = 0; i < 8; i++)
 		IDCTCol(&temp[i], &block[i]);
-	for (i = 0; i < 8; i++) {
-		IDCT_ROW( (&ctx.dest[i*ctx.pitch]), (&temp[8*i]) );
+	for (i = 0; i < 8; i++, dest += pitch) {
+		IDCT_ROW( row, (&temp[8*i]) );
+		for (j = 0; j < 8; j++)
+			dest[j] += row[j];
 	}
 }
 
+void BinkDecoder::BinkVideoTrack::addResidueGeneric(byte *dest, uint32 pitch, const int16 *block) {
+	for (int i = 0; i < 8; i++, dest += pitch, block += 8)
+		for (int j = 0; j < 8; j++)
+			dest[j] += block[j];
+}
+
+BinkDecoder::BinkVideoTrack::IDCTFunc BinkDecoder::BinkVideoTrack::IDCTPut = nullptr;
+BinkDecoder::BinkVideoTrack::IDCTFunc BinkDecoder::BinkVideoTrack::IDCTAdd = nullptr;
+BinkDecoder::BinkVideoTrack::ResidueFunc BinkDecoder::BinkVideoTrack::addResidue = nullptr;
+
+void BinkDecoder::BinkVideoTrack::initKernels() {
+	// If no kernels have been selected yet, detect and select
+	if (IDCTPut)
+		return;
+
+	IDCTPut = IDCTPutGeneric;
+	IDCTAdd = IDCTAddGeneric;
+	addResidue = addResidueGeneric;
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON)) {
+		IDCTPut = IDCTPutNEON;
+		IDCTAdd = IDCTAddNEON;
+		addResidue = addResidueNEON;
+	}
+#endif
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) {
+		IDCTPut = IDCTPutSSE2;
+		IDCTAdd = IDCTAddSSE2;
+		addResidue = addResidueSSE2;
+	}
+#endif
+#ifdef SCUMMVM_AVX2
+	if (g_system->hasFeature(OSystem::kFeatureCpuAVX2)) {
+		IDCTPut = IDCTPutAVX2;
+		IDCTAdd = IDCTAddAVX2;
+	}
+#endif
+}
+
 BinkDecoder::BinkAudioTrack::BinkAudioTrack(BinkDecoder::AudioInfo &audio, Audio::Mixer::SoundType soundType) :
 		AudioTrack(soundType),
 		_audioInfo(&audio) {
@@ -58,6 +58,8 @@ namespace Graphics {
 struct Surface;
 }
 
+class BinkDecoderTestSuite;
+
 namespace Video {
 
 /**
@@ -84,6 +86,8 @@ protected:
 	uint32 findKeyFrame(uint32 frame) const;
 
 private:
+	friend class ::BinkDecoderTestSuite;
+
 	static const int kAudioChannelsMax  = 2;
 	static const int kAudioBlockSizeMax = (kAudioChannelsMax << 11);
 
@@ -337,10 +341,39 @@ private:
 		void readDCTCoeffs   (VideoFrame &video, int32 *block, bool isIntra);
 		void readResidue     (VideoFrame &video, int16 *block, int masksCount);
 
-		// Bink video IDCT
-		void IDCT(int32 *block);
-		void IDCTPut(DecodeContext &ctx, int32 *block);
-		void IDCTAdd(DecodeContext &ctx, int32 *block);
+		// Bink video IDCT and residue kernels
+		typedef void (*IDCTFunc)(byte *dest, uint32 pitch, const int32 *block);
+		typedef void (*ResidueFunc)(byte *dest, uint32 pitch, const int16 *block);
+
+		/** Inverse transform a block of coefficients and store it into the plane. */
+		static void IDCTPutGeneric(byte *dest, uint32 pitch, const int32 *block);
+		/** Inverse transform a block of coefficients and add it to the plane. */
+		static void IDCTAddGeneric(byte *dest, uint32 pitch, const int32 *block);
+		/** Add a block of residues to the plane. */
+		static void addResidueGeneric(byte *dest, uint32 pitch, const int16 *block);
+#ifdef SCUMMVM_NEON
+		static void IDCTPutNEON(byte *dest, uint32 pitch, const int32 *block);
+		static void IDCTAddNEON(byte *dest, uint32 pitch, const int32 *block);
+		static void addResidueNEON(byte *dest, uint32 pitch, const int16 *block);
+#endif
+#ifdef SCUMMVM_SSE2
+		static void IDCTPutSSE2(byte *dest, uint32 pitch, const int32 *block);
+		static void IDCTAddSSE2(byte *dest, uint32 pitch, const int32 *block);
+		static void addResidueSSE2(byte *dest, uint32 pitch, const int16 *block);
+#endif
+#ifdef SCUMMVM_AVX2
+		static void IDCTPutAVX2(byte *dest, uint32 pitch, const int32 *block);
+		static void IDCTAddAVX2(byte *dest, uint32 pitch, const int32 *block);
+#endif
+
+		/** Select the fastest kernels the CPU supports, if not done yet. */
+		static void initKernels();
+
+		static IDCTFunc IDCTPut;
+		static IDCTFunc IDCTAdd;
+		static ResidueFunc addResidue;
+
+		friend class ::BinkDecoderTestSuite;
 	};
 
 	class BinkAudioTrack : public AudioTrack {
@@ -19,6 +19,18 @@ MODULE_OBJS := \
 ifdef USE_BINK
 MODULE_OBJS += \
 	bink_decoder.o
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	bink_decoder-neon.o
+endif
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	bink_decoder-sse2.o
+endif
+ifdef SCUMMVM_AVX2
+MODULE_OBJS += \
+	bink_decoder-avx2.o
+endif
 endif
 
 ifdef USE_HNM
@@ -28,8 +28,39 @@
 #include "common/file.h"
 #include "common/system.h"
 
+#include "graphics/surface.h"
+
 namespace Video {
 
+struct VideoDecoder::QueuedFrame {
+	Graphics::Surface surface;
+	bool hasFrame;
+	bool dirtyPalette;
+	byte palette[256 * 3];
+	VideoTrackState stateBefore; ///< The state of the track before decoding the frame
+};
+
+class VideoDecoder::FrameAheadQueue {
+public:
+	FrameAheadQueue(VideoTrack *videoTrack, uint frameCount) : track(videoTrack), frames(frameCount + 1), head(0), queued(0), started(false) {}
+
+	~FrameAheadQueue() {
+		for (auto &frame : frames)
+			frame.surface.free();
+	}
+
+	VideoTrack *track;
+
+	// One more frame than decoded ahead, for the one handed over last
+	Common::Array<QueuedFrame> frames;
+	uint head;
+	uint queued;
+	bool started;
+
+	VideoTrackState stateAfter; ///< The state of the track after decoding the queued frames
+	byte palette[256 * 3];
+};
+
 VideoDecoder::VideoDecoder() {
 	_startTime = 0;
 	_dirtyPalette = false;
@@ -47,10 +78,19 @@ VideoDecoder::VideoDecoder() {
 	_mainAudioTrack = 0;
 	_canSetDither = true;
 	_canSetDefaultFormat = true;
+	_canSetFrameAhead = true;
+	_frameAhead = nullptr;
 	_videoCodecAccuracy = Image::CodecAccuracy::Default;
 }
 
+VideoDecoder::~VideoDecoder() {
+	stopFrameAhead();
+}
+
 void VideoDecoder::close() {
+	// Stop decoding ahead before the tracks go away
+	stopFrameAhead();
+
 	if (isPlaying())
 		stop();
 
@@ -74,6 +114,7 @@ void VideoDecoder::close() {
 	_mainAudioTrack = 0;
 	_canSetDither = true;
 	_canSetDefaultFormat = true;
+	_canSetFrameAhead = true;
 }
 
 bool VideoDecoder::loadFile(const Common::Path &filename) {
@@ -114,6 +155,11 @@ bool VideoDecoder::needsUpdate() const {
 }
 
 void VideoDecoder::delayMillis(uint msecs) {
+	// Spend the time decoding frames ahead first, see setFrameAhead()
+	uint32 startTime = g_system->getMillis();
+	decodeFramesAhead(msecs);
+	msecs -= MIN<uint>(msecs, g_system->getMillis() - startTime);
+
 	if (!needsUpdate())
 		g_system->delayMillis(MIN<uint>(msecs, getTimeToNextFrame()));
 	else
@@ -211,6 +257,10 @@ const Graphics::Surface *VideoDecoder::decodeNextFrame() {
 	_needsUpdate = false;
 	_canSetDither = false;
 	_canSetDefaultFormat = false;
+	_canSetFrameAhead = false;
+
+	if (_frameAhead)
+		return decodeNextFrameAhead();
 
 	readNextPacket();
 
@@ -237,6 +287,18 @@ bool VideoDecoder::setReverse(bool reverse) {
 	if (reverse && hasAudio())
 		return false;
 
+	// Go back to the frame after the one handed over last, since the
+	// frames decoded ahead are not going to be shown in reverse
+	if (_frameAhead && reverse && _frameAhead->queued) {
+		VideoTrackState state = getVideoTrackState(_frameAhead->track);
+		if (!_frameAhead->track->isSeekable())
+			return false;
+
+		flushFrameAhead();
+		if (!seekIntern(_frameAhead->track->getFrameTime(state.curFrame + 1)))
+			return false;
+	}
+
 	// Attempt to make sure all the tracks are in the requested direction
 	for (auto &track : _tracks) {
 		if (track->getTrackType() == Track::kTrackTypeVideo && ((VideoTrack *)track)->isReversed() != reverse) {
@@ -247,6 +309,7 @@ bool VideoDecoder::setReverse(bool reverse) {
 		}
 	}
 
+	flushFrameAhead();
 	findNextVideoTrack();
 	return true;
 }
@@ -261,7 +324,7 @@ int VideoDecoder::getCurFrame() const {
 
 	for (const auto &track : _tracks)
 		if (track->getTrackType() == Track::kTrackTypeVideo)
-			frame += ((VideoTrack *)track)->getCurFrame() + 1;
+			frame += getVideoTrackState((const VideoTrack *)track).curFrame + 1;
 
 	return frame;
 }
@@ -302,7 +365,7 @@ uint32 VideoDecoder::getTimeToNextFrame() const {
 		return 0;
 
 	uint32 currentTime = getTime();
-	uint32 nextFrameStartTime = _nextVideoTrack->getNextFrameStartTime();
+	uint32 nextFrameStartTime = getVideoTrackState(_nextVideoTrack).nextFrameStartTime;
 
 	if (_nextVideoTrack->isReversed()) {
 		// For reversed videos, we need to handle the time difference the opposite way.
@@ -321,8 +384,16 @@ uint32 VideoDecoder::getTimeToNextFrame() const {
 
 bool VideoDecoder::endOfVideo() const {
 	for (const auto &track : _tracks) {
-		bool videoEndTimeReached = _endTimeSet && track->getTrackType() == Track::kTrackTypeVideo && ((const VideoTrack *)track)->getNextFrameStartTime() >= (uint)_endTime.msecs();
-		bool endReached = track->endOfTrack() || (isPlaying() && videoEndTimeReached);
+		bool endReached;
+
+		if (track->getTrackType() == Track::kTrackTypeVideo) {
+			VideoTrackState state = getVideoTrackState((const VideoTrack *)track);
+			bool videoEndTimeReached = _endTimeSet && state.nextFrameStartTime >= (uint)_endTime.msecs();
+			endReached = state.endOfTrack || (isPlaying() && videoEndTimeReached);
+		} else {
+			endReached = track->endOfTrack();
+		}
+
 		if (!endReached)
 			return false;
 	}
@@ -349,10 +420,15 @@ bool VideoDecoder::rewind() {
 	if (isPlaying())
 		stopAudio();
 
+	// Throw away the frames decoded ahead, also if this fails half way
+	flushFrameAhead();
+
 	for (auto &track : _tracks)
 		if (!track->rewind())
 			return false;
 
+	flushFrameAhead();
+
 	// Now that we've rewound, start all tracks again
 	if (isPlaying())
 		startAudio();
@@ -383,10 +459,15 @@ bool VideoDecoder::seek(const Audio::Timestamp &time) {
 	if (isPlaying())
 		stopAudio();
 
+	// Throw away the frames decoded ahead, also if this fails half way
+	flushFrameAhead();
+
 	// Do the actual seeking
 	if (!seekIntern(time))
 		return false;
 
+	flushFrameAhead();
+
 	// Seek any external track too
 	for (auto &track : _externalTracks)
 		if (!track->seek(time))
@@ -574,6 +655,138 @@ bool VideoDecoder::setOutputPixelFormats(const Common::List<Graphics::PixelForma
 	return false;
 }
 
+bool VideoDecoder::setFrameAhead(uint frames) {
+	// Frames can only be decoded ahead before the first frame
+	if (!_canSetFrameAhead)
+		return false;
+
+	stopFrameAhead();
+
+	if (frames == 0)
+		return true;
+
+	VideoTrack *videoTrack = nullptr;
+
+	for (auto &track : _tracks) {
+		if (track->getTrackType() == Track::kTrackTypeVideo) {
+			// We only allow this when one video track is present
+			if (videoTrack)
+				return false;
+
+			videoTrack = (VideoTrack *)track;
+		}
+	}
+
+	if (!videoTrack)
+		return false;
+
+	_frameAhead = new FrameAheadQueue(videoTrack, frames);
+	flushFrameAhead();
+	return true;
+}
+
+void VideoDecoder::stopFrameAhead() {
+	delete _frameAhead;
+	_frameAhead = nullptr;
+}
+
+void VideoDecoder::decodeFramesAhead(uint32 maxTime) {
+	if (!_frameAhead)
+		return;
+
+	// Try not to make the next frame late. This is only best effort: the
+	// time budget is checked between frames, so one slow frame can overrun it.
+	uint32 startTime = g_system->getMillis();
+	while (!needsUpdate() && decodeFrameAhead(true)) {
+		if (g_system->getMillis() - startTime >= maxTime)
+			break;
+	}
+}
+
+void VideoDecoder::flushFrameAhead() {
+	if (!_frameAhead)
+		return;
+
+	_frameAhead->queued = 0;
+	_frameAhead->stateAfter.read(_frameAhead->track);
+}
+
+bool VideoDecoder::decodeFrameAhead(bool ahead) {
+	VideoTrack *track = _frameAhead->track;
+
+	// Only decode ahead once the first frame was asked for, so that the
+	// output format can't change anymore, and while playing forward
+	if (ahead && (!_frameAhead->started || track->isReversed() || track->endOfTrack()))
+		return false;
+
+	if (_frameAhead->queued + 1 >= _frameAhead->frames.size())
+		return false;
+
+	// The frame after the queued ones is never the one handed over last
+	QueuedFrame &frame = _frameAhead->frames[(_frameAhead->head + _frameAhead->queued) % _frameAhead->frames.size()];
+	frame.stateBefore.read(track);
+
+	readNextPacket();
+
+	const Graphics::Surface *surface = track->endOfTrack() ? nullptr : track->decodeNextFrame();
+	frame.hasFrame = surface != nullptr;
+
+	if (surface) {
+		if (frame.surface.w != surface->w || frame.surface.h != surface->h || frame.surface.format != surface->format) {
+			frame.surface.free();
+			frame.surface.create(surface->w, surface->h, surface->format);
+		}
+
+		frame.surface.copyRectToSurface(*surface, 0, 0, Common::Rect(surface->w, surface->h));
+	}
+
+	frame.dirtyPalette = track->hasDirtyPalette();
+	if (frame.dirtyPalette)
+		memcpy(frame.palette, track->getPalette(), sizeof(frame.palette));
+
+	_frameAhead->queued++;
+	_frameAhead->stateAfter.read(track);
+	return true;
+}
+
+const Graphics::Surface *VideoDecoder::decodeNextFrameAhead() {
+	_frameAhead->started = true;
+
+	// Nothing was decoded ahead, so decode the frame right away
+	if (!_frameAhead->queued)
+		decodeFrameAhead(false);
+
+	const QueuedFrame *frame = &_frameAhead->frames[_frameAhead->head];
+	_frameAhead->head = (_frameAhead->head + 1) % _frameAhead->frames.size();
+	_frameAhead->queued--;
+
+	if (frame->dirtyPalette) {
+		memcpy(_frameAhead->palette, frame->palette, sizeof(_frameAhead->palette));
+		_palette = _frameAhead->palette;
+		_dirtyPalette = true;
+	}
+
+	// Look for the next video track here for the next decode.
+	findNextVideoTrack();
+
+	return frame->hasFrame ? &frame->surface : nullptr;
+}
+
+VideoDecoder::VideoTrackState VideoDecoder::getVideoTrackState(const VideoTrack *track) const {
+	VideoTrackState state;
+
+	if (_frameAhead && _frameAhead->track == track && !track->isReversed()) {
+		if (_frameAhead->queued)
+			state = _frameAhead->frames[_frameAhead->head].stateBefore;
+		else
+			state = _frameAhead->stateAfter;
+	} else {
+		state.read(track);
+	}
+
+	return state;
+}
+
 void VideoDecoder::setVideoCodecAccuracy(Image::CodecAccuracy accuracy) {
 	_videoCodecAccuracy = accuracy;
 
@@ -948,7 +1161,7 @@ void VideoDecoder::setEndFrame(uint frame) {
 
 void VideoDecoder::resetStartTime() {
 	if (_nextVideoTrack) {
-		Audio::Timestamp curTime = _nextVideoTrack->getFrameTime(_nextVideoTrack->getCurFrame());
+		Audio::Timestamp curTime = _nextVideoTrack->getFrameTime(getVideoTrackState(_nextVideoTrack).curFrame);
 		if (isPlaying()) {
 			_startTime = g_system->getMillis() - (curTime.msecs() / _playbackRate).toInt();
 		}
@@ -982,9 +1195,14 @@ VideoDecoder::VideoTrack *VideoDecoder::findNextVideoTrack() {
 	uint32 bestTime = 0xFFFFFFFF;
 
 	for (auto &track : _tracks) {
-		if (track->getTrackType() == Track::kTrackTypeVideo && !track->endOfTrack()) {
-			VideoTrack *videoTrack = (VideoTrack *)track;
-			uint32 time = videoTrack->getNextFrameStartTime();
+		if (track->getTrackType() != Track::kTrackTypeVideo)
+			continue;
+
+		VideoTrack *videoTrack = (VideoTrack *)track;
+		VideoTrackState state = getVideoTrackState(videoTrack);
+
+		if (!state.endOfTrack) {
+			uint32 time = state.nextFrameStartTime;
 
 			if (time < bestTime) {
 				bestTime = time;
@@ -1036,10 +1254,10 @@ bool VideoDecoder::hasFramesLeft() const {
 		if (track->getTrackType() != Track::kTrackTypeVideo)
 			continue;
 
-		const VideoTrack *videoTrack = (const VideoTrack *)track;
+		VideoTrackState state = getVideoTrackState((const VideoTrack *)track);
 
-		bool videoEndTimeReached = _endTimeSet && videoTrack->getNextFrameStartTime() >= (uint)_endTime.msecs();
-		bool endReached = videoTrack->endOfTrack() || (isPlaying() && videoEndTimeReached);
+		bool videoEndTimeReached = _endTimeSet && state.nextFrameStartTime >= (uint)_endTime.msecs();
+		bool endReached = state.endOfTrack || (isPlaying() && videoEndTimeReached);
 		if (!endReached)
 			return true;
 	}
@@ -53,7 +53,7 @@ namespace Video {
 class VideoDecoder {
 public:
 	VideoDecoder();
-	virtual ~VideoDecoder() {}
+	virtual ~VideoDecoder();
 
 	/////////////////////////////////////////
 	// Opening/Closing a Video
@@ -332,7 +332,8 @@ public:
 
 	/**
 	 * Delay/sleep for the specified amount of milliseconds, or until the next
-	 * frame should be displayed.
+	 * frame should be displayed. Frames are decoded ahead during that time,
+	 * if setFrameAhead() was used.
 	 */
 	void delayMillis(uint msecs);
 
@@ -424,6 +425,36 @@ public:
 	 */
 	virtual void setVideoCodecAccuracy(Image::CodecAccuracy accuracy);
 
+	/**
+	 * Decode frames ahead of time while waiting for the next frame, so that
+	 * a slow frame does not delay playback.
+	 *
+	 * The frames are decoded by decodeFramesAhead() or delayMillis(), from
+	 * the loop playing the video, into a pool of surfaces which
+	 * decodeNextFrame() then hands over in order. Only videos with a single
+	 * video track are supported, and frames are only decoded ahead while
+	 * playing forward.
+	 *
+	 * This should be called after loadStream(), but before a decodeNextFrame()
+	 * call. This is enforced.
+	 *
+	 * @param frames The number of frames to decode ahead, or 0 to decode each
+	 *               frame in decodeNextFrame()
+	 * @return true on success, false otherwise
+	 */
+	bool setFrameAhead(uint frames);
+
+	/**
+	 * Decode frames ahead until the pool set up by setFrameAhead() is full,
+	 * the next frame is due, or @p maxTime milliseconds have passed. At most
+	 * one frame is decoded when @p maxTime is 0. The time is only checked
+	 * between frames, so decoding a slow frame may overrun it. Without
+	 * setFrameAhead(), this does nothing.
+	 *
+	 * @param maxTime The time to spend decoding, in milliseconds
+	 */
+	void decodeFramesAhead(uint32 maxTime);
+
 	/////////////////////////////////////////
 	// Audio Control
 	/////////////////////////////////////////
@@ -1013,6 +1044,36 @@ private:
 	// Enforcement of not being able to set dither or set the default format
 	bool _canSetDither;
 	bool _canSetDefaultFormat;
+	bool _canSetFrameAhead;
+
+	// Frames decoded ahead of time, see setFrameAhead()
+	struct VideoTrackState {
+		int curFrame;
+		uint32 nextFrameStartTime;
+		bool endOfTrack;
+
+		void read(const VideoTrack *track) {
+			curFrame = track->getCurFrame();
+			nextFrameStartTime = track->getNextFrameStartTime();
+			endOfTrack = track->endOfTrack();
+		}
+	};
+
+	struct QueuedFrame;
+	class FrameAheadQueue;
+	FrameAheadQueue *_frameAhead;
+
+	void stopFrameAhead();
+	void flushFrameAhead();
+	bool decodeFrameAhead(bool ahead);
+	const Graphics::Surface *decodeNextFrameAhead();
+
+	/**
+	 * Get the state of a video track, as seen by the caller of
+	 * decodeNextFrame(), which may differ from the one of the track
+	 * when frames have been decoded ahead.
+	 */
+	VideoTrackState getVideoTrackState(const VideoTrack *track) const;
 
 protected:
 	// Internal helper functions